@@ -65,6 +65,24 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*With an OS keep small freed blocks in per thread lists in front of TLSF.
+     *Most of the small allocations won't take the heap lock then. Needs thread local storage.*/
+    #define LV_MEM_THREAD_CACHE 0
+    #if LV_MEM_THREAD_CACHE
+        /*Storage class specifier of thread local variables. E.g. `__thread` or `_Thread_local`*/
+        #define LV_MEM_THREAD_CACHE_TLS __thread
+    #endif
+
+    /*Max number of tagged regions (e.g. internal SRAM, PSRAM) added by `lv_mem_add_region()`.
+     *Each region is a separate TLSF heap and `lv_malloc_tagged()` places the data by its tag.
+     *0: use only the LV_MEM_SIZE heap*/
+    #define LV_MEM_REGION_CNT 0
+    #if LV_MEM_REGION_CNT
+        /*Accumulate the simulated access cost of the regions set by `lv_mem_region_set_sim_latency()`.
+         *Allows benchmarking the placement policy on a PC where all the RAM is equally fast.*/
+        #define LV_MEM_REGION_SIM 0
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -78,6 +96,30 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*Keep the timers in a binary heap ordered by their next run time.
+ *`lv_timer_handler()` runs only the ready timers and knows the time until the next one without walking all timers.
+ *Worth it with many timers. Costs 8 bytes per timer and an array of pointers.*/
+#define LV_USE_TIMER_HEAP 0
+
+/*Keep the running animations in an array and look up the built-in eases from tables computed on first use.
+ *A per target counter lets starting and deleting skip the scan when the target has no other animations.
+ *Worth it with many animations. Costs about 2 kB, 2 kB per used ease and 4 bytes per animation.*/
+#define LV_USE_ANIM_BATCH 0
+
+/*In LV_DISPLAY_RENDER_MODE_DIRECT move the already rendered pixels of a scrolled widget in the frame buffer
+ *and render only the newly exposed part. Used only if the widget's class sets `scroll_blit` (`lv_obj` and `lv_list`),
+ *it has no custom draw event handlers, an opaque, plain background and nothing is drawn above it.*/
+#define LV_USE_SCROLL_BLIT 0
+
+/*Allow rendering into more than 2 buffers in LV_DISPLAY_RENDER_MODE_PARTIAL with `lv_display_set_buffer_ring()`.
+ *The rendered buffers are queued and flushed one after the other while the next ones are rendered,
+ *so rendering waits only if all the buffers are queued or being flushed.*/
+#define LV_USE_DISPLAY_BUF_RING 0
+#if LV_USE_DISPLAY_BUF_RING
+    /*Max number of buffers in the ring*/
+    #define LV_DISPLAY_BUF_RING_MAX 4
+#endif
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -114,6 +156,28 @@
 /*Align the start address of draw_buf addresses to this bytes*/
 #define LV_DRAW_BUF_ALIGN                       4
 
+/*Keep the freed draw buffers (layers, snapshots, decoded images) in a pool and reuse them
+ *for buffers of similar size instead of allocating and freeing them again and again.
+ *The render buffers and the images of the image cache are reused only for their own kind.*/
+#define LV_USE_DRAW_BUF_POOL                    0
+#if LV_USE_DRAW_BUF_POOL
+    /*Max total size of the idle buffers kept in the pool*/
+    #define LV_DRAW_BUF_POOL_SIZE               (64 * 1024)     /*[bytes]*/
+
+    /*Free the buffers which weren't reused for this long*/
+    #define LV_DRAW_BUF_POOL_TRIM_TIME          1000            /*[ms]*/
+#endif
+
+/*Keep the draw tasks of the display's layer queued until an area is ready, and before drawing them
+ *skip or clip the tasks which are covered by later opaque fills or opaque images.
+ *Not used with `LV_DRAW_TRANSFORM_USE_MATRIX`.*/
+#define LV_USE_DRAW_OCCLUSION_CULL              0
+#if LV_USE_DRAW_OCCLUSION_CULL
+    /*Max number of draw tasks to keep queued. When reached, the queued tasks are culled and drawn
+     *to free their memory, but they can't be culled by the draw tasks added later.*/
+    #define LV_DRAW_OCCLUSION_CULL_TASK_MAX     64
+#endif
+
 /*Using matrix for transformations.
  *Requirements:
     `LV_USE_MATRIX = 1`.
@@ -128,6 +192,18 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/*Keep the buffers of the drawn layers and reuse them for the next layers
+ *instead of allocating a new buffer for every layer in every refresh.*/
+#define LV_USE_DRAW_LAYER_BUF_REUSE             0
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    /*Max number of layer buffers to keep*/
+    #define LV_DRAW_LAYER_BUF_REUSE_CNT         2
+
+    /*Let the simple layer chunks grow up to this size while there is enough free memory.
+     *Set to `LV_DRAW_LAYER_SIMPLE_BUF_SIZE` to always use the fixed chunk size.*/
+    #define LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE   (96 * 1024)   /*[bytes]*/
+#endif
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -369,6 +445,40 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Measure the decoding time of the cached images and evict the cheap ones first (Greedy-Dual-Size).
+ *Also collects hit/miss/decoding time statistics per image source, see `lv_image_cache_get_stats()`.*/
+#define LV_USE_IMAGE_CACHE_COST     0
+#if LV_USE_IMAGE_CACHE_COST
+    /*Max number of image sources to collect statistics about*/
+    #define LV_IMAGE_CACHE_STATS_CNT    64
+#endif
+
+/*Convert RGB888, XRGB8888 and ARGB8888 images to the display's native color format when they are added to the cache,
+ *so drawing them is a copy instead of converting every pixel on every draw. Used only if LV_COLOR_DEPTH is 16.
+ *Opaque images become RGB565, the others RGB565A8. Set it per image source with `lv_image_cache_set_native()`.*/
+#define LV_USE_IMAGE_CACHE_NATIVE   0
+
+/*Save the headers of the file images in an index file to not open and parse the images again after a restart.
+ *The entries are checked by the size and modification time of the files if the driver has `stat_cb`.*/
+#define LV_USE_IMAGE_HEADER_INDEX   0
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*Path of the index file*/
+    #define LV_IMAGE_HEADER_INDEX_PATH  "A:lv_image_header.idx"
+#endif
+
+/*Decode the images which are not in the cache in the background instead of while rendering.
+ *Until an image is decoded a placeholder is drawn, and the widget is invalidated when the image is in the cache.
+ *Requires `LV_CACHE_DEF_SIZE > 0`. Without `LV_USE_OS` the images are decoded one by one in an `lv_timer`.*/
+#define LV_USE_IMAGE_DECODER_ASYNC  0
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Number of decoding threads if `LV_USE_OS` is enabled*/
+    #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT           1
+
+    /*Color and opacity of the placeholder*/
+    #define LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR    0x808080
+    #define LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA      LV_OPA_30
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -380,6 +490,24 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Keep a per object table of the already resolved style properties.
+ * It's dropped when the styles or the state of the object change.
+ * The table has 16 slots of 8 bytes (16 bytes on 64-bit systems) when the object's style is first read
+ * and it's doubled as needed up to 256 slots, i.e. 2 kB (4 kB on 64-bit systems) per object at most*/
+#define LV_OBJ_STYLE_RESOLVED_CACHE 0
+
+/* Keep a bitmap of the set built-in properties in each lv_style_t and store the properties sorted.
+ * Not set properties are rejected in O(1) and the set ones are indexed directly. Costs 28 bytes per style*/
+#define LV_STYLE_PROP_BITMAP    0
+
+/* Allocate the objects and their `spec_attr` from size class slabs instead of the heap one by one.
+ * It makes creating and deleting many widgets faster and keeps them from fragmenting the heap.*/
+#define LV_USE_OBJ_SLAB         0
+#if LV_USE_OBJ_SLAB
+    /* Blocks larger than this are allocated by `lv_malloc`. Must be a multiple of 16*/
+    #define LV_OBJ_SLAB_MAX_SIZE    512
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -529,6 +657,14 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the glyph bitmap cache of the built-in font format in bytes.
+ *Glyphs are decompressed/expanded to A8 only once and reused from the cache while drawing.
+ *0: disable the cache and decode the glyphs on every draw*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE 0
+
+/*Enable `lv_font_fmt_txt_cmap_index_create()` to find the glyphs of large fonts (e.g. CJK) in constant time*/
+#define LV_USE_FONT_FMT_TXT_CMAP_INDEX 0
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -629,6 +765,7 @@
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
+    #define LV_LABEL_LAYOUT_CACHE 0  /*Store the line breaks and line widths in labels to speed up size calculation and drawing*/
 #endif
 
 #define LV_USE_LED        1
@@ -708,6 +845,10 @@
 /*A layout similar to Grid in CSS.*/
 #define LV_USE_GRID 1
 
+/*Update the layout only in the subtrees with invalidated layout and
+ *measure the content sized grid tracks in a single pass over the children*/
+#define LV_USE_LAYOUT_INCREMENTAL 0
+
 /*====================
  * 3RD PARTS LIBRARIES
  *====================*/
@@ -784,6 +925,16 @@
 
 /*LODEPNG decoder library*/
 #define LV_USE_LODEPNG 0
+#if LV_USE_LODEPNG
+    /*Inflate and convert the PNGs row by row instead of loading and decoding the whole file at once.
+     *Opaque images are decoded to RGB565 if LV_COLOR_DEPTH is 16 and the images which are not cached
+     *are decoded only in the rows being drawn. Interlaced, 16 bit and colour keyed PNGs still use lodepng.*/
+    #define LV_LODEPNG_STREAM 0
+    #if LV_LODEPNG_STREAM
+        /*Use ordered dithering when converting to RGB565*/
+        #define LV_LODEPNG_STREAM_DITHER 0
+    #endif
+#endif
 
 /*PNG decoder(libpng) library*/
 #define LV_USE_LIBPNG 0
@@ -794,6 +945,11 @@
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_TJPGD 0
+#if LV_USE_TJPGD
+    /*Number of JPG images whose restart marker positions are kept to decode only the rows being drawn.
+     *Helps only if the images have restart markers (DRI). 0: disable*/
+    #define LV_TJPGD_RST_INDEX_CNT 0
+#endif
 
 /* libjpeg-turbo decoder library.
  * Supports complete JPEG specifications and high-performance JPEG decoding. */
@@ -804,12 +960,24 @@
 #if LV_USE_GIF
     /*GIF decoder accelerate*/
     #define LV_GIF_CACHE_DECODE_DATA 0
+
+    /*Render only the pixels changed by each frame through a palette lookup table and redraw only their area.
+     *The frames are rendered to RGB565 if LV_COLOR_DEPTH is 16 (RGB565A8 once a frame leaves transparent parts)*/
+    #define LV_GIF_DIFF_RENDER 0
 #endif
 
 
 /*Decode bin images to RAM*/
 #define LV_BIN_DECODER_RAM_LOAD 0
 
+/*Decompress the compressed bin images having a row group index group by group while drawing
+ *instead of decompressing the whole image to RAM. See `lv_image_compressed_t` for the format.*/
+#define LV_BIN_DECODER_ROW_GROUPS 0
+#if LV_BIN_DECODER_ROW_GROUPS
+    /*Number of decompressed row groups to keep between the draws*/
+    #define LV_BIN_DECODER_ROW_GROUP_CACHE_CNT 4
+#endif
+
 /*RLE decompress library*/
 #define LV_USE_RLE 0
 
@@ -927,6 +1095,9 @@
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
 
+/*1: Enable the benchmarks of the core modules, e.g. `lv_bench_anim()`, to measure the performance options*/
+#define LV_USE_BENCH 0
+
 /*1: Enable grid navigation*/
 #define LV_USE_GRIDNAV 0
 
@@ -83,6 +83,7 @@ extern "C" {
 #include "src/others/snapshot/lv_snapshot.h"
 #include "src/others/sysmon/lv_sysmon.h"
 #include "src/others/monkey/lv_monkey.h"
+#include "src/others/bench/lv_bench.h"
 #include "src/others/gridnav/lv_gridnav.h"
 #include "src/others/fragment/lv_fragment.h"
 #include "src/others/imgfont/lv_imgfont.h"
@@ -80,6 +80,7 @@ lv_display.c \
 lv_ffmpeg.c \
 lodepng.c \
 lv_lodepng.c \
+lv_png_stream.c \
 lv_fs_posix.c \
 lv_fs_rawfs.c \
 lv_fs_memfs.c \
@@ -179,6 +180,7 @@ lv_area.c \
 lv_palette.c \
 lv_event.c \
 lv_array.c \
+lv_slab.c \
 lv_style.c \
 lv_color.c \
 lv_utils.c \
@@ -189,6 +191,7 @@ lv_image_cache.c \
 lv_cache_entry.c \
 lv_cache_lru_rb.c \
 lv_image_header_cache.c \
+lv_image_header_index.c \
 lv_cache.c \
 lv_text.c \
 lv_lru.c \
@@ -35,9 +35,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
 #include "../font/lv_font_fmt_txt_private.h"
-#endif
 
 #include "../tick/lv_tick.h"
 #include "../layouts/lv_layout.h"
@@ -52,6 +50,7 @@ extern "C" {
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
+#include "../misc/lv_slab_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../layouts/lv_layout_private.h"
 
@@ -80,6 +79,22 @@ struct lv_profiler_builtin_ctx_t;
 struct lv_nuttx_ctx_t;
 #endif
 
+#if LV_USE_IMAGE_CACHE_COST
+struct lv_image_cache_stats_ctx_t;
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+struct lv_image_cache_native_ctx_t;
+#endif
+
+#if LV_USE_IMAGE_HEADER_INDEX
+struct lv_image_header_index_t;
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+struct lv_image_decoder_async_t;
+#endif
+
 typedef struct lv_global_t {
     bool inited;
     bool deinit_in_progress;     /**< Can be used e.g. in the LV_EVENT_DELETE to deinit the drivers too */
@@ -104,6 +119,10 @@ typedef struct lv_global_t {
     uint32_t layout_count;
     lv_layout_dsc_t * layout_list;
     bool layout_update_mutex;
+#if LV_USE_FLEX && LV_USE_LAYOUT_INCREMENTAL
+    void * flex_items;          /**< Measured items of the flex container being updated. Kept between the updates*/
+    uint32_t flex_item_cap;
+#endif
 
     uint32_t memory_zero;
     uint32_t math_rand_seed;
@@ -119,11 +138,31 @@ typedef struct lv_global_t {
     lv_draw_buf_handlers_t font_draw_buf_handlers;
     lv_draw_buf_handlers_t image_cache_draw_buf_handlers;  /**< Ensure that all assigned draw buffers
                                                             * can be managed by image cache. */
+#if LV_USE_DRAW_BUF_POOL
+    lv_draw_buf_pool_t draw_buf_pool;
+#endif
 
     lv_ll_t img_decoder_ll;
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_USE_IMAGE_CACHE_COST
+    struct lv_image_cache_stats_ctx_t * img_cache_stats;
+#endif
+#if LV_USE_IMAGE_CACHE_NATIVE
+    struct lv_image_cache_native_ctx_t * img_cache_native;
+#endif
+
+#if LV_USE_IMAGE_HEADER_INDEX
+    struct lv_image_header_index_t * img_header_index;
+#endif
+#if LV_BIN_DECODER_ROW_GROUPS
+    lv_cache_t * bin_decoder_row_group_cache;
+    uint32_t bin_decoder_row_group_max;     /**< Largest row group index cached so far*/
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    struct lv_image_decoder_async_t * img_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
@@ -157,6 +196,10 @@ typedef struct lv_global_t {
     lv_tlsf_state_t tlsf_state;
 #endif
 
+#if LV_USE_OBJ_SLAB
+    lv_slab_state_t slab_state;
+#endif
+
     lv_ll_t fsdrv_ll;
 #if LV_USE_FS_STDIO != '\0'
     lv_fs_drv_t stdio_fs_drv;
@@ -196,6 +239,10 @@ typedef struct lv_global_t {
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
+    lv_font_fmt_txt_glyph_cache_t font_fmt_txt_glyph_cache;
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    lv_font_fmt_txt_cmap_index_t * font_fmt_txt_cmap_index_head;
+#endif
 
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
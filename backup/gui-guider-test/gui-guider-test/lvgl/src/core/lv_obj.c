@@ -25,6 +25,7 @@
 #include "../misc/lv_types.h"
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/lv_slab.h"
 #include "lv_obj_draw_private.h"
 
 /*********************
@@ -188,6 +189,9 @@ const lv_obj_class_t lv_obj_class = {
     .instance_size = (sizeof(lv_obj_t)),
     .base_class = NULL,
     .name = "obj",
+#if LV_USE_SCROLL_BLIT
+    .scroll_blit = 1,
+#endif
 #if LV_USE_OBJ_PROPERTY
     .prop_index_start = LV_PROPERTY_OBJ_START,
     .prop_index_end = LV_PROPERTY_OBJ_END,
@@ -379,7 +383,11 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     if(obj->spec_attr == NULL) {
-        obj->spec_attr = lv_malloc_zeroed(sizeof(lv_obj_spec_attr_t));
+#if LV_USE_OBJ_SLAB
+        obj->spec_attr = lv_slab_alloc_zeroed(sizeof(lv_obj_spec_attr_t));
+#else
+        obj->spec_attr = lv_malloc_zeroed_tagged(sizeof(lv_obj_spec_attr_t), LV_MEM_TAG_OBJ);
+#endif
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -521,6 +529,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    lv_obj_style_resolved_free(obj);
+#endif
 
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
@@ -537,7 +548,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
         lv_event_remove_all(&obj->spec_attr->event_list);
 
+#if LV_USE_OBJ_SLAB
+        lv_slab_free(obj->spec_attr);
+#else
         lv_free(obj->spec_attr);
+#endif
         obj->spec_attr = NULL;
     }
 
@@ -12,6 +12,7 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/lv_slab.h"
 
 /*********************
  *      DEFINES
@@ -48,7 +49,11 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
-    lv_obj_t * obj = lv_malloc_zeroed(s);
+#if LV_USE_OBJ_SLAB
+    lv_obj_t * obj = lv_slab_alloc_zeroed(s);
+#else
+    lv_obj_t * obj = lv_malloc_zeroed_tagged(s, LV_MEM_TAG_OBJ);
+#endif
     if(obj == NULL) return NULL;
     obj->class_p = class_p;
     obj->parent = parent;
@@ -59,7 +64,11 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_display_t * disp = lv_display_get_default();
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
+#if LV_USE_OBJ_SLAB
+            lv_slab_free(obj);
+#else
             lv_free(obj);
+#endif
             return NULL;
         }
 
@@ -70,7 +79,11 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_obj_t ** screens = lv_realloc(disp->screens, sizeof(lv_obj_t *) * (disp->screen_cnt + 1));
         LV_ASSERT_MALLOC(screens);
         if(screens == NULL) {
+#if LV_USE_OBJ_SLAB
+            lv_slab_free(obj);
+#else
             lv_free(obj);
+#endif
             return NULL;
         }
 
@@ -92,9 +105,16 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
             lv_obj_allocate_spec_attr(parent);
         }
 
+        if(lv_obj_resize_children(parent, parent->spec_attr->child_cnt + 1) != LV_RESULT_OK) {
+#if LV_USE_OBJ_SLAB
+            lv_slab_free(obj);
+#else
+            lv_free(obj);
+#endif
+            return NULL;
+        }
+
         parent->spec_attr->child_cnt++;
-        parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
-                                                 sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
     }
 
@@ -58,6 +58,10 @@ struct lv_obj_class_t {
     uint32_t group_def : 2;            /**< Value from ::lv_obj_class_group_def_t*/
     uint32_t instance_size : 16;
     uint32_t theme_inheritable : 1;    /**< Value from ::lv_obj_class_theme_inheritable_t*/
+#if LV_USE_SCROLL_BLIT
+    uint32_t scroll_blit : 1;          /**< 1: the rendered content can be moved when scrolled as nothing is drawn
+                                        *   at a fixed position above the scrolled content. Not inherited.*/
+#endif
 };
 
 
@@ -32,6 +32,9 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+#if LV_USE_LAYOUT_INCREMENTAL
+    static lv_obj_t * layout_mark_ancestors(lv_obj_t * obj);
+#endif
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 
 /**********************
@@ -168,6 +171,14 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_area_t ori;
     lv_obj_get_coords(obj, &ori);
 
+#if LV_USE_LAYOUT_INCREMENTAL
+    /*Finding the scrollbar area needs all the children of the parent so do it only once per layout update.
+     *The new scrollbar area is invalidated when the parent is updated in the layout.*/
+    if(!parent->scrollbar_inv) {
+        lv_obj_scrollbar_invalidate(parent);
+        parent->scrollbar_inv = 1;
+    }
+#else
     /*Check if the object inside the parent or not*/
     lv_area_t parent_fit_area;
     lv_obj_get_content_coords(parent, &parent_fit_area);
@@ -176,6 +187,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
      *surely the scrollbars also changes so invalidate them*/
     bool on1 = lv_area_is_in(&ori, &parent_fit_area, 0);
     if(!on1) lv_obj_scrollbar_invalidate(parent);
+#endif
 
     /*Set the length and height
      *Be sure the content is not scrolled in an invalid position on the new size*/
@@ -198,10 +210,16 @@ bool lv_obj_refr_size(lv_obj_t * obj)
 
     obj->readjust_scroll_after_layout = 1;
 
+#if LV_USE_LAYOUT_INCREMENTAL
+    /*Be sure the parent is visited to handle the scrollbars even if the size was refreshed out of a layout update*/
+    lv_obj_t * scr = layout_mark_ancestors(obj);
+    if(!update_layout_mutex) scr->scr_layout_inv = 1;
+#else
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
     bool on2 = lv_area_is_in(&obj->coords, &parent_fit_area, 0);
     if(on1 || (!on1 && on2)) lv_obj_scrollbar_invalidate(parent);
+#endif
 
     lv_obj_refresh_ext_draw_size(obj);
 
@@ -282,7 +300,11 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
     obj->layout_inv = 1;
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
+#if LV_USE_LAYOUT_INCREMENTAL
+    lv_obj_t * scr = layout_mark_ancestors(obj);
+#else
     lv_obj_t * scr = lv_obj_get_screen(obj);
+#endif
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -1127,10 +1149,21 @@ static void layout_update_core(lv_obj_t * obj)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
+#if LV_USE_LAYOUT_INCREMENTAL
+    /*Skip the subtrees without dirty layout*/
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            layout_update_core(child);
+        }
+    }
+#else
     for(i = 0; i < child_cnt; i++) {
         lv_obj_t * child = obj->spec_attr->children[i];
         layout_update_core(child);
     }
+#endif
 
     if(obj->layout_inv) {
         obj->layout_inv = 0;
@@ -1146,7 +1179,32 @@ static void layout_update_core(lv_obj_t * obj)
         obj->readjust_scroll_after_layout = 0;
         lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
     }
+
+#if LV_USE_LAYOUT_INCREMENTAL
+    if(obj->scrollbar_inv) {
+        obj->scrollbar_inv = 0;
+        lv_obj_scrollbar_invalidate(obj);
+    }
+#endif
+}
+
+#if LV_USE_LAYOUT_INCREMENTAL
+/**
+ * Mark all the ancestors of an object as having a descendant to update.
+ * The flags can't be used to stop early as `layout_update_core` clears them top-down.
+ * @param obj       pointer to an object
+ * @return          the screen of the object
+ */
+static lv_obj_t * layout_mark_ancestors(lv_obj_t * obj)
+{
+    while(obj->parent) {
+        obj = obj->parent;
+        obj->child_layout_inv = 1;
+    }
+
+    return obj;
 }
+#endif
 
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
 {
@@ -54,6 +54,9 @@ struct lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    lv_obj_style_resolved_t * style_resolved;
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -70,6 +73,10 @@ struct lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+#if LV_USE_LAYOUT_INCREMENTAL
+    uint16_t child_layout_inv : 1;  /**< A descendant has `layout_inv`, `readjust_scroll_after_layout` or `scrollbar_inv` set*/
+    uint16_t scrollbar_inv : 1;     /**< The scrollbars need to be invalidated after the layout update*/
+#endif
 };
 
 
@@ -77,6 +84,16 @@ struct lv_obj_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Resize the children array of an object to hold `child_cnt` children.
+ * The array grows and shrinks geometrically, so it's reallocated only when
+ * the number of children crosses a power of 2. `spec_attr->child_cnt` is not changed.
+ * @param obj           pointer to an object with `spec_attr`
+ * @param child_cnt     the new number of children
+ * @return              LV_RESULT_OK: success; LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_obj_resize_children(lv_obj_t * obj, uint32_t child_cnt);
+
 /**********************
  *      MACROS
  **********************/
@@ -23,6 +23,11 @@
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define RESOLVED_SIZE_INIT  16
+#define RESOLVED_SIZE_MAX   256
+
+/*A slot of an older version is empty*/
+#define RESOLVED_IS_USED(res, i) ((res)->entries[i].key != 0 && (res)->entries[i].version == (res)->version)
 
 /**********************
  *      TYPEDEFS
@@ -67,7 +72,10 @@ static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
-                                              lv_style_value_t * value_act);
+                                              lv_style_value_t * value_act, bool * inherited);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    static lv_obj_style_resolved_entry_t * resolved_find(lv_obj_t * obj, uint32_t key);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -95,6 +103,29 @@ void lv_obj_style_deinit(void)
     }
 }
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+void lv_obj_style_resolved_invalidate(lv_obj_t * obj)
+{
+    lv_obj_style_resolved_t * res = obj->style_resolved;
+    if(res == NULL) return;
+
+    /*A new version drops all entries. Clear the slots only when the version wraps around.*/
+    res->version++;
+    if(res->version == 0) lv_memzero(res->entries, res->size * sizeof(lv_obj_style_resolved_entry_t));
+    res->cnt = 0;
+    res->state = obj->state;
+}
+
+void lv_obj_style_resolved_free(lv_obj_t * obj)
+{
+    if(obj->style_resolved == NULL) return;
+
+    lv_free(obj->style_resolved->entries);
+    lv_free(obj->style_resolved);
+    obj->style_resolved = NULL;
+}
+#endif
+
 void lv_obj_add_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selector_t selector)
 {
     LV_ASSERT(obj->style_cnt < 63);
@@ -276,6 +307,11 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*Even if refreshing is disabled the values might be read*/
+    lv_obj_style_resolved_invalidate(obj);
+#endif
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -331,10 +367,37 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
-    found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*While a transition is being created the state is temporarily changed, so don't touch the table.
+     *Don't create the table again while the object is being deleted either as it wouldn't be freed.*/
+    lv_obj_style_resolved_entry_t * entry = NULL;
+    uint32_t key = (((part >> 16) + 1) << 8) | prop;
+    bool inherited = false;
+    if(!obj->skip_trans && !obj->is_deleting && part < LV_PART_ANY) {
+        /*The object is not modified logically, only the cache is filled*/
+        entry = resolved_find((lv_obj_t *)obj, key);
+        if(entry && entry->key == key && entry->version == obj->style_resolved->version) return entry->value;
+    }
+#endif
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    found = get_selector_style_prop(obj, selector, prop, &value_act, &inherited);
+#else
+    found = get_selector_style_prop(obj, selector, prop, &value_act, NULL);
+#endif
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*Only the styles of `obj` are tracked, so don't store the values coming from the parents*/
+    if(entry && !inherited) {
+        entry->key = key;
+        entry->version = obj->style_resolved->version;
+        entry->value = value_act;
+        obj->style_resolved->cnt++;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -344,7 +407,7 @@ bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, l
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
-    found = get_selector_style_prop(obj, selector, prop, &value_act);
+    found = get_selector_style_prop(obj, selector, prop, &value_act, NULL);
     if(found == LV_STYLE_RES_FOUND) return true;
 
     return false;
@@ -829,6 +892,11 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
         }
         tr = tr_prev;
     }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*The transitioned values were removed without refreshing the style*/
+    if(removed) lv_obj_style_resolved_invalidate(obj);
+#endif
     return removed;
 }
 
@@ -946,6 +1014,9 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+                lv_obj_style_resolved_invalidate(obj);
+#endif
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1054,7 +1125,7 @@ static bool style_has_flag(const lv_style_t * style, uint32_t flag)
 }
 
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
-                                              lv_style_value_t * value_act)
+                                              lv_style_value_t * value_act, bool * inherited)
 {
     lv_style_res_t found;
     lv_part_t part = lv_obj_style_get_selector_part(selector);
@@ -1086,6 +1157,9 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
         if(part != LV_PART_MAIN) part = LV_PART_MAIN;
         else obj = obj->parent;
 
+        /*The value depends on the parents too (or on not having it set in the parents)*/
+        if(inherited) *inherited = true;
+
         while(obj) {
 #if LV_OBJ_STYLE_CACHE
             if(obj->style_main_prop_is_set & prop_shifted)
@@ -1124,3 +1198,64 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * Find the slot of a resolved property in the table of an object.
+ * The table is (re)created, cleared or enlarged as needed.
+ * @param obj       pointer to an object
+ * @param key       `(part index + 1) << 8 | prop`
+ * @return          the slot with `key` or the empty slot where `key` should be stored.
+ *                  NULL if the table is full and can't be enlarged.
+ */
+static lv_obj_style_resolved_entry_t * resolved_find(lv_obj_t * obj, uint32_t key)
+{
+    lv_obj_style_resolved_t * res = obj->style_resolved;
+    if(res == NULL) {
+        res = lv_malloc_zeroed(sizeof(lv_obj_style_resolved_t));
+        if(res == NULL) return NULL;
+        res->entries = lv_malloc_zeroed(RESOLVED_SIZE_INIT * sizeof(lv_obj_style_resolved_entry_t));
+        if(res->entries == NULL) {
+            lv_free(res);
+            return NULL;
+        }
+        res->size = RESOLVED_SIZE_INIT;
+        res->state = obj->state;
+        obj->style_resolved = res;
+    }
+    else if(res->state != obj->state) {
+        lv_obj_style_resolved_invalidate(obj);
+    }
+
+    uint32_t mask = res->size - 1;
+    uint32_t i = ((key * 2654435761u) >> 16) & mask;
+    while(RESOLVED_IS_USED(res, i) && res->entries[i].key != key) i = (i + 1) & mask;
+    if(RESOLVED_IS_USED(res, i)) return &res->entries[i];
+
+    /*Not found. Keep the load factor below 3/4 before adding a new entry*/
+    if((res->cnt + 1) * 4 > res->size * 3) {
+        if(res->size >= RESOLVED_SIZE_MAX) return NULL;
+
+        uint32_t new_size = res->size * 2;
+        size_t new_bytes = new_size * sizeof(lv_obj_style_resolved_entry_t);
+        lv_obj_style_resolved_entry_t * new_entries = lv_malloc_zeroed(new_bytes);
+        if(new_entries == NULL) return NULL;
+
+        mask = new_size - 1;
+        for(i = 0; i < res->size; i++) {
+            if(!RESOLVED_IS_USED(res, i)) continue;
+            uint32_t j = ((res->entries[i].key * 2654435761u) >> 16) & mask;
+            while(new_entries[j].key != 0) j = (j + 1) & mask;
+            new_entries[j] = res->entries[i];
+        }
+        lv_free(res->entries);
+        res->entries = new_entries;
+        res->size = new_size;
+
+        i = ((key * 2654435761u) >> 16) & mask;
+        while(RESOLVED_IS_USED(res, i)) i = (i + 1) & mask;
+    }
+
+    return &res->entries[i];
+}
+#endif
@@ -40,6 +40,22 @@ struct lv_obj_style_transition_dsc_t {
     void * user_data;
 };
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+typedef struct {
+    uint16_t key;           /**< `(part index + 1) << 8 | prop`, 0: empty slot*/
+    uint16_t version;       /**< The slot is empty if it's not the version of the table*/
+    lv_style_value_t value;
+} lv_obj_style_resolved_entry_t;
+
+struct lv_obj_style_resolved_t {
+    uint16_t version;       /**< Incremented when the styles of the object change to drop all entries*/
+    lv_state_t state;       /**< The state of the object when the entries were added*/
+    uint16_t cnt;
+    uint16_t size;          /**< Number of slots, always a power of 2*/
+    lv_obj_style_resolved_entry_t * entries;
+};
+#endif
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -77,6 +93,22 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
  */
 lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * Drop the resolved style properties of an object.
+ * Called by `lv_obj_refresh_style()`, so it covers the changes of the style list and the styles too,
+ * as the styles shared by several objects need to be reported by `lv_obj_report_style_change()`.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_resolved_invalidate(lv_obj_t * obj);
+
+/**
+ * Free the table of the resolved style properties of an object
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_resolved_free(lv_obj_t * obj);
+#endif
+
 /**
  * Update the layer type of a widget bayed on its current styles.
  * The result will be stored in `obj->spec_attr->layer_type`
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_style_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
 #include "../display/lv_display.h"
@@ -15,6 +16,7 @@
 #include "../misc/lv_anim_private.h"
 #include "../misc/lv_async.h"
 #include "../core/lv_global.h"
+#include "../misc/lv_slab.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +38,7 @@ static void obj_delete_core(lv_obj_t * obj);
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data);
 static void dump_tree_core(lv_obj_t * obj, int32_t depth);
 static lv_obj_t * lv_obj_get_first_not_deleting_child(lv_obj_t * obj);
+static uint32_t get_children_capacity(uint32_t child_cnt);
 
 /**********************
  *  STATIC VARIABLES
@@ -159,30 +162,27 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
         return;
     }
 
-    lv_obj_invalidate(obj);
-
     lv_obj_allocate_spec_attr(parent);
 
+    /*Make room for the child first to leave it on the old parent if there is no memory*/
+    if(lv_obj_resize_children(parent, parent->spec_attr->child_cnt + 1) != LV_RESULT_OK) {
+        LV_LOG_WARN("Couldn't move the object to the new parent");
+        return;
+    }
+
+    lv_obj_invalidate(obj);
+
     lv_obj_t * old_parent = obj->parent;
     /*Remove the object from the old parent's child list*/
     int32_t i;
     for(i = lv_obj_get_index(obj); i <= (int32_t)lv_obj_get_child_count(old_parent) - 2; i++) {
         old_parent->spec_attr->children[i] = old_parent->spec_attr->children[i + 1];
     }
+    lv_obj_resize_children(old_parent, old_parent->spec_attr->child_cnt - 1);
     old_parent->spec_attr->child_cnt--;
-    if(old_parent->spec_attr->child_cnt) {
-        old_parent->spec_attr->children = lv_realloc(old_parent->spec_attr->children,
-                                                     old_parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
-    }
-    else {
-        lv_free(old_parent->spec_attr->children);
-        old_parent->spec_attr->children = NULL;
-    }
 
     /*Add the child to the new parent as the last (newest child)*/
     parent->spec_attr->child_cnt++;
-    parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
-                                             parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
     parent->spec_attr->children[lv_obj_get_child_count(parent) - 1] = obj;
 
     obj->parent = parent;
@@ -476,6 +476,29 @@ void lv_obj_dump_tree(lv_obj_t * start_obj)
     }
 }
 
+lv_result_t lv_obj_resize_children(lv_obj_t * obj, uint32_t child_cnt)
+{
+    uint32_t cap_old = get_children_capacity(obj->spec_attr->child_cnt);
+    uint32_t cap_new = get_children_capacity(child_cnt);
+    if(cap_old == cap_new) return LV_RESULT_OK;
+
+    if(cap_new == 0) {
+        lv_free(obj->spec_attr->children);
+        obj->spec_attr->children = NULL;
+        return LV_RESULT_OK;
+    }
+
+    lv_obj_t ** children = lv_realloc(obj->spec_attr->children, cap_new * sizeof(lv_obj_t *));
+    LV_ASSERT_MALLOC(children);
+    if(children == NULL) {
+        /*Shrinking can fail only if there is no memory at all. Keep the larger array in this case.*/
+        return cap_new < cap_old ? LV_RESULT_OK : LV_RESULT_INVALID;
+    }
+
+    obj->spec_attr->children = children;
+    return LV_RESULT_OK;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -581,13 +604,16 @@ static void obj_delete_core(lv_obj_t * obj)
         for(i = id; i < obj->parent->spec_attr->child_cnt - 1; i++) {
             obj->parent->spec_attr->children[i] = obj->parent->spec_attr->children[i + 1];
         }
+        lv_obj_resize_children(obj->parent, obj->parent->spec_attr->child_cnt - 1);
         obj->parent->spec_attr->child_cnt--;
-        obj->parent->spec_attr->children = lv_realloc(obj->parent->spec_attr->children,
-                                                      obj->parent->spec_attr->child_cnt * sizeof(lv_obj_t *));
     }
 
     /*Free the object itself*/
+#if LV_USE_OBJ_SLAB
+    lv_slab_free(obj);
+#else
     lv_free(obj);
+#endif
 }
 
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data)
@@ -660,3 +686,18 @@ static lv_obj_t * lv_obj_get_first_not_deleting_child(lv_obj_t * obj)
 
     return NULL;
 }
+
+/**
+ * Get the allocated length of the children array for a given number of children
+ * @param child_cnt     number of children
+ * @return              0, 4 or the next power of 2
+ */
+static uint32_t get_children_capacity(uint32_t child_cnt)
+{
+    if(child_cnt == 0) return 0;
+    if(child_cnt <= 4) return 4;
+
+    uint32_t cap = 8;
+    while(cap < child_cnt) cap <<= 1;
+    return cap;
+}
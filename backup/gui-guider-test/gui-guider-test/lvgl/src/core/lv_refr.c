@@ -13,6 +13,8 @@
 #include "../draw/lv_draw_mask_private.h"
 #include "lv_obj_private.h"
 #include "lv_obj_event_private.h"
+#include "../misc/lv_event_private.h"
+#include "lv_obj_class_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../tick/lv_tick.h"
@@ -51,6 +53,17 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+#if LV_USE_SCROLL_BLIT
+    static bool scroll_blit_get_area(lv_display_t * disp, lv_obj_t * obj, lv_area_t * area);
+    static bool scroll_blit_is_covered(lv_display_t * disp, const lv_obj_t * obj, const lv_area_t * area);
+    static bool scroll_blit_layer_is_on(const lv_obj_t * layer, const lv_area_t * area);
+    static void refr_scroll_blits(void);
+#endif
+#if LV_USE_DISPLAY_BUF_RING
+    static void buf_ring_flush(lv_display_t * disp, uint8_t * px_map);
+    static void flush_queue_pump(lv_display_t * disp);
+    static void flush_queue_drain(lv_display_t * disp);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -276,6 +289,9 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+#if LV_USE_SCROLL_BLIT
+        disp->scroll_blit_cnt = 0;
+#endif
         return;
     }
 
@@ -327,6 +343,89 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+#if LV_USE_SCROLL_BLIT
+void lv_refr_invalidate_scroll(lv_obj_t * obj, int32_t dx, int32_t dy)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    lv_area_t area;
+    if(!scroll_blit_get_area(disp, obj, &area)) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Merge with the earlier scrolls of the object.
+     *The areas are moved independently from the last rendered frame so they can't overlap.*/
+    lv_display_scroll_blit_t * blit = NULL;
+    uint32_t i;
+    for(i = 0; i < disp->scroll_blit_cnt; i++) {
+        lv_display_scroll_blit_t * b = &disp->scroll_blits[i];
+        if(b->obj == obj && lv_area_is_equal(&b->area, &area)) {
+            blit = b;
+        }
+        else if(lv_area_is_on(&b->area, &area)) {
+            lv_obj_invalidate(obj);
+            return;
+        }
+    }
+
+    if(blit == NULL) {
+        if(disp->scroll_blit_cnt >= LV_DISPLAY_SCROLL_BLIT_CNT) {
+            lv_obj_invalidate(obj);
+            return;
+        }
+        blit = &disp->scroll_blits[disp->scroll_blit_cnt];
+        disp->scroll_blit_cnt++;
+        blit->obj = obj;
+        blit->area = area;
+        blit->dx = 0;
+        blit->dy = 0;
+    }
+
+    blit->dx += dx;
+    blit->dy += dy;
+
+    /*Nothing remains visible from the earlier content*/
+    if(LV_ABS(blit->dx) >= lv_area_get_width(&area) || LV_ABS(blit->dy) >= lv_area_get_height(&area)) {
+        disp->scroll_blit_cnt--;
+        *blit = disp->scroll_blits[disp->scroll_blit_cnt];
+        lv_inv_area(disp, &area);
+        lv_obj_scrollbar_invalidate(obj);
+        return;
+    }
+
+    /*The invalid areas have outdated pixels which will be moved too, so invalidate them on the new position as well*/
+    uint32_t inv_cnt = disp->inv_p;
+    for(i = 0; i < inv_cnt && i < disp->inv_p; i++) {
+        lv_area_t a;
+        if(!lv_area_intersect(&a, &disp->inv_areas[i], &area)) continue;
+        lv_area_move(&a, dx, dy);
+        if(lv_area_intersect(&a, &a, &area)) lv_inv_area(disp, &a);
+    }
+
+    /*Invalidate the newly exposed parts*/
+    lv_area_t a = area;
+    if(dy > 0) a.y2 = area.y1 + dy - 1;
+    else if(dy < 0) a.y1 = area.y2 + dy + 1;
+    if(dy != 0) lv_inv_area(disp, &a);
+
+    a = area;
+    if(dx > 0) a.x2 = area.x1 + dx - 1;
+    else if(dx < 0) a.x1 = area.x2 + dx + 1;
+    if(dx != 0) lv_inv_area(disp, &a);
+
+    /*The children are drawn on the border and corners too*/
+    lv_area_t band[4];
+    int8_t band_cnt = lv_area_diff(band, &obj->coords, &area);
+    int8_t j;
+    for(j = 0; j < band_cnt; j++) {
+        lv_obj_invalidate_area(obj, &band[j]);
+    }
+
+    /*The scrollbars are not moved with the content*/
+    lv_obj_scrollbar_invalidate(obj);
+}
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -389,14 +488,25 @@ void lv_display_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+#if LV_USE_SCROLL_BLIT
+        disp_refr->scroll_blit_cnt = 0;
+#endif
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
     lv_refr_join_area();
     refr_sync_areas();
+#if LV_USE_SCROLL_BLIT
+    refr_scroll_blits();
+#endif
     refr_invalid_areas();
 
+#if LV_USE_DISPLAY_BUF_RING
+    /*Nothing will pass the queued areas to `flush_cb` after the refresh*/
+    flush_queue_drain(disp_refr);
+#endif
+
     if(disp_refr->inv_p == 0) goto refr_finish;
 
     /*If refresh happened ...*/
@@ -427,6 +537,15 @@ refr_finish:
 
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
 
+#if LV_USE_DRAW_BUF_POOL
+    /*Layers of widgets which are not redrawn anymore don't need to keep their buffers*/
+    lv_draw_buf_pool_trim(LV_DRAW_BUF_POOL_TRIM_TIME);
+#endif
+
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    lv_draw_layer_update_simple_buf_size();
+#endif
+
     LV_TRACE_REFR("finished");
     LV_PROFILER_END;
 }
@@ -721,6 +840,11 @@ static void refr_area_part(lv_layer_t * layer)
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+    /*Collect the draw tasks of the area to skip the covered ones before drawing*/
+    lv_draw_occlusion_begin(layer);
+#endif
+
     /*Get the most top object which is not covered by others*/
     top_act_scr = lv_refr_get_top_obj(&layer->_clip_area, lv_display_get_screen_active(disp_refr));
     if(disp_refr->prev_scr) {
@@ -757,6 +881,10 @@ static void refr_area_part(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+    lv_draw_occlusion_cull(layer);
+#endif
+
     draw_buf_flush(disp_refr);
     LV_PROFILER_END;
 }
@@ -1014,6 +1142,11 @@ static bool refr_check_obj_clip_overflow(lv_layer_t * layer, lv_obj_t * obj)
 
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
+#if LV_USE_DISPLAY_BUF_RING
+    /*Start flushing the next queued buffer as soon as possible*/
+    if(disp_refr->flush_queue_cnt) flush_queue_pump(disp_refr);
+#endif
+
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
     lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
@@ -1043,7 +1176,8 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
         if(layer_type == LV_LAYER_TYPE_SIMPLE) {
             int32_t w = lv_area_get_width(&layer_area_full);
             uint8_t px_size = lv_color_format_get_size(disp_refr->color_format);
-            max_rgb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / px_size;
+            /*Usually only the edges of the widget need alpha so keep the ARGB chunks small*/
+            max_rgb_row_height = lv_draw_layer_get_simple_buf_size() / w / px_size;
             max_argb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / sizeof(lv_color32_t);
         }
 
@@ -1059,6 +1193,14 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
             layer_area_act.y2 = layer_area_act.y1 + max_rgb_row_height - 1;
             if(layer_area_act.y2 > layer_area_full.y2) layer_area_act.y2 = layer_area_full.y2;
             bool area_need_alpha = alpha_test_area_on_obj(obj, &layer_area_act);
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+            /*A large chunk might reach an edge which needs alpha.
+             *Shrink it to render the part before the edge without alpha.*/
+            while(area_need_alpha && (uint32_t)lv_area_get_height(&layer_area_act) > 2 * max_argb_row_height) {
+                layer_area_act.y2 -= max_argb_row_height;
+                area_need_alpha = alpha_test_area_on_obj(obj, &layer_area_act);
+            }
+#endif
             if(area_need_alpha) {
                 layer_area_act.y2 = layer_area_act.y1 + max_argb_row_height - 1;
                 if(layer_area_act.y2 > layer_area_full.y2) layer_area_act.y2 = layer_area_full.y2;
@@ -1155,10 +1297,20 @@ static void draw_buf_flush(lv_display_t * disp)
     lv_layer_t * layer = disp->layer_head;
 
     while(layer->draw_task_head) {
+#if LV_USE_DISPLAY_BUF_RING
+        if(disp->flush_queue_cnt) flush_queue_pump(disp);
+#endif
         lv_draw_dispatch_wait_for_request();
         lv_draw_dispatch();
     }
 
+#if LV_USE_DISPLAY_BUF_RING
+    if(disp->ring_buf_cnt) {
+        buf_ring_flush(disp, layer->draw_buf->data);
+        return;
+    }
+#endif
+
     /* In double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer.
      * If we need to wait here it means that the content of one buffer is being sent to display
@@ -1219,6 +1371,11 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_PROFILER_BEGIN;
     LV_LOG_TRACE("begin");
 
+    /*Measure how long rendering is blocked by flushing*/
+    uint32_t stall_start = 0;
+    bool stall = disp->flushing && disp->rendering_in_progress;
+    if(stall) stall_start = lv_tick_get();
+
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_START, NULL);
 
     if(disp->flush_wait_cb) {
@@ -1232,8 +1389,267 @@ static void wait_for_flushing(lv_display_t * disp)
     }
     disp->flushing_last = 0;
 
+    if(stall) disp->render_stall_time += lv_tick_elaps(stall_start);
+
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
 
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
+#if LV_USE_SCROLL_BLIT
+
+/**
+ * Get the area of a scrolled object whose rendered pixels can be moved with the scroll
+ * @param disp      the display of the object
+ * @param obj       pointer to a scrolled object
+ * @param area      store the area here
+ * @return          true: the pixels in `area` can be moved; false: the object needs to be redrawn
+ */
+static bool scroll_blit_get_area(lv_display_t * disp, lv_obj_t * obj, lv_area_t * area)
+{
+    if(disp == NULL) return false;
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(disp->rotation != LV_DISPLAY_ROTATION_0) return false;
+    if(lv_color_format_get_bpp(disp->color_format) < 8) return false;
+    if(!lv_display_is_invalidation_enabled(disp)) return false;
+    if(disp->prev_scr) return false;
+
+    /*Only the classes which don't draw fixed overlays (e.g. the selection of a roller or the cursor of a text area)
+     *and objects without custom drawing can be moved*/
+    if(!obj->class_p->scroll_blit) return false;
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t e;
+    for(e = 0; e < event_cnt; e++) {
+        lv_event_code_t code = lv_obj_get_event_dsc(obj, e)->filter & ~LV_EVENT_PREPROCESS;
+        if(code == LV_EVENT_ALL || (code >= LV_EVENT_DRAW_MAIN_BEGIN && code <= LV_EVENT_DRAW_POST_END)) return false;
+    }
+
+    /*The background has to look the same everywhere below the moved content*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_outline_width(obj, LV_PART_MAIN) > 0 &&
+       lv_obj_get_style_outline_pad(obj, LV_PART_MAIN) < 0) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+
+    /*Layers are rendered and transformed separately*/
+    const lv_obj_t * parent;
+    for(parent = obj; parent; parent = lv_obj_get_parent(parent)) {
+        if(lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+    }
+
+    /*Floating children stay in place while the others are scrolled*/
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) return false;
+    }
+
+    /*Leave out the border and the rounded corners*/
+    int32_t w = lv_obj_get_width(obj);
+    int32_t h = lv_obj_get_height(obj);
+    int32_t radius = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), LV_MIN(w, h) / 2);
+    int32_t inner = LV_MAX(radius, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_get_coords(obj, area);
+    lv_area_increase(area, -inner, -inner);
+
+    if(!lv_obj_area_is_visible(obj, area)) return false;
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+    if(!lv_area_intersect(area, area, &disp_area)) return false;
+
+    return !scroll_blit_is_covered(disp, obj, area);
+}
+
+/**
+ * Check if anything is drawn above an object on an area
+ * @param disp      the display of the object
+ * @param obj       pointer to an object
+ * @param area      the area to check
+ * @return          true: something might be drawn above `obj` on `area`
+ */
+static bool scroll_blit_is_covered(lv_display_t * disp, const lv_obj_t * obj, const lv_area_t * area)
+{
+    const lv_obj_t * child = obj;
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        /*The later siblings are drawn above*/
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(parent);
+        for(i = lv_obj_get_index(child) + 1; i < child_cnt; i++) {
+            lv_obj_t * sibling = parent->spec_attr->children[i];
+            if(lv_obj_has_flag(sibling, LV_OBJ_FLAG_HIDDEN)) continue;
+
+            lv_area_t sibling_area = sibling->coords;
+            int32_t ext_size = lv_obj_get_ext_draw_size(sibling);
+            lv_area_increase(&sibling_area, ext_size, ext_size);
+            if(lv_area_is_on(&sibling_area, area)) return true;
+        }
+
+        /*The scrollbars of the parents are drawn above their children*/
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+        if(lv_area_get_size(&hor_area) > 0 && lv_area_is_on(&hor_area, area)) return true;
+        if(lv_area_get_size(&ver_area) > 0 && lv_area_is_on(&ver_area, area)) return true;
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*The screens are drawn above the bottom layer and the top and system layers above the screens*/
+    if(child == disp->bottom_layer) return true;
+    if(child != disp->top_layer && child != disp->sys_layer && scroll_blit_layer_is_on(disp->top_layer, area)) return true;
+    if(child != disp->sys_layer && scroll_blit_layer_is_on(disp->sys_layer, area)) return true;
+
+    return false;
+}
+
+static bool scroll_blit_layer_is_on(const lv_obj_t * layer, const lv_area_t * area)
+{
+    if(layer == NULL) return false;
+    if(lv_obj_get_style_bg_opa(layer, LV_PART_MAIN) > LV_OPA_TRANSP) return true;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(layer);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = layer->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+
+        lv_area_t child_area = child->coords;
+        int32_t ext_size = lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&child_area, ext_size, ext_size);
+        if(lv_area_is_on(&child_area, area)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Move the already rendered content of the scrolled objects and flush them
+ */
+static void refr_scroll_blits(void)
+{
+    if(disp_refr->scroll_blit_cnt == 0) return;
+    LV_PROFILER_BEGIN;
+
+    lv_draw_buf_t * dest = disp_refr->buf_act;
+
+    /*In double buffered mode the areas not synchronized yet are outdated in the active buffer
+     *so move the pixels from the last frame. Else the content is moved in place.*/
+    const lv_draw_buf_t * src = dest;
+    if(lv_display_is_double_buffered(disp_refr)) {
+        src = disp_refr->buf_act == disp_refr->buf_1 ? disp_refr->buf_2 : disp_refr->buf_1;
+    }
+
+    uint32_t px_size = lv_color_format_get_size(dest->header.cf);
+    uint32_t i;
+    for(i = 0; i < disp_refr->scroll_blit_cnt; i++) {
+        lv_display_scroll_blit_t * blit = &disp_refr->scroll_blits[i];
+        lv_area_t dest_area = blit->area;
+        lv_area_move(&dest_area, blit->dx, blit->dy);
+        if(!lv_area_intersect(&dest_area, &dest_area, &blit->area)) continue;
+
+        /*Don't modify the buffer while it's being flushed*/
+        wait_for_flushing(disp_refr);
+
+        int32_t h = lv_area_get_height(&dest_area);
+        size_t line_bytes = lv_area_get_width(&dest_area) * px_size;
+
+        /*If the content moves down go from the bottom to not overwrite the rows to move*/
+        int32_t y;
+        int32_t y_start = blit->dy > 0 ? h - 1 : 0;
+        int32_t y_step = blit->dy > 0 ? -1 : 1;
+        for(y = y_start; y >= 0 && y < h; y += y_step) {
+            uint8_t * dest_buf = lv_draw_buf_goto_xy(dest, dest_area.x1, dest_area.y1 + y);
+            uint8_t * src_buf = lv_draw_buf_goto_xy(src, dest_area.x1 - blit->dx, dest_area.y1 + y - blit->dy);
+            lv_memmove(dest_buf, src_buf, line_bytes);
+        }
+
+        if(disp_refr->flush_cb) {
+            disp_refr->flushing = 1;
+            disp_refr->flushing_last = 0;
+            call_flush_cb(disp_refr, &dest_area, dest->data);
+        }
+
+        /*The other buffer will need the moved content too*/
+        if(lv_display_is_double_buffered(disp_refr)) {
+            lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
+            if(sync_area) *sync_area = dest_area;
+        }
+    }
+
+    disp_refr->scroll_blit_cnt = 0;
+    LV_PROFILER_END;
+}
+
+#endif /*LV_USE_SCROLL_BLIT*/
+
+#if LV_USE_DISPLAY_BUF_RING
+
+/**
+ * Queue the rendered buffer to flush and continue with the next buffer of the ring
+ * @param disp      pointer to a display
+ * @param px_map    the rendered pixels of `disp->refreshed_area`
+ */
+static void buf_ring_flush(lv_display_t * disp, uint8_t * px_map)
+{
+    LV_ASSERT(disp->flush_queue_cnt < disp->ring_buf_cnt);
+
+    uint32_t i = (disp->flush_queue_head + disp->flush_queue_cnt) % disp->ring_buf_cnt;
+    lv_display_flush_queue_item_t * item = &disp->flush_queue[i];
+    item->area = disp->refreshed_area;
+    item->px_map = px_map;
+    item->last = disp->last_area && disp->last_part;
+    disp->flush_queue_cnt++;
+
+    flush_queue_pump(disp);
+
+    disp->ring_buf_act = (disp->ring_buf_act + 1) % disp->ring_buf_cnt;
+    disp->buf_act = disp->ring_bufs[disp->ring_buf_act];
+
+    /*The buffers are flushed in the order of rendering so the next buffer is free
+     *if there are less queued and flushed buffers than the ring has*/
+    while(disp->flush_queue_cnt + (disp->flushing ? 1 : 0) >= disp->ring_buf_cnt) {
+        wait_for_flushing(disp);
+        flush_queue_pump(disp);
+    }
+}
+
+/**
+ * Pass the oldest queued area to `flush_cb` if the earlier flush is ready
+ * @param disp      pointer to a display
+ */
+static void flush_queue_pump(lv_display_t * disp)
+{
+    if(disp->flush_queue_cnt == 0 || disp->flushing) return;
+
+    lv_display_flush_queue_item_t * item = &disp->flush_queue[disp->flush_queue_head];
+    disp->flush_queue_head = (disp->flush_queue_head + 1) % disp->ring_buf_cnt;
+    disp->flush_queue_cnt--;
+
+    disp->flushing = 1;
+    disp->flushing_last = item->last;
+    if(disp->flush_cb) {
+        call_flush_cb(disp, &item->area, item->px_map);
+    }
+}
+
+/**
+ * Pass all the queued areas to `flush_cb`. Only the last one can be in progress when it returns.
+ * @param disp      pointer to a display
+ */
+static void flush_queue_drain(lv_display_t * disp)
+{
+    while(disp->flush_queue_cnt) {
+        wait_for_flushing(disp);
+        flush_queue_pump(disp);
+    }
+}
+
+#endif /*LV_USE_DISPLAY_BUF_RING*/
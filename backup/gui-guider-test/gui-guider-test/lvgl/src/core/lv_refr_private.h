@@ -46,6 +46,18 @@ void lv_refr_deinit(void);
  */
 void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+#if LV_USE_SCROLL_BLIT
+/**
+ * Invalidate an object whose content was scrolled.
+ * If possible, the already rendered content is moved in the frame buffer before the next refresh
+ * and only the newly exposed part is invalidated. Else the whole object is invalidated.
+ * @param obj   pointer to a scrolled object
+ * @param dx    the content was moved by this many pixels horizontally
+ * @param dy    the content was moved by this many pixels vertically
+ */
+void lv_refr_invalidate_scroll(lv_obj_t * obj, int32_t dx, int32_t dy);
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -411,8 +411,55 @@ void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_d
     disp->buf_1 = buf1;
     disp->buf_2 = buf2;
     disp->buf_act = disp->buf_1;
+#if LV_USE_DISPLAY_BUF_RING
+    disp->ring_buf_cnt = 0;
+#endif
+}
+
+#if LV_USE_DISPLAY_BUF_RING
+
+void lv_display_set_buffer_ring(lv_display_t * disp, void * bufs[], uint32_t cnt, uint32_t buf_size)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    LV_ASSERT_MSG(cnt >= 2 && cnt <= LV_DISPLAY_BUF_RING_MAX, "Invalid number of buffers");
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    uint32_t w = lv_display_get_horizontal_resolution(disp);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+    uint32_t h = buf_size / stride;
+    LV_ASSERT_MSG(h != 0, "the buffer is too small");
+
+    lv_draw_buf_t * draw_bufs[LV_DISPLAY_BUF_RING_MAX];
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        LV_ASSERT_FORMAT_MSG(bufs[i] == lv_draw_buf_align(bufs[i], cf), "buffer %d is not aligned: %p", (int)i, bufs[i]);
+        lv_draw_buf_init(&disp->_static_ring_bufs[i], w, h, cf, stride, bufs[i], buf_size);
+        draw_bufs[i] = &disp->_static_ring_bufs[i];
+    }
+
+    lv_display_set_draw_buffer_ring(disp, draw_bufs, cnt);
 }
 
+void lv_display_set_draw_buffer_ring(lv_display_t * disp, lv_draw_buf_t * bufs[], uint32_t cnt)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    LV_ASSERT_MSG(cnt >= 2 && cnt <= LV_DISPLAY_BUF_RING_MAX, "Invalid number of buffers");
+    cnt = LV_CLAMP(2, cnt, LV_DISPLAY_BUF_RING_MAX);
+
+    /*The first two buffers are used as normal double buffers where the ring is not handled*/
+    lv_display_set_draw_buffers(disp, bufs[0], bufs[1]);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_memcpy(disp->ring_bufs, bufs, cnt * sizeof(lv_draw_buf_t *));
+    disp->ring_buf_cnt = cnt;
+    disp->ring_buf_act = 0;
+}
+
+#endif /*LV_USE_DISPLAY_BUF_RING*/
+
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                             lv_display_render_mode_t render_mode)
 {
@@ -474,6 +521,14 @@ void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t re
     if(disp == NULL) disp = lv_display_get_default();
     if(disp == NULL) return;
     disp->render_mode = render_mode;
+
+#if LV_USE_DISPLAY_BUF_RING
+    /*The ring is used only in PARTIAL mode, continue with the first two buffers*/
+    if(render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL && disp->ring_buf_cnt) {
+        disp->ring_buf_cnt = 0;
+        disp->buf_act = disp->buf_1;
+    }
+#endif
 }
 
 void lv_display_set_flush_cb(lv_display_t * disp, lv_display_flush_cb_t flush_cb)
@@ -501,6 +556,12 @@ void lv_display_set_color_format(lv_display_t * disp, lv_color_format_t color_fo
     disp->layer_head->color_format = color_format;
     if(disp->buf_1) disp->buf_1->header.cf = color_format;
     if(disp->buf_2) disp->buf_2->header.cf = color_format;
+#if LV_USE_DISPLAY_BUF_RING
+    uint32_t i;
+    for(i = 0; i < disp->ring_buf_cnt; i++) {
+        disp->ring_bufs[i]->header.cf = color_format;
+    }
+#endif
 
     lv_display_send_event(disp, LV_EVENT_COLOR_FORMAT_CHANGED, NULL);
 }
@@ -544,6 +605,14 @@ bool lv_display_is_double_buffered(lv_display_t * disp)
     return disp->buf_2 != NULL;
 }
 
+uint32_t lv_display_get_render_stall_time(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return 0;
+
+    return disp->render_stall_time;
+}
+
 /*---------------------
   * SCREENS
   *--------------------*/
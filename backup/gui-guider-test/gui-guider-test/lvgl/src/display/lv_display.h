@@ -264,10 +264,37 @@ void lv_display_set_buffers_with_stride(lv_display_t * disp, void * buf1, void *
  */
 void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_draw_buf_t * buf2);
 
+#if LV_USE_DISPLAY_BUF_RING
+
+/**
+ * Set more than 2 buffers to render into one after the other in LV_DISPLAY_RENDER_MODE_PARTIAL.
+ * The rendered buffers are queued and passed to `flush_cb` one by one when the earlier flush is ready,
+ * so rendering needs to wait only if all the buffers are queued or being flushed.
+ * `flush_cb` is called only from LVGL's thread but it's worth calling `lv_display_flush_ready()`
+ * (instead of using a `flush_wait_cb`) to let the queued buffers be flushed while rendering.
+ * @param disp              pointer to a display
+ * @param bufs              array of buffers (the array is copied)
+ * @param cnt               number of buffers, 2..LV_DISPLAY_BUF_RING_MAX
+ * @param buf_size          size of each buffer in bytes
+ */
+void lv_display_set_buffer_ring(lv_display_t * disp, void * bufs[], uint32_t cnt, uint32_t buf_size);
+
+/**
+ * Set more than 2 draw buffers to render into one after the other in LV_DISPLAY_RENDER_MODE_PARTIAL.
+ * Similar to `lv_display_set_buffer_ring` but accept draw buffers.
+ * @param disp              pointer to a display
+ * @param bufs              array of draw buffers (the array is copied)
+ * @param cnt               number of draw buffers, 2..LV_DISPLAY_BUF_RING_MAX
+ */
+void lv_display_set_draw_buffer_ring(lv_display_t * disp, lv_draw_buf_t * bufs[], uint32_t cnt);
+
+#endif /*LV_USE_DISPLAY_BUF_RING*/
+
 /**
  * Set display render mode
  * @param disp              pointer to a display
  * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @note                    switching away from PARTIAL mode drops the buffer ring set by `lv_display_set_buffer_ring`
  */
 void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t render_mode);
 
@@ -343,6 +370,13 @@ LV_ATTRIBUTE_FLUSH_READY bool lv_display_flush_is_last(lv_display_t * disp);
 
 bool lv_display_is_double_buffered(lv_display_t * disp);
 
+/**
+ * Get how long rendering had to wait for the buffers to be flushed.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          the sum of the waiting times since the display was created [ms]
+ */
+uint32_t lv_display_get_render_stall_time(lv_display_t * disp);
+
 /*---------------------
  * SCREENS
  *--------------------*/
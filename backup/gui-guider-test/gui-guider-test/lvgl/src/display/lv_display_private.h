@@ -29,10 +29,31 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#if LV_USE_SCROLL_BLIT
+#define LV_DISPLAY_SCROLL_BLIT_CNT 4 /**< Number of scrolled areas to move in one refresh */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_SCROLL_BLIT
+typedef struct {
+    const lv_obj_t * obj;   /**< The scrolled object. Used only to merge its scrolls.*/
+    lv_area_t area;         /**< The area in which the content is moved*/
+    int32_t dx;             /**< Move the content by this many pixels horizontally*/
+    int32_t dy;             /**< Move the content by this many pixels vertically*/
+} lv_display_scroll_blit_t;
+#endif
+
+#if LV_USE_DISPLAY_BUF_RING
+typedef struct {
+    lv_area_t area;         /**< The rendered area*/
+    uint8_t * px_map;       /**< The rendered pixels*/
+    bool last;              /**< It's the last area of the refresh*/
+} lv_display_flush_queue_item_t;
+#endif
+
 struct lv_display_t {
 
     /*---------------------
@@ -106,8 +127,34 @@ struct lv_display_t {
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
+#if LV_USE_SCROLL_BLIT
+    /** Already rendered areas to move before the next refresh*/
+    lv_display_scroll_blit_t scroll_blits[LV_DISPLAY_SCROLL_BLIT_CNT];
+    uint32_t scroll_blit_cnt;
+#endif
+
     lv_draw_buf_t _static_buf1; /**< Used when user pass in a raw buffer as display draw buffer */
     lv_draw_buf_t _static_buf2;
+
+#if LV_USE_DISPLAY_BUF_RING
+    /** Buffers to render into one after the other. `buf_1` and `buf_2` are the first two of them.
+     * 0 buffers: the buffer ring is not used*/
+    lv_draw_buf_t * ring_bufs[LV_DISPLAY_BUF_RING_MAX];
+    uint32_t ring_buf_cnt;
+
+    /** Index of `buf_act` in `ring_bufs`*/
+    uint32_t ring_buf_act;
+
+    /** Rendered areas waiting for the earlier ones to be flushed*/
+    lv_display_flush_queue_item_t flush_queue[LV_DISPLAY_BUF_RING_MAX];
+    uint32_t flush_queue_head;
+    uint32_t flush_queue_cnt;
+
+    lv_draw_buf_t _static_ring_bufs[LV_DISPLAY_BUF_RING_MAX];
+#endif
+
+    /** Time spent while rendering with waiting for a buffer to be flushed [ms]*/
+    uint32_t render_stall_time;
     /*---------------------
      * Layer
      *--------------------*/
@@ -23,14 +23,35 @@
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+#define OCCLUDER_MAX    16  /**< Max number of opaque areas to cull the draw tasks with*/
+#endif
+
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+#define LAYER_SIMPLE_BUF_UPDATE_PERIOD  1000    /**< Check the free memory at most this often [ms]*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_DRAW_OCCLUSION_CULL
+typedef struct {
+    lv_area_t area;     /**< The area where all pixels are opaque*/
+    uint32_t idx;       /**< Index of the draw task in the layer*/
+} occluder_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+#if LV_USE_DRAW_OCCLUSION_CULL
+    static bool get_opaque_area(const lv_draw_task_t * t, lv_area_t * area);
+#endif
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    static lv_draw_buf_t * layer_buf_get(uint32_t w, uint32_t h, lv_color_format_t cf);
+    static bool layer_buf_put(lv_draw_buf_t * draw_buf);
+#endif
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -57,6 +78,10 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    _draw_info.layer_simple_buf_size = LV_DRAW_LAYER_SIMPLE_BUF_SIZE;
+    _draw_info.layer_simple_buf_dirty = true;
+#endif
 }
 
 void lv_draw_deinit(void)
@@ -74,6 +99,10 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    lv_draw_layer_release_bufs();
+#endif
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -144,6 +173,15 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             u = u->next;
         }
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+        /*Don't keep too many draw tasks queued. Draw the ones added so far to free them.*/
+        if(layer->occlusion_pending && ++layer->occlusion_task_cnt >= LV_DRAW_OCCLUSION_CULL_TASK_MAX) {
+            lv_draw_occlusion_cull(layer);
+            lv_draw_dispatch();
+            lv_draw_occlusion_begin(layer);
+        }
+#endif
+
         lv_draw_dispatch();
     }
     else {
@@ -215,7 +253,10 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 
                     _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
                     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
-                    lv_draw_buf_destroy(layer_drawn->draw_buf);
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+                    if(!layer_buf_put(layer_drawn->draw_buf))
+#endif
+                        lv_draw_buf_destroy(layer_drawn->draw_buf);
                     layer_drawn->draw_buf = NULL;
                 }
 
@@ -319,6 +360,13 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
      * draw tasks of that layer can be consumed and can be finished.
      * After that this layer-to-blenf will have `LV_DRAW_TASK_STATE_QUEUED`
      * so it can be blended normally.*/
+#if LV_USE_DRAW_OCCLUSION_CULL
+    if(layer->occlusion_pending) {
+        LV_PROFILER_END;
+        return NULL;
+    }
+#endif
+
     if(_draw_info.unit_cnt <= 1) {
         lv_draw_task_t * t = layer->draw_task_head;
         while(t) {
@@ -398,6 +446,15 @@ uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t color_format, const lv_area_t * area)
 {
     lv_display_t * disp = lv_refr_get_disp_refreshing();
+
+#if LV_USE_DRAW_OCCLUSION_CULL
+    /*Let the parent's tasks be drawn, else the earlier child layers would wait for blending
+     *with their buffers allocated. Keep the new tasks queued again when the new layer is added.*/
+    if(parent_layer && parent_layer->occlusion_pending) {
+        lv_draw_occlusion_cull(parent_layer);
+        parent_layer->occlusion_paused = true;
+    }
+#endif
     lv_layer_t * new_layer = lv_malloc_zeroed(sizeof(lv_layer_t));
     LV_ASSERT_MALLOC(new_layer);
     if(new_layer == NULL) return NULL;
@@ -436,7 +493,23 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     int32_t h = lv_area_get_height(&layer->buf_area);
     uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer->color_format);
 
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    layer->draw_buf = layer_buf_get(w, h, layer->color_format);
+    if(layer->draw_buf == NULL) {
+        layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+
+        /*The kept buffers don't fit, free them to make room for the new one*/
+        if(layer->draw_buf == NULL && _draw_info.layer_bufs[0]) {
+            lv_draw_layer_release_bufs();
+            layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+        }
+
+        /*Probably the simple layer chunks are too large too*/
+        if(layer->draw_buf == NULL) _draw_info.layer_simple_buf_dirty = true;
+    }
+#else
     layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+#endif
 
     if(layer->draw_buf == NULL) {
         LV_LOG_WARN("Allocating layer buffer failed. Try later");
@@ -458,6 +531,60 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
     return lv_draw_buf_goto_xy(layer->draw_buf, x, y);
 }
 
+uint32_t lv_draw_layer_get_simple_buf_size(void)
+{
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    return _draw_info.layer_simple_buf_size;
+#else
+    return LV_DRAW_LAYER_SIMPLE_BUF_SIZE;
+#endif
+}
+
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+void lv_draw_layer_update_simple_buf_size(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    /*Check now if the layer memory has just changed, else only periodically to let the chunks grow again*/
+    if(!_draw_info.layer_simple_buf_dirty &&
+       lv_tick_elaps(_draw_info.layer_simple_buf_update_time) < LAYER_SIMPLE_BUF_UPDATE_PERIOD) {
+        return;
+    }
+
+    _draw_info.layer_simple_buf_dirty = false;
+    _draw_info.layer_simple_buf_update_time = lv_tick_get();
+
+    /*Use at most a quarter of the largest free block where the layers can be allocated
+     *and the kept buffers as they will be reused anyway*/
+    uint32_t size = lv_mem_get_free_biggest(LV_MEM_TAG_RENDER) / 4;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_LAYER_BUF_REUSE_CNT; i++) {
+        if(_draw_info.layer_bufs[i] && _draw_info.layer_bufs[i]->data_size > size) {
+            size = _draw_info.layer_bufs[i]->data_size;
+        }
+    }
+
+    size = LV_CLAMP(LV_DRAW_LAYER_SIMPLE_BUF_SIZE, size, LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE);
+    _draw_info.layer_simple_buf_size = size;
+#else
+    /*The free memory is unknown with the other allocators*/
+    _draw_info.layer_simple_buf_size = LV_DRAW_LAYER_SIMPLE_BUF_SIZE;
+#endif
+}
+
+void lv_draw_layer_release_bufs(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_LAYER_BUF_REUSE_CNT; i++) {
+        if(_draw_info.layer_bufs[i]) {
+            _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(_draw_info.layer_bufs[i]->data_size);
+            lv_draw_buf_destroy(_draw_info.layer_bufs[i]);
+            _draw_info.layer_bufs[i] = NULL;
+            _draw_info.layer_simple_buf_dirty = true;
+        }
+    }
+}
+#endif /*LV_USE_DRAW_LAYER_BUF_REUSE*/
+
 lv_draw_task_type_t lv_draw_task_get_type(const lv_draw_task_t * t)
 {
     return t->type;
@@ -473,10 +600,179 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
     *area = t->area;
 }
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+
+void lv_draw_occlusion_begin(lv_layer_t * layer)
+{
+    layer->occlusion_paused = false;
+    layer->occlusion_task_cnt = 0;
+#if !LV_DRAW_TRANSFORM_USE_MATRIX
+    layer->occlusion_pending = true;
+#endif
+}
+
+void lv_draw_occlusion_cull(lv_layer_t * layer)
+{
+    if(!layer->occlusion_pending) return;
+
+    LV_PROFILER_BEGIN;
+    layer->occlusion_pending = false;
+
+    /*Collect the largest opaque areas*/
+    occluder_t occluders[OCCLUDER_MAX];
+    uint32_t occluder_cnt = 0;
+    uint32_t idx = 0;
+    lv_draw_task_t * t;
+    for(t = layer->draw_task_head; t; t = t->next, idx++) {
+        lv_area_t a;
+        if(!get_opaque_area(t, &a)) continue;
+
+        uint32_t i = occluder_cnt;
+        if(occluder_cnt < OCCLUDER_MAX) {
+            occluder_cnt++;
+        }
+        else {
+            /*Replace the smallest one if the new is larger*/
+            uint32_t j;
+            i = 0;
+            for(j = 1; j < OCCLUDER_MAX; j++) {
+                if(lv_area_get_size(&occluders[j].area) < lv_area_get_size(&occluders[i].area)) i = j;
+            }
+            if(lv_area_get_size(&occluders[i].area) >= lv_area_get_size(&a)) continue;
+        }
+
+        occluders[i].area = a;
+        occluders[i].idx = idx;
+    }
+
+    /*Skip or clip the draw tasks covered by later occluders*/
+    idx = 0;
+    for(t = layer->draw_task_head; t && occluder_cnt; t = t->next, idx++) {
+        if(t->state != LV_DRAW_TASK_STATE_QUEUED) continue;
+
+        lv_area_t drawn;
+        if(!lv_area_intersect(&drawn, &t->_real_area, &t->clip_area)) continue;
+        uint32_t size_ori = lv_area_get_size(&drawn);
+
+        bool covered = false;
+        uint32_t i;
+        for(i = 0; i < occluder_cnt; i++) {
+            if(occluders[i].idx <= idx) continue;
+
+            const lv_area_t * o = &occluders[i].area;
+            if(lv_area_is_in(&drawn, o, 0)) {
+                covered = true;
+                break;
+            }
+
+            /*Cut the covered band if it's as wide or as tall as the drawn area*/
+            if(o->x1 <= drawn.x1 && o->x2 >= drawn.x2) {
+                if(o->y1 <= drawn.y1 && o->y2 >= drawn.y1) drawn.y1 = o->y2 + 1;
+                else if(o->y1 <= drawn.y2 && o->y2 >= drawn.y2) drawn.y2 = o->y1 - 1;
+            }
+            else if(o->y1 <= drawn.y1 && o->y2 >= drawn.y2) {
+                if(o->x1 <= drawn.x1 && o->x2 >= drawn.x1) drawn.x1 = o->x2 + 1;
+                else if(o->x1 <= drawn.x2 && o->x2 >= drawn.x2) drawn.x2 = o->x1 - 1;
+            }
+        }
+
+        /*Layers are freed when their draw task is finished so draw them anyway*/
+        if(covered && t->type != LV_DRAW_TASK_TYPE_LAYER) {
+            t->state = LV_DRAW_TASK_STATE_READY;
+            _draw_info.culled_task_cnt++;
+            _draw_info.culled_px_cnt += size_ori;
+        }
+        else if(!covered && lv_area_get_size(&drawn) < size_ori) {
+            t->clip_area = drawn;
+            _draw_info.culled_px_cnt += size_ori - lv_area_get_size(&drawn);
+        }
+    }
+
+    lv_draw_dispatch_request();
+    LV_PROFILER_END;
+}
+
+uint32_t lv_draw_get_culled_pixel_count(void)
+{
+    return _draw_info.culled_px_cnt;
+}
+
+uint32_t lv_draw_get_culled_task_count(void)
+{
+    return _draw_info.culled_task_cnt;
+}
+
+void lv_draw_reset_cull_counters(void)
+{
+    _draw_info.culled_px_cnt = 0;
+    _draw_info.culled_task_cnt = 0;
+}
+
+#endif /*LV_USE_DRAW_OCCLUSION_CULL*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+/**
+ * Take the smallest kept layer buffer which is large enough and reshape it
+ * @param w         width of the layer
+ * @param h         height of the layer
+ * @param cf        color format of the layer
+ * @return          the reshaped draw buffer or NULL if none of the kept buffers are large enough
+ */
+static lv_draw_buf_t * layer_buf_get(uint32_t w, uint32_t h, lv_color_format_t cf)
+{
+    uint32_t size = h * lv_draw_buf_width_to_stride(w, cf);
+    int32_t best = -1;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_LAYER_BUF_REUSE_CNT; i++) {
+        lv_draw_buf_t * b = _draw_info.layer_bufs[i];
+        if(b == NULL || b->data_size < size) continue;
+        if(best < 0 || b->data_size < _draw_info.layer_bufs[best]->data_size) best = i;
+    }
+
+    if(best < 0) return NULL;
+
+    lv_draw_buf_t * draw_buf = _draw_info.layer_bufs[best];
+    _draw_info.layer_bufs[best] = NULL;
+    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(draw_buf->data_size);
+
+    return lv_draw_buf_reshape(draw_buf, cf, w, h, LV_STRIDE_AUTO);
+}
+
+/**
+ * Keep the buffer of a drawn layer for the next layers.
+ * If all slots are used the smallest buffer is replaced if the new one is larger.
+ * The kept buffers are counted in `used_memory_for_layers_kb` with their full size.
+ * @param draw_buf  the draw buffer of a layer
+ * @return          true: the buffer is kept; false: the buffer should be destroyed
+ */
+static bool layer_buf_put(lv_draw_buf_t * draw_buf)
+{
+    int32_t smallest = -1;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_LAYER_BUF_REUSE_CNT; i++) {
+        lv_draw_buf_t * b = _draw_info.layer_bufs[i];
+        if(b == NULL) {
+            _draw_info.layer_bufs[i] = draw_buf;
+            _draw_info.used_memory_for_layers_kb += get_layer_size_kb(draw_buf->data_size);
+            return true;
+        }
+        if(smallest < 0 || b->data_size < _draw_info.layer_bufs[smallest]->data_size) smallest = i;
+    }
+
+    if(_draw_info.layer_bufs[smallest]->data_size >= draw_buf->data_size) return false;
+
+    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(_draw_info.layer_bufs[smallest]->data_size);
+    lv_draw_buf_destroy(_draw_info.layer_bufs[smallest]);
+    _draw_info.layer_bufs[smallest] = draw_buf;
+    _draw_info.used_memory_for_layers_kb += get_layer_size_kb(draw_buf->data_size);
+    return true;
+}
+#endif /*LV_USE_DRAW_LAYER_BUF_REUSE*/
+
 /**
  * Check if there are older draw task overlapping the area of `t_check`
  * @param layer      the draw ctx to search in
@@ -503,3 +799,67 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 
     return true;
 }
+
+#if LV_USE_DRAW_OCCLUSION_CULL
+
+/**
+ * Get the area where a draw task surely covers all pixels
+ * @param t         pointer to a draw task
+ * @param area      store the area here
+ * @return          true: `area` is set; false: the draw task doesn't cover any area
+ */
+static bool get_opaque_area(const lv_draw_task_t * t, lv_area_t * area)
+{
+    if(t->state != LV_DRAW_TASK_STATE_QUEUED) return false;
+
+    if(t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+        if(dsc->opa < LV_OPA_MAX) return false;
+        if(dsc->grad.dir != LV_GRAD_DIR_NONE) {
+            if(dsc->grad.dir != LV_GRAD_DIR_VER && dsc->grad.dir != LV_GRAD_DIR_HOR) return false;
+            uint32_t i;
+            for(i = 0; i < dsc->grad.stops_count; i++) {
+                if(dsc->grad.stops[i].opa < LV_OPA_MAX) return false;
+            }
+        }
+
+        /*Leave out the rounded corners. The corner circles are out of the area shrunk by
+         *radius * (1 - 1 / sqrt(2)). Shrink it by a little more to leave out the anti-aliased pixels too.*/
+        int32_t w = lv_area_get_width(&t->area);
+        int32_t h = lv_area_get_height(&t->area);
+        int32_t radius = LV_MIN(dsc->radius, LV_MIN(w, h) / 2);
+        int32_t inset = radius > 0 ? (radius * 3) / 10 + 1 : 0;
+        *area = t->area;
+        lv_area_increase(area, -inset, -inset);
+    }
+    else if(t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        const lv_draw_image_dsc_t * dsc = t->draw_dsc;
+        if(dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+        if(dsc->rotation != 0 || dsc->skew_x != 0 || dsc->skew_y != 0) return false;
+        if(dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE) return false;
+        if(dsc->tile || dsc->clip_radius > 0 || dsc->bitmap_mask_src) return false;
+        if(lv_area_get_width(&t->area) != dsc->header.w || lv_area_get_height(&t->area) != dsc->header.h) return false;
+
+        /*Only the not compressed images from variables are sure to be decoded*/
+        if(lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+        if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return false;
+
+        switch(dsc->header.cf) {
+            case LV_COLOR_FORMAT_RGB565:
+            case LV_COLOR_FORMAT_RGB888:
+            case LV_COLOR_FORMAT_XRGB8888:
+            case LV_COLOR_FORMAT_L8:
+                break;
+            default:
+                return false;
+        }
+        *area = t->area;
+    }
+    else {
+        return false;
+    }
+
+    return lv_area_intersect(area, area, &t->clip_area);
+}
+
+#endif /*LV_USE_DRAW_OCCLUSION_CULL*/
@@ -104,6 +104,16 @@ struct lv_layer_t  {
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
+#if LV_USE_DRAW_OCCLUSION_CULL
+    /** The draw tasks are kept queued until `lv_draw_occlusion_cull()` is called*/
+    uint8_t occlusion_pending : 1;
+
+    /** Keep the draw tasks queued again when the currently created child layer is added*/
+    uint8_t occlusion_paused : 1;
+
+    /** Number of draw tasks added since `lv_draw_occlusion_begin()`*/
+    uint32_t occlusion_task_cnt;
+#endif
     void * user_data;
 };
 
@@ -257,6 +267,27 @@ void * lv_draw_task_get_draw_dsc(const lv_draw_task_t * t);
 */
 void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area);
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+
+/**
+ * Get the number of pixels which were not drawn because later opaque draw tasks covered them
+ * @return      the number of culled pixels since the last `lv_draw_reset_cull_counters()`
+ */
+uint32_t lv_draw_get_culled_pixel_count(void);
+
+/**
+ * Get the number of draw tasks which were skipped because later opaque draw tasks covered them
+ * @return      the number of culled draw tasks since the last `lv_draw_reset_cull_counters()`
+ */
+uint32_t lv_draw_get_culled_task_count(void);
+
+/**
+ * Reset the counters of the culled pixels and draw tasks
+ */
+void lv_draw_reset_cull_counters(void);
+
+#endif /*LV_USE_DRAW_OCCLUSION_CULL*/
+
 /**********************
  *  GLOBAL VARIABLES
  **********************/
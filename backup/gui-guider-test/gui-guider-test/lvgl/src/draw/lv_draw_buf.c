@@ -12,6 +12,7 @@
 #include "../core/lv_global.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_area_private.h"
+#include "../tick/lv_tick.h"
 
 /*********************
  *      DEFINES
@@ -19,15 +20,37 @@
 #define default_handlers LV_GLOBAL_DEFAULT()->draw_buf_handlers
 #define font_draw_buf_handlers LV_GLOBAL_DEFAULT()->font_draw_buf_handlers
 #define image_cache_draw_buf_handlers LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers
+#define draw_buf_pool LV_GLOBAL_DEFAULT()->draw_buf_pool
+
+/*Smaller buffers are not worth pooling*/
+#define POOL_MIN_SIZE 1024
+
+/*A larger idle buffer can be reused if the unused part is less than this*/
+#define POOL_MAX_WASTE_PCT 50
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_DRAW_BUF_POOL
+/*Stored before every buffer allocated by `buf_malloc`*/
+typedef struct {
+    uint32_t size;          /*Bucket size of a pooled buffer, 0 if it's not pooled*/
+    uint32_t tag;           /*`lv_mem_tag_t` of the buffer, as it's reused only for the same tag.
+                             *Also keeps the buffer 8 bytes aligned.*/
+} pool_header_t;
+
+/*Stored in the data of the idle buffers*/
+typedef struct {
+    pool_header_t * next;
+    uint32_t free_time;
+} pool_idle_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void * buf_malloc(size_t size, lv_color_format_t color_format);
+static void * buf_malloc_cache(size_t size, lv_color_format_t color_format);
 static void buf_free(void * buf);
 static void * buf_align(void * buf, lv_color_format_t color_format);
 static void * draw_buf_malloc(const lv_draw_buf_handlers_t * handler, size_t size_bytes,
@@ -36,6 +59,14 @@ static void draw_buf_free(const lv_draw_buf_handlers_t * handler, void * buf);
 static uint32_t width_to_stride(uint32_t w, lv_color_format_t color_format);
 static uint32_t _calculate_draw_buf_size(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride);
 static void draw_buf_get_full_area(const lv_draw_buf_t * draw_buf, lv_area_t * full_area);
+#if LV_USE_DRAW_BUF_POOL
+    static uint32_t pool_get_bucket_size(size_t size);
+    static void * pool_alloc(size_t size, lv_mem_tag_t tag);
+    static void pool_free(void * buf);
+    static pool_header_t * pool_unlink(pool_header_t * prev, pool_header_t * hdr);
+    static inline void pool_lock(void);
+    static inline void pool_unlock(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -54,6 +85,14 @@ void lv_draw_buf_init_handlers(void)
     lv_draw_buf_init_with_default_handlers(&default_handlers);
     lv_draw_buf_init_with_default_handlers(&font_draw_buf_handlers);
     lv_draw_buf_init_with_default_handlers(&image_cache_draw_buf_handlers);
+
+    /*The glyphs and decoded images are kept for long, so place them with the cached data*/
+    font_draw_buf_handlers.buf_malloc_cb = buf_malloc_cache;
+    image_cache_draw_buf_handlers.buf_malloc_cb = buf_malloc_cache;
+
+#if LV_USE_DRAW_BUF_POOL && LV_USE_OS
+    lv_mutex_init(&draw_buf_pool.mutex);
+#endif
 }
 
 void lv_draw_buf_init_with_default_handlers(lv_draw_buf_handlers_t * handlers)
@@ -590,6 +629,49 @@ void lv_image_buf_free(lv_image_dsc_t * dsc)
     }
 }
 
+#if LV_USE_DRAW_BUF_POOL
+
+void lv_draw_buf_pool_trim(uint32_t idle_ms)
+{
+    pool_lock();
+
+    /*The list is ordered by the free time so the rest is even older after the first old enough buffer*/
+    pool_header_t * prev = NULL;
+    pool_header_t * hdr = draw_buf_pool.idle_list;
+    while(hdr) {
+        pool_idle_t * idle = (pool_idle_t *)(hdr + 1);
+        if(idle_ms == 0 || lv_tick_elaps(idle->free_time) >= idle_ms) break;
+        prev = hdr;
+        hdr = idle->next;
+    }
+
+    while(hdr) {
+        hdr = pool_unlink(prev, hdr);
+    }
+
+    pool_unlock();
+}
+
+void lv_draw_buf_pool_monitor(lv_draw_buf_pool_monitor_t * mon_p)
+{
+    LV_ASSERT_NULL(mon_p);
+
+    pool_lock();
+    *mon_p = draw_buf_pool.mon;
+    pool_unlock();
+}
+
+void lv_draw_buf_pool_deinit(void)
+{
+    lv_draw_buf_pool_trim(0);
+#if LV_USE_OS
+    lv_mutex_delete(&draw_buf_pool.mutex);
+#endif
+    lv_memzero(&draw_buf_pool, sizeof(draw_buf_pool));
+}
+
+#endif /*LV_USE_DRAW_BUF_POOL*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -600,12 +682,32 @@ static void * buf_malloc(size_t size_bytes, lv_color_format_t color_format)
 
     /*Allocate larger memory to be sure it can be aligned as needed*/
     size_bytes += LV_DRAW_BUF_ALIGN - 1;
-    return lv_malloc(size_bytes);
+#if LV_USE_DRAW_BUF_POOL
+    return pool_alloc(size_bytes, LV_MEM_TAG_RENDER);
+#else
+    return lv_malloc_tagged(size_bytes, LV_MEM_TAG_RENDER);
+#endif
+}
+
+static void * buf_malloc_cache(size_t size_bytes, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+
+    size_bytes += LV_DRAW_BUF_ALIGN - 1;
+#if LV_USE_DRAW_BUF_POOL
+    return pool_alloc(size_bytes, LV_MEM_TAG_CACHE);
+#else
+    return lv_malloc_tagged(size_bytes, LV_MEM_TAG_CACHE);
+#endif
 }
 
 static void buf_free(void * buf)
 {
+#if LV_USE_DRAW_BUF_POOL
+    pool_free(buf);
+#else
     lv_free(buf);
+#endif
 }
 
 static void * buf_align(void * buf, lv_color_format_t color_format)
@@ -667,3 +769,163 @@ static void draw_buf_get_full_area(const lv_draw_buf_t * draw_buf, lv_area_t * f
     const lv_image_header_t * header = &draw_buf->header;
     lv_area_set(full_area, 0, 0, header->w - 1, header->h - 1);
 }
+
+#if LV_USE_DRAW_BUF_POOL
+
+/**
+ * Round up the size to one of the 4 steps between the powers of 2,
+ * so at most 25% is wasted but similar buffers still share a bucket.
+ */
+static uint32_t pool_get_bucket_size(size_t size)
+{
+    if(size < POOL_MIN_SIZE || size > LV_DRAW_BUF_POOL_SIZE) return 0;
+
+    uint32_t step = 1;
+    while((step << 3) < size) step <<= 1;
+
+    return LV_ROUND_UP((uint32_t)size, step);
+}
+
+static void * pool_alloc(size_t size, lv_mem_tag_t tag)
+{
+    /*Both the render buffers and the decoded images of the image cache are pooled.
+     *The images freed on eviction are reused by the next decoded image of similar size.*/
+    uint32_t bucket = pool_get_bucket_size(size);
+
+    if(bucket) {
+        pool_lock();
+
+        /*Find the smallest idle buffer which is large enough but wastes less than POOL_MAX_WASTE_PCT*/
+        uint32_t max_size = bucket + bucket * POOL_MAX_WASTE_PCT / 100;
+        pool_header_t * best_prev = NULL;
+        pool_header_t * best = NULL;
+        pool_header_t * prev = NULL;
+        pool_header_t * hdr = draw_buf_pool.idle_list;
+        while(hdr) {
+            if(hdr->tag == (uint32_t)tag && hdr->size >= bucket && hdr->size <= max_size &&
+               (best == NULL || hdr->size < best->size)) {
+                best = hdr;
+                best_prev = prev;
+                if(hdr->size == bucket) break;
+            }
+            prev = hdr;
+            hdr = ((pool_idle_t *)(hdr + 1))->next;
+        }
+
+        if(best) {
+            pool_header_t * next = ((pool_idle_t *)(best + 1))->next;
+            if(best_prev) ((pool_idle_t *)(best_prev + 1))->next = next;
+            else draw_buf_pool.idle_list = next;
+
+            draw_buf_pool.mon.idle_size -= best->size;
+            draw_buf_pool.mon.idle_cnt--;
+            draw_buf_pool.mon.used_size += best->size;
+            draw_buf_pool.mon.hit_cnt++;
+            pool_unlock();
+            return best + 1;
+        }
+
+        draw_buf_pool.mon.miss_cnt++;
+        pool_unlock();
+
+        size = bucket;
+    }
+
+    pool_header_t * hdr = lv_malloc_tagged(sizeof(pool_header_t) + size, tag);
+    if(hdr == NULL && draw_buf_pool.mon.idle_cnt) {
+        /*The idle buffers might fragment the heap. Free them and try again.*/
+        LV_LOG_INFO("out of memory, freeing the %" LV_PRIu32 " idle buffers of the pool", draw_buf_pool.mon.idle_cnt);
+        lv_draw_buf_pool_trim(0);
+        hdr = lv_malloc_tagged(sizeof(pool_header_t) + size, tag);
+    }
+    if(hdr == NULL) return NULL;
+
+    hdr->size = bucket;
+    hdr->tag = tag;
+
+    if(bucket) {
+        pool_lock();
+        draw_buf_pool.mon.used_size += bucket;
+        uint32_t total = draw_buf_pool.mon.used_size + draw_buf_pool.mon.idle_size;
+        if(total > draw_buf_pool.mon.max_size) draw_buf_pool.mon.max_size = total;
+        pool_unlock();
+    }
+
+    return hdr + 1;
+}
+
+static void pool_free(void * buf)
+{
+    if(buf == NULL) return;
+
+    pool_header_t * hdr = (pool_header_t *)buf - 1;
+    if(hdr->size == 0) {
+        lv_free(hdr);
+        return;
+    }
+
+    pool_lock();
+
+    draw_buf_pool.mon.used_size -= hdr->size;
+
+    pool_idle_t * idle = buf;
+    idle->next = draw_buf_pool.idle_list;
+    idle->free_time = lv_tick_get();
+    draw_buf_pool.idle_list = hdr;
+    draw_buf_pool.mon.idle_size += hdr->size;
+    draw_buf_pool.mon.idle_cnt++;
+
+    /*Free the least recently used buffers if the pool grew too large*/
+    if(draw_buf_pool.mon.idle_size > LV_DRAW_BUF_POOL_SIZE) {
+        uint32_t keep_size = 0;
+        pool_header_t * prev = NULL;
+        pool_header_t * h = draw_buf_pool.idle_list;
+        while(h && keep_size + h->size <= LV_DRAW_BUF_POOL_SIZE) {
+            keep_size += h->size;
+            prev = h;
+            h = ((pool_idle_t *)(h + 1))->next;
+        }
+
+        while(h) {
+            h = pool_unlink(prev, h);
+        }
+    }
+
+    pool_unlock();
+}
+
+/**
+ * Remove an idle buffer from the list and free it. The pool needs to be locked.
+ * @param prev  the buffer before `hdr` in the list or NULL if `hdr` is the first
+ * @param hdr   the buffer to free
+ * @return      the next buffer in the list
+ */
+static pool_header_t * pool_unlink(pool_header_t * prev, pool_header_t * hdr)
+{
+    pool_header_t * next = ((pool_idle_t *)(hdr + 1))->next;
+    if(prev) ((pool_idle_t *)(prev + 1))->next = next;
+    else draw_buf_pool.idle_list = next;
+
+    draw_buf_pool.mon.idle_size -= hdr->size;
+    draw_buf_pool.mon.idle_cnt--;
+    draw_buf_pool.mon.trim_cnt++;
+    lv_free(hdr);
+
+    return next;
+}
+
+static inline void pool_lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&draw_buf_pool.mutex);
+#endif
+}
+
+static inline void pool_unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&draw_buf_pool.mutex);
+#endif
+}
+
+#endif /*LV_USE_DRAW_BUF_POOL*/
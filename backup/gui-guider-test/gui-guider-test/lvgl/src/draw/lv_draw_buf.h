@@ -85,6 +85,18 @@ typedef void (*lv_draw_buf_cache_operation_cb)(const lv_draw_buf_t * draw_buf, c
 
 typedef uint32_t (*lv_draw_buf_width_to_stride_cb)(uint32_t w, lv_color_format_t color_format);
 
+#if LV_USE_DRAW_BUF_POOL
+typedef struct {
+    uint32_t idle_size;     /**< Size of the buffers waiting in the pool to be reused*/
+    uint32_t idle_cnt;      /**< Number of the buffers waiting in the pool*/
+    uint32_t used_size;     /**< Size of the pooled size buffers in use*/
+    uint32_t max_size;      /**< High-water mark of `idle_size + used_size`*/
+    uint32_t hit_cnt;       /**< Allocations served from the pool*/
+    uint32_t miss_cnt;      /**< Allocations which needed a new buffer*/
+    uint32_t trim_cnt;      /**< Idle buffers freed because of age, pool size or low memory*/
+} lv_draw_buf_pool_monitor_t;
+#endif
+
 struct lv_draw_buf_t {
     lv_image_header_t header;
     uint32_t data_size;       /**< Total buf size in bytes */
@@ -285,6 +297,21 @@ lv_draw_buf_t * lv_draw_buf_reshape(lv_draw_buf_t * draw_buf, lv_color_format_t
  */
 void lv_draw_buf_destroy(lv_draw_buf_t * draw_buf);
 
+#if LV_USE_DRAW_BUF_POOL
+/**
+ * Free the buffers of the draw buffer pool which weren't reused for a given time.
+ * Called by LVGL after each refresh with `LV_DRAW_BUF_POOL_TRIM_TIME`.
+ * @param idle_ms   free the buffers idle for at least this long. 0: free all the idle buffers
+ */
+void lv_draw_buf_pool_trim(uint32_t idle_ms);
+
+/**
+ * Get the statistics of the draw buffer pool
+ * @param mon_p     pointer to a `lv_draw_buf_pool_monitor_t` to fill
+ */
+void lv_draw_buf_pool_monitor(lv_draw_buf_pool_monitor_t * mon_p);
+#endif
+
 /**
  * Return pointer to the buffer at the given coordinates
  */
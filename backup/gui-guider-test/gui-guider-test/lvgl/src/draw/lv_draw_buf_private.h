@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw_buf.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -33,6 +34,16 @@ struct lv_draw_buf_handlers_t {
     lv_draw_buf_width_to_stride_cb width_to_stride_cb;
 };
 
+#if LV_USE_DRAW_BUF_POOL
+typedef struct {
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+    void * idle_list;                   /**< The idle buffers, most recently freed first*/
+    lv_draw_buf_pool_monitor_t mon;
+} lv_draw_buf_pool_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -42,6 +53,13 @@ struct lv_draw_buf_handlers_t {
  */
 void lv_draw_buf_init_handlers(void);
 
+#if LV_USE_DRAW_BUF_POOL
+/**
+ * Called internally to free the idle buffers of the draw buffer pool in `lv_deinit()`
+ */
+void lv_draw_buf_pool_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -16,6 +16,11 @@
 #include "../core/lv_refr.h"
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
+#if LV_USE_IMAGE_DECODER_ASYNC
+    #include "lv_draw_rect.h"
+    #include "../display/lv_display_private.h"
+    #include "../core/lv_refr_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -33,6 +38,10 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
                                 lv_draw_image_core_cb draw_core_cb);
+#if LV_USE_IMAGE_DECODER_ASYNC
+    static bool is_display_layer(lv_layer_t * layer);
+    static void draw_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -85,6 +94,10 @@ void lv_draw_layer(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
     layer_to_draw->all_tasks_added = true;
 
     lv_draw_finalize_task_creation(layer, t);
+
+#if LV_USE_DRAW_OCCLUSION_CULL
+    if(layer->occlusion_paused) lv_draw_occlusion_begin(layer);
+#endif
 }
 
 void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
@@ -111,6 +124,18 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
         return;
     }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Don't wait for the decoding. The widget will be redrawn when the image is decoded.
+     *Canvases and snapshots are drawn only once, so decode the images for them right away.*/
+    if(is_display_layer(layer) &&
+       lv_image_decoder_async_request(new_image_dsc->src, &new_image_dsc->header, dsc->base.obj) != LV_RESULT_OK) {
+        draw_placeholder(layer, dsc, coords);
+        lv_free(new_image_dsc);
+        LV_PROFILER_END;
+        return;
+    }
+#endif
+
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
     t->draw_dsc = new_image_dsc;
     t->type = LV_DRAW_TASK_TYPE_IMAGE;
@@ -312,3 +337,31 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
         }
     }
 }
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Check if a layer is (or will be blended to) the layer of the display being refreshed
+ * @param layer     pointer to a layer
+ * @return          true: the layer is drawn on a display; false: e.g. a canvas or a snapshot
+ */
+static bool is_display_layer(lv_layer_t * layer)
+{
+    while(layer->parent) layer = layer->parent;
+
+    /*Snapshots replace the display's layer temporarily, but draw to their own buffer*/
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    return disp && layer == disp->layer_head && layer->draw_buf == disp->buf_act;
+}
+
+static void draw_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.base.obj = dsc->base.obj;
+    rect_dsc.base.part = dsc->base.part;
+    rect_dsc.bg_color = lv_color_hex(LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR);
+    rect_dsc.bg_opa = LV_OPA_MIX2(LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA, dsc->opa);
+    rect_dsc.radius = dsc->clip_radius;
+    lv_draw_rect(layer, &rect_dsc, coords);
+}
+#endif
@@ -38,6 +38,11 @@
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
+static inline uint32_t get_line_length(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                       uint32_t line_idx, uint32_t line_start, int32_t w);
+static inline int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                     uint32_t line_idx, uint32_t line_start, uint32_t line_end);
+static uint32_t get_text_hash(const char * text);
 
 /**********************
  *  STATIC VARIABLES
@@ -146,6 +151,227 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_character(lv_layer_t * layer, lv_draw_label_d
     LV_PROFILER_END;
 }
 
+bool lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_w, lv_text_flag_t flag)
+{
+    LV_ASSERT_NULL(layout);
+
+    if(lv_draw_label_layout_is_valid(layout, text, font, letter_space, max_w, flag)) return true;
+
+    LV_PROFILER_BEGIN;
+
+    layout->valid = 0;
+    layout->line_cnt = 0;
+    layout->width = 0;
+
+    uint32_t line_start = 0;
+    while(1) {
+        if(layout->line_cnt + 1 >= layout->line_cap) {
+            uint32_t new_cap = layout->line_cap ? layout->line_cap * 2 : 4;
+            lv_draw_label_layout_line_t * new_lines = lv_realloc(layout->lines, new_cap * sizeof(layout->lines[0]));
+            LV_ASSERT_MALLOC(new_lines);
+            if(new_lines == NULL) {
+                LV_PROFILER_END;
+                return false;
+            }
+            layout->lines = new_lines;
+            layout->line_cap = new_cap;
+        }
+
+        layout->lines[layout->line_cnt].start = line_start;
+        layout->lines[layout->line_cnt].width = 0;
+        if(text[line_start] == '\0') break;
+
+        uint32_t line_len = lv_text_get_next_line(&text[line_start], font, letter_space, max_w, NULL, flag);
+        if(line_len == 0) break;
+
+        int32_t line_w = lv_text_get_width(&text[line_start], line_len, font, letter_space);
+        layout->lines[layout->line_cnt].width = line_w;
+        layout->width = LV_MAX(layout->width, line_w);
+        layout->line_cnt++;
+        line_start += line_len;
+    }
+
+    layout->text = text;
+    if(layout->check_text) layout->text_hash = get_text_hash(text);
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_w = max_w;
+    layout->flag = flag;
+    layout->valid = 1;
+
+    LV_PROFILER_END;
+    return true;
+}
+
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_w, lv_text_flag_t flag)
+{
+    if(!layout->valid) return false;
+    if(layout->text != text || layout->font != font || layout->letter_space != letter_space) return false;
+    if(layout->flag != flag) return false;
+
+    /*Only the new line characters break the lines in these modes*/
+    if(!(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) && layout->max_w != max_w) return false;
+
+    if(layout->check_text && layout->text_hash != get_text_hash(text)) return false;
+
+    return true;
+}
+
+bool lv_draw_label_layout_update_range(lv_draw_label_layout_t * layout, const char * text, uint32_t byte_pos,
+                                       uint32_t del_len, uint32_t ins_len)
+{
+    LV_ASSERT_NULL(layout);
+
+    if(!layout->valid) return false;
+
+    LV_PROFILER_BEGIN;
+
+    /*Lines are broken only after reading the whole next word, so find the beginning of the
+     *word around the modification. The characters before `byte_pos` are unchanged.*/
+    uint32_t word_start = byte_pos;
+    while(word_start > 0) {
+        uint32_t letter = lv_text_encoded_prev(text, &word_start);
+        if(letter == '\n' || letter == '\r' || lv_text_is_break_char(letter) || lv_text_is_a_word(letter)) break;
+    }
+
+    /*Find the line of the word and restart from the line before it
+     *as the word might fit there after the modification*/
+    uint32_t first = lv_draw_label_layout_get_line_index(layout, word_start);
+    if(first > 0) first--;
+
+    const uint32_t old_end = byte_pos + del_len;
+    const uint32_t new_end = byte_pos + ins_len;
+    const int32_t delta = (int32_t)ins_len - (int32_t)del_len;
+
+    lv_draw_label_layout_line_t * new_lines = NULL;
+    uint32_t new_cnt = 0;
+    uint32_t new_cap = 0;
+    uint32_t old_i = first;
+    uint32_t line_start = layout->lines[first].start;
+    while(1) {
+        /*After the modified part the old lines can be used again
+         *if a line starts at the same character as before*/
+        if(line_start >= new_end) {
+            while(old_i <= layout->line_cnt &&
+                  (layout->lines[old_i].start < old_end ||
+                   (int32_t)layout->lines[old_i].start + delta < (int32_t)line_start)) {
+                old_i++;
+            }
+            if(old_i <= layout->line_cnt && (int32_t)layout->lines[old_i].start + delta == (int32_t)line_start) break;
+        }
+
+        uint32_t line_len = 0;
+        if(text[line_start] != '\0') {
+            line_len = lv_text_get_next_line(&text[line_start], layout->font, layout->letter_space, layout->max_w, NULL,
+                                             layout->flag);
+        }
+
+        /*The end of the text should have been found with the old lines*/
+        if(line_len == 0) {
+            lv_free(new_lines);
+            layout->valid = 0;
+            LV_PROFILER_END;
+            return lv_draw_label_layout_update(layout, text, layout->font, layout->letter_space, layout->max_w,
+                                               layout->flag);
+        }
+
+        if(new_cnt >= new_cap) {
+            new_cap = new_cap ? new_cap * 2 : 4;
+            lv_draw_label_layout_line_t * tmp = lv_realloc(new_lines, new_cap * sizeof(new_lines[0]));
+            LV_ASSERT_MALLOC(tmp);
+            if(tmp == NULL) {
+                lv_free(new_lines);
+                layout->valid = 0;
+                LV_PROFILER_END;
+                return false;
+            }
+            new_lines = tmp;
+        }
+
+        new_lines[new_cnt].start = line_start;
+        new_lines[new_cnt].width = lv_text_get_width(&text[line_start], line_len, layout->font, layout->letter_space);
+        new_cnt++;
+        line_start += line_len;
+    }
+
+    /*Replace the old lines `first..old_i-1` with the new ones and shift the rest*/
+    uint32_t keep_cnt = layout->line_cnt + 1 - old_i;   /*+1 for the closing element*/
+    uint32_t line_cnt = first + new_cnt + keep_cnt - 1;
+    if(line_cnt + 1 > layout->line_cap) {
+        lv_draw_label_layout_line_t * tmp = lv_realloc(layout->lines, (line_cnt + 1) * sizeof(layout->lines[0]));
+        LV_ASSERT_MALLOC(tmp);
+        if(tmp == NULL) {
+            lv_free(new_lines);
+            layout->valid = 0;
+            LV_PROFILER_END;
+            return false;
+        }
+        layout->lines = tmp;
+        layout->line_cap = line_cnt + 1;
+    }
+
+    lv_memmove(&layout->lines[first + new_cnt], &layout->lines[old_i], keep_cnt * sizeof(layout->lines[0]));
+    if(new_cnt) lv_memcpy(&layout->lines[first], new_lines, new_cnt * sizeof(layout->lines[0]));
+    lv_free(new_lines);
+
+    uint32_t i;
+    for(i = first + new_cnt; i <= line_cnt; i++) {
+        layout->lines[i].start += delta;
+    }
+
+    layout->line_cnt = line_cnt;
+    layout->text = text;
+    if(layout->check_text) layout->text_hash = get_text_hash(text);
+    layout->width = 0;
+    for(i = 0; i < line_cnt; i++) {
+        layout->width = LV_MAX(layout->width, layout->lines[i].width);
+    }
+
+    LV_PROFILER_END;
+    return true;
+}
+
+uint32_t lv_draw_label_layout_get_line_index(const lv_draw_label_layout_t * layout, uint32_t byte_id)
+{
+    if(layout->line_cnt == 0) return 0;
+
+    /*Binary search the last line starting before `byte_id`*/
+    uint32_t min = 0;
+    uint32_t max = layout->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(layout->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res)
+{
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    uint32_t text_len = layout->lines[layout->line_cnt].start;
+
+    size_res->x = layout->width;
+    size_res->y = (int32_t)layout->line_cnt * (letter_height + line_space);
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(text_len != 0 && (layout->text[text_len - 1] == '\n' || layout->text[text_len - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    if(size_res->y == 0) size_res->y = letter_height;
+    else size_res->y -= line_space;
+}
+
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout)
+{
+    lv_free(layout->lines);
+    lv_memzero(layout, sizeof(lv_draw_label_layout_t));
+}
+
 void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_label_dsc_t * dsc,
                                       const lv_area_t * coords,
                                       lv_draw_glyph_cb_t cb)
@@ -162,10 +388,20 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
+    /*Use the lines calculated earlier if they are still valid*/
+    const lv_draw_label_layout_t * layout = dsc->layout;
+    if(layout && !lv_draw_label_layout_is_valid(layout, dsc->text, font, dsc->letter_space, lv_area_get_width(coords),
+                                                dsc->flag)) {
+        layout = NULL;
+    }
+
     if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(layout) {
+        w = layout->width;
+    }
     else {
         /*If EXPAND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -189,10 +425,11 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_idx       = 0;
     int32_t last_line_start = -1;
 
-    /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    /*Check the hint to use the cached info. Not required if all lines are known.*/
+    if(dsc->hint && layout == NULL && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -206,14 +443,14 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                           dsc->flag);
+    uint32_t line_end = line_start + get_line_length(dsc, layout, line_idx, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end += get_line_length(dsc, layout, line_idx, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -228,14 +465,14 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -346,20 +583,19 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end += get_line_length(dsc, layout, line_idx, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -378,6 +614,27 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
  *   STATIC FUNCTIONS
  **********************/
 
+static inline uint32_t get_line_length(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                       uint32_t line_idx, uint32_t line_start, int32_t w)
+{
+    if(layout) {
+        if(line_idx >= layout->line_cnt) return 0;
+        return layout->lines[line_idx + 1].start - layout->lines[line_idx].start;
+    }
+
+    return lv_text_get_next_line(&dsc->text[line_start], dsc->font, dsc->letter_space, w, NULL, dsc->flag);
+}
+
+static inline int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                     uint32_t line_idx, uint32_t line_start, uint32_t line_end)
+{
+    if(layout) {
+        return line_idx < layout->line_cnt ? layout->lines[line_idx].width : 0;
+    }
+
+    return lv_text_get_width(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space);
+}
+
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb)
 {
@@ -444,3 +701,18 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
 
     LV_PROFILER_END;
 }
+
+/**
+ * Hash the characters of a text to notice if they were changed without changing the pointer
+ * @param text      pointer to a '\0' terminated text
+ * @return          FNV-1a hash of the text
+ */
+static uint32_t get_text_hash(const char * text)
+{
+    uint32_t hash = 2166136261u;
+    while(*text != '\0') {
+        hash = (hash ^ (uint8_t)*text) * 16777619u;
+        text++;
+    }
+    return hash;
+}
@@ -54,6 +54,10 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+    /**
+     * Line breaks and line widths calculated earlier for `text`.
+     * Ignored if it was created for different parameters. */
+    const lv_draw_label_layout_t * layout;
 } lv_draw_label_dsc_t;
 
 /**
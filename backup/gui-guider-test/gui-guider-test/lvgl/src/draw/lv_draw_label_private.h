@@ -41,6 +41,38 @@ struct lv_draw_label_hint_t {
     int32_t coord_y;
 };
 
+typedef struct {
+    uint32_t start;     /**< Byte index of the first character of the line*/
+    int32_t width;      /**< Width of the line in px*/
+} lv_draw_label_layout_line_t;
+
+/** Store the line breaks and the widths of the lines of a text
+ * so they don't need to be recalculated on every draw and size calculation.
+ * It's valid only for the text, font, letter space, max. width and flags it was created with.*/
+struct lv_draw_label_layout_t {
+    const char * text;
+    uint32_t text_hash;     /**< Hash of the characters if `check_text` is set*/
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_w;
+    lv_text_flag_t flag;
+
+    /** `line_cnt + 1` elements. The `start` of the last one is the length of the text.*/
+    lv_draw_label_layout_line_t * lines;
+    uint32_t line_cnt;
+    uint32_t line_cap;
+
+    /** Width of the longest line*/
+    int32_t width;
+
+    /** 0: needs to be recalculated, e.g. because the characters of the text were modified*/
+    uint8_t valid : 1;
+
+    /** 1: the characters might be changed in place (e.g. in static texts), so compare them too.
+     * Set it before `lv_draw_label_layout_update` and invalidate the layout when it changes.*/
+    uint8_t check_text : 1;
+};
+
 struct lv_draw_glyph_dsc_t {
     void * glyph_data;  /**< Depends on `format` field, it could be image source or draw buf of bitmap or vector data. */
     lv_font_glyph_format_t format;
@@ -57,6 +89,67 @@ struct lv_draw_glyph_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Break a text into lines and measure the lines if the layout was created with different parameters.
+ * @param layout        pointer to a layout. Zero it before the first use.
+ * @param text          the text
+ * @param font          the font of the text
+ * @param letter_space  letter space
+ * @param max_w         max width of the lines
+ * @param flag          settings for the text from `lv_text_flag_t`
+ * @return              true: the layout is valid; false: out of memory
+ */
+bool lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_w, lv_text_flag_t flag);
+
+/**
+ * Check if a layout was created with the given parameters and the characters of the text are unchanged
+ * @param layout        pointer to a layout
+ * @param text          the text
+ * @param font          the font of the text
+ * @param letter_space  letter space
+ * @param max_w         max width of the lines
+ * @param flag          settings for the text from `lv_text_flag_t`
+ * @return              true: the layout can be used instead of recalculating the lines
+ */
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_w, lv_text_flag_t flag);
+
+/**
+ * Update a valid layout after `del_len` bytes were replaced by `ins_len` bytes at `byte_pos`.
+ * Only the lines around the modification are recalculated, the others are shifted.
+ * @param layout        pointer to a layout
+ * @param text          the modified text. Can be a different pointer than before (e.g. reallocated).
+ * @param byte_pos      byte index of the modification
+ * @param del_len       number of removed bytes
+ * @param ins_len       number of inserted bytes
+ * @return              true: the layout is valid; false: the layout was invalid or out of memory
+ */
+bool lv_draw_label_layout_update_range(lv_draw_label_layout_t * layout, const char * text, uint32_t byte_pos,
+                                       uint32_t del_len, uint32_t ins_len);
+
+/**
+ * Get the index of the line containing a byte
+ * @param layout        pointer to a valid layout
+ * @param byte_id       byte index in the text
+ * @return              index of the line, the last line if `byte_id` is beyond the text
+ */
+uint32_t lv_draw_label_layout_get_line_index(const lv_draw_label_layout_t * layout, uint32_t byte_id);
+
+/**
+ * Get the size of the text the same way as `lv_text_get_size`
+ * @param layout        pointer to a valid layout
+ * @param line_space    line space
+ * @param size_res      store the result here
+ */
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res);
+
+/**
+ * Free the memory allocated by a layout
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout);
+
 /**********************
  *      MACROS
  **********************/
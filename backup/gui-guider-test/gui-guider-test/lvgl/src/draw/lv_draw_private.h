@@ -171,7 +171,7 @@ struct lv_draw_unit_t {
 typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t unit_cnt;
-    uint32_t used_memory_for_layers_kb;
+    uint32_t used_memory_for_layers_kb;     /**< Memory of the layer buffers in use and kept for reuse*/
 #if LV_USE_OS
     lv_thread_sync_t sync;
 #else
@@ -179,12 +179,61 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+#if LV_USE_DRAW_OCCLUSION_CULL
+    uint32_t culled_px_cnt;
+    uint32_t culled_task_cnt;
+#endif
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    lv_draw_buf_t * layer_bufs[LV_DRAW_LAYER_BUF_REUSE_CNT];   /**< Buffers of the drawn layers kept for reuse*/
+    uint32_t layer_simple_buf_size;                             /**< Current chunk size of the simple layers*/
+    uint32_t layer_simple_buf_update_time;                      /**< Tick of the last chunk size update*/
+    bool layer_simple_buf_dirty;                                /**< Update the chunk size after the refresh*/
+#endif
 } lv_draw_global_info_t;
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_DRAW_OCCLUSION_CULL
+
+/**
+ * Keep the new draw tasks of a layer queued until `lv_draw_occlusion_cull()` is called
+ * @param layer     pointer to a layer
+ */
+void lv_draw_occlusion_begin(lv_layer_t * layer);
+
+/**
+ * Skip or clip the queued draw tasks of a layer which are covered by later opaque fills or images,
+ * and let the draw units take the draw tasks
+ * @param layer     pointer to a layer
+ */
+void lv_draw_occlusion_cull(lv_layer_t * layer);
+
+#endif /*LV_USE_DRAW_OCCLUSION_CULL*/
+
+/**
+ * Get the size of the buffer to use for a chunk of a simple layer
+ * @return          the size in bytes
+ */
+uint32_t lv_draw_layer_get_simple_buf_size(void);
+
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+
+/**
+ * Adjust the chunk size of the simple layers to the free memory where the layers are allocated.
+ * Called after each refresh, but checks the memory only if a layer buffer couldn't be allocated,
+ * the kept buffers were released or once in a while.
+ */
+void lv_draw_layer_update_simple_buf_size(void);
+
+/**
+ * Free the kept layer buffers
+ */
+void lv_draw_layer_release_bufs(void);
+
+#endif /*LV_USE_DRAW_LAYER_BUF_REUSE*/
+
 /**********************
  *      MACROS
  **********************/
@@ -12,6 +12,13 @@
 #include "../misc/lv_ll.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
+#include "../tick/lv_tick.h"
+#if LV_USE_IMAGE_DECODER_ASYNC
+    #include "../core/lv_obj.h"
+    #include "../display/lv_display.h"
+    #include "../misc/lv_timer.h"
+    #include "../osal/lv_os.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -21,10 +28,47 @@
 #define img_header_cache_p (LV_GLOBAL_DEFAULT()->img_header_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+#define img_decoder_async_p (LV_GLOBAL_DEFAULT()->img_decoder_async)
+#define ASYNC_TARGET_MAX    4   /**< Max number of widgets to invalidate per image*/
+#define ASYNC_DONE_MAX      8   /**< Remember the last decoded images to detect if they don't fit into the cache*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+typedef enum {
+    ASYNC_JOB_STATE_WAITING,
+    ASYNC_JOB_STATE_DECODING,
+    ASYNC_JOB_STATE_READY,      /**< Decoded and added to the cache*/
+    ASYNC_JOB_STATE_DONE,       /**< Decoded and the widgets are invalidated*/
+    ASYNC_JOB_STATE_SYNC,       /**< Couldn't be cached, so decode it while rendering*/
+} async_job_state_t;
+
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    async_job_state_t state;
+    lv_obj_t * targets[ASYNC_TARGET_MAX];  /**< The widgets to invalidate when the image is decoded*/
+    uint8_t target_cnt;
+    uint8_t target_overflow : 1;            /**< More widgets wait for the image, invalidate the screens*/
+} async_job_t;
+
+typedef struct lv_image_decoder_async_t {
+    lv_ll_t job_ll;
+    lv_timer_t * timer;         /**< Invalidates the widgets of the decoded images (and decodes them without OS)*/
+    uint32_t pending_cnt;       /**< Number of the waiting and decoding jobs*/
+#if LV_USE_OS
+    lv_mutex_t mutex;
+    lv_thread_sync_t sync;
+    lv_thread_t threads[LV_IMAGE_DECODER_ASYNC_THREAD_CNT];
+    bool exit_status;
+#endif
+} lv_image_decoder_async_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -39,8 +83,36 @@ static uint32_t img_width_to_stride(lv_image_header_t * header);
  */
 static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
 
+/**
+ * Ask the decoders one by one to read the header of an image source.
+ * @param dsc       Image descriptor containing the source and type of the image.
+ * @param header    The header of the image
+ * @return The first decoder that can open the image source or NULL if not found.
+ */
+static lv_image_decoder_t * image_decoder_search(lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
+
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc);
 
+#if LV_USE_IMAGE_CACHE_NATIVE
+    static lv_draw_buf_t * convert_to_native(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+    static void async_init(void);
+    static void async_deinit(void);
+    static lv_result_t async_request(const void * src, const lv_image_header_t * header, lv_obj_t * obj, bool add_target);
+    static async_job_t * async_job_find(const void * src, lv_image_src_t src_type);
+    static async_job_t * async_job_get_waiting(void);
+    static void async_job_delete(async_job_t * job);
+    static void async_decode(async_job_t * job);
+    static void async_timer_cb(lv_timer_t * t);
+    static inline void async_lock(void);
+    static inline void async_unlock(void);
+    #if LV_USE_OS
+        static void async_thread_cb(void * user_data);
+    #endif
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -63,6 +135,14 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
     /*Initialize the cache*/
     lv_image_cache_init(image_cache_size);
     lv_image_header_cache_init(image_header_count);
+
+#if LV_USE_IMAGE_HEADER_INDEX
+    lv_image_header_index_init();
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+    async_init();
+#endif
 }
 
 /**
@@ -70,9 +150,29 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
+#if LV_USE_IMAGE_DECODER_ASYNC
+    async_deinit();
+#endif
+
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
+#if LV_USE_IMAGE_CACHE_COST
+    lv_image_cache_stats_deinit();
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+    lv_image_cache_native_deinit();
+#endif
+
+#if LV_USE_IMAGE_HEADER_INDEX
+    lv_image_header_index_deinit();
+#endif
+
+#if LV_BIN_DECODER_ROW_GROUPS
+    lv_bin_decoder_row_group_deinit();
+#endif
+
     lv_ll_clear(img_decoder_ll_p);
 }
 
@@ -104,7 +204,12 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
             /*
             * Check the cache first
             * If the image is found in the cache, just return it.*/
-            if(try_cache(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
+            if(try_cache(dsc) == LV_RESULT_OK) {
+#if LV_USE_IMAGE_CACHE_COST
+                lv_image_cache_stats_add(src, true, 0);
+#endif
+                return LV_RESULT_OK;
+            }
         }
     }
 
@@ -126,8 +231,25 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
      * If decoder open failed, free the source and return error.
      * If decoder open succeed, add the image to cache if enabled.
      * */
+#if LV_USE_IMAGE_CACHE_COST
+    uint32_t t_start = lv_tick_get();
+#endif
+
     lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
 
+#if LV_USE_IMAGE_CACHE_COST
+    /*Remember how long the decoding took to evict the cheaper images first*/
+    if(res == LV_RESULT_OK) {
+        /*Only the cached images have statistics, the others are drawn directly*/
+        if(dsc->cache_entry) {
+            uint32_t time = lv_tick_elaps(t_start);
+            lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(dsc->cache_entry);
+            cached_data->slot.cost = LV_MAX(time, 1);
+            lv_image_cache_stats_add(src, false, time);
+        }
+    }
+#endif
+
     /* Flush the D-Cache if enabled and the image was successfully opened */
     if(dsc->args.flush_cache && res == LV_RESULT_OK && dsc->decoded != NULL) {
         lv_draw_buf_flush_cache(dsc->decoded, NULL);
@@ -241,6 +363,12 @@ lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_d
 {
     if(decoded == NULL) return NULL; /*No need to adjust*/
 
+#if LV_USE_IMAGE_CACHE_NATIVE
+    /*The converted image is already aligned and not premultiplied*/
+    lv_draw_buf_t * native = convert_to_native(dsc, decoded);
+    if(native != decoded) return native;
+#endif
+
     lv_image_decoder_args_t * args = &dsc->args;
     if(args->stride_align && decoded->header.cf != LV_COLOR_FORMAT_RGB565A8) {
         uint32_t stride_expect = lv_draw_buf_width_to_stride(decoded->header.w, decoded->header.cf);
@@ -286,6 +414,53 @@ lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_d
     return decoded;
 }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+lv_result_t lv_image_decoder_async_request(const void * src, const lv_image_header_t * header, lv_obj_t * obj)
+{
+    return async_request(src, header, obj, true);
+}
+
+void lv_image_decoder_async_prefetch(const void * src)
+{
+    lv_image_header_t header;
+    if(lv_image_decoder_get_info(src, &header) != LV_RESULT_OK) return;
+
+    async_request(src, &header, NULL, false);
+}
+
+void lv_image_decoder_async_drop(const void * src)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(async == NULL) return;
+
+    async_lock();
+    async_job_t * job_drop = src ? async_job_find(src, lv_image_src_get_type(src)) : NULL;
+    async_job_t * job = lv_ll_get_head(&async->job_ll);
+    while(job) {
+        async_job_t * job_next = lv_ll_get_next(&async->job_ll, job);
+        /*The jobs being decoded or waiting for invalidation are removed by the timer*/
+        if(job->state == ASYNC_JOB_STATE_DONE ||
+           (job->state == ASYNC_JOB_STATE_SYNC && job->target_cnt == 0 && !job->target_overflow)) {
+            if(src == NULL || job == job_drop) async_job_delete(job);
+        }
+        job = job_next;
+    }
+    async_unlock();
+}
+
+uint32_t lv_image_decoder_async_get_pending_count(void)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(async == NULL) return 0;
+
+    async_lock();
+    uint32_t cnt = async->pending_cnt;
+    async_unlock();
+
+    return cnt;
+}
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -326,6 +501,46 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
         }
     }
 
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*The index is kept in a file, so it's valid even after a restart*/
+    decoder = src_type == LV_IMAGE_SRC_FILE ? lv_image_header_index_get(src, header) : NULL;
+    if(decoder) {
+        LV_LOG_TRACE("Found decoder %s in header index", decoder->name);
+    }
+    else {
+        decoder = image_decoder_search(dsc, header);
+        if(decoder && src_type == LV_IMAGE_SRC_FILE) lv_image_header_index_add(src, header, decoder);
+    }
+#else
+    decoder = image_decoder_search(dsc, header);
+#endif
+
+    if(is_header_cache_enabled && src_type == LV_IMAGE_SRC_FILE && decoder) {
+        lv_cache_entry_t * entry;
+        lv_image_header_cache_data_t search_key;
+        search_key.src_type = src_type;
+        search_key.src = lv_strdup(src);
+        search_key.decoder = decoder;
+        search_key.header = *header;
+        entry = lv_cache_add(img_header_cache_p, &search_key, NULL);
+
+        if(entry == NULL) {
+            if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
+            return NULL;
+        }
+
+        lv_cache_release(img_header_cache_p, entry, NULL);
+    }
+
+    return decoder;
+}
+
+static lv_image_decoder_t * image_decoder_search(lv_image_decoder_dsc_t * dsc, lv_image_header_t * header)
+{
+    const void * src = dsc->src;
+    lv_image_src_t src_type = dsc->src_type;
+    lv_image_decoder_t * decoder;
+
     if(src_type == LV_IMAGE_SRC_FILE) {
         lv_fs_res_t fs_res = lv_fs_open(&dsc->file, src, LV_FS_MODE_RD);
         if(fs_res != LV_FS_RES_OK) {
@@ -363,23 +578,6 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
         lv_fs_close(&dsc->file);
     }
 
-    if(is_header_cache_enabled && src_type == LV_IMAGE_SRC_FILE && decoder) {
-        lv_cache_entry_t * entry;
-        lv_image_header_cache_data_t search_key;
-        search_key.src_type = src_type;
-        search_key.src = lv_strdup(src);
-        search_key.decoder = decoder;
-        search_key.header = *header;
-        entry = lv_cache_add(img_header_cache_p, &search_key, NULL);
-
-        if(entry == NULL) {
-            if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
-            return NULL;
-        }
-
-        lv_cache_release(img_header_cache_p, entry, NULL);
-    }
-
     return decoder;
 }
 
@@ -413,3 +611,401 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
 
     return LV_RESULT_INVALID;
 }
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+
+/**
+ * Convert an RGB888, XRGB8888 or ARGB8888 image to be cached to RGB565, or to RGB565A8 if it has transparent pixels.
+ * This way drawing it on an RGB565 display is a plain copy instead of converting the pixels every time.
+ * @param dsc       the decoder descriptor
+ * @param decoded   the decoded image
+ * @return          the converted image or `decoded` if it's not converted
+ */
+static lv_draw_buf_t * convert_to_native(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded)
+{
+#if LV_COLOR_DEPTH == 16
+    lv_color_format_t cf = decoded->header.cf;
+    if(cf != LV_COLOR_FORMAT_RGB888 && cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_ARGB8888) return decoded;
+
+    /*Convert only the cached images, and leave the premultiplied images to the draw units requiring them*/
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) return decoded;
+    if(dsc->args.premultiply || lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_PREMULTIPLIED)) return decoded;
+
+    lv_image_cache_native_t policy = lv_image_cache_get_native(dsc->src);
+    if(policy == LV_IMAGE_CACHE_NATIVE_NEVER) return decoded;
+
+    /*Draw buffers used as source (e.g. of a canvas or a snapshot) can change any time,
+     *so a converted copy would become outdated*/
+    if((const void *)decoded == dsc->src || lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_MODIFIABLE)) return decoded;
+
+    /*Not allocated buffers are variables which are drawn directly without caching them*/
+    if(policy == LV_IMAGE_CACHE_NATIVE_AUTO && !lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) return decoded;
+
+    uint32_t w = decoded->header.w;
+    uint32_t h = decoded->header.h;
+    uint32_t stride = decoded->header.stride;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t x;
+    uint32_t y;
+
+    bool opaque = true;
+    if(cf == LV_COLOR_FORMAT_ARGB8888) {
+        for(y = 0; y < h && opaque; y++) {
+            const uint8_t * src = decoded->data + y * stride;
+            for(x = 0; x < w; x++) {
+                if(src[x * 4 + 3] != 0xff) {
+                    opaque = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    /*The alpha plane of RGB565A8 is addressed with the half of the stride, so it's not aligned*/
+    lv_color_format_t native_cf = opaque ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_RGB565A8;
+    uint32_t native_stride = opaque ? lv_draw_buf_width_to_stride(w, native_cf) : w * 2;
+    lv_draw_buf_t * native = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, w, h, native_cf, native_stride);
+    if(native == NULL) {
+        LV_LOG_WARN("No memory to convert the image to the native color format.");
+        return decoded;
+    }
+
+    uint8_t * alpha = opaque ? NULL : native->data + native_stride * h;
+    for(y = 0; y < h; y++) {
+        const uint8_t * src = decoded->data + y * stride;
+        uint16_t * dest = (uint16_t *)(native->data + y * native_stride);
+        for(x = 0; x < w; x++) {
+            dest[x] = lv_color_to_u16(lv_color_make(src[2], src[1], src[0]));
+            if(alpha) alpha[x] = src[3];
+            src += px_size;
+        }
+        if(alpha) alpha += w;
+    }
+
+    return native;
+#else
+    LV_UNUSED(dsc);
+    return decoded;
+#endif
+}
+
+#endif /*LV_USE_IMAGE_CACHE_NATIVE*/
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+static void async_init(void)
+{
+    lv_image_decoder_async_t * async = lv_malloc_zeroed(sizeof(lv_image_decoder_async_t));
+    LV_ASSERT_MALLOC(async);
+    if(async == NULL) return;
+
+    lv_ll_init(&async->job_ll, sizeof(async_job_t));
+    async->timer = lv_timer_create(async_timer_cb, LV_DEF_REFR_PERIOD, async);
+    lv_timer_pause(async->timer);
+
+#if LV_USE_OS
+    lv_mutex_init(&async->mutex);
+    lv_thread_sync_init(&async->sync);
+    uint32_t i;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        lv_thread_init(&async->threads[i], LV_THREAD_PRIO_LOW, async_thread_cb, LV_DRAW_THREAD_STACK_SIZE, async);
+    }
+#endif
+
+    img_decoder_async_p = async;
+}
+
+static void async_deinit(void)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(async == NULL) return;
+
+#if LV_USE_OS
+    /*The threads finish the image being decoded and exit*/
+    lv_mutex_lock(&async->mutex);
+    async->exit_status = true;
+    lv_mutex_unlock(&async->mutex);
+    lv_thread_sync_signal(&async->sync);
+
+    uint32_t i;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        lv_thread_delete(&async->threads[i]);
+    }
+
+    lv_thread_sync_delete(&async->sync);
+    lv_mutex_delete(&async->mutex);
+#endif
+
+    async_job_t * job = lv_ll_get_head(&async->job_ll);
+    while(job) {
+        async_job_t * job_next = lv_ll_get_next(&async->job_ll, job);
+        async_job_delete(job);
+        job = job_next;
+    }
+
+    lv_timer_delete(async->timer);
+    lv_free(async);
+    img_decoder_async_p = NULL;
+}
+
+/**
+ * Add a job to decode an image if it's not decoded yet
+ * @param src           the image source
+ * @param header        header of the image
+ * @param obj           the widget to invalidate when the image is decoded
+ * @param add_target    false: don't invalidate anything when the image is decoded
+ * @return              LV_RESULT_OK: the image can be drawn now; LV_RESULT_INVALID: it's being decoded
+ */
+static lv_result_t async_request(const void * src, const lv_image_header_t * header, lv_obj_t * obj, bool add_target)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(async == NULL || !lv_image_cache_is_enabled()) return LV_RESULT_OK;
+
+    /*Only files and compressed or encoded (e.g. PNG) variables are worth decoding in the background*/
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if(src_type == LV_IMAGE_SRC_VARIABLE) {
+        if(!(header->flags & LV_IMAGE_FLAGS_COMPRESSED) &&
+           header->cf != LV_COLOR_FORMAT_RAW && header->cf != LV_COLOR_FORMAT_RAW_ALPHA) {
+            return LV_RESULT_OK;
+        }
+    }
+    else if(src_type != LV_IMAGE_SRC_FILE) {
+        return LV_RESULT_OK;
+    }
+
+    async_lock();
+
+    async_job_t * job = async_job_find(src, src_type);
+    if(job == NULL) {
+        /*Already decoded*/
+        lv_image_cache_data_t search_key;
+        search_key.src_type = src_type;
+        search_key.src = src;
+        lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+        if(entry) {
+            lv_cache_release(img_cache_p, entry, NULL);
+            async_unlock();
+            return LV_RESULT_OK;
+        }
+
+        job = lv_ll_ins_tail(&async->job_ll);
+        LV_ASSERT_MALLOC(job);
+        if(job == NULL) {
+            async_unlock();
+            return LV_RESULT_OK;
+        }
+
+        lv_memzero(job, sizeof(async_job_t));
+        job->src_type = src_type;
+        job->src = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+        job->state = ASYNC_JOB_STATE_WAITING;
+        async->pending_cnt++;
+
+#if LV_USE_OS
+        lv_thread_sync_signal(&async->sync);
+#endif
+        lv_timer_resume(async->timer);
+    }
+
+    lv_result_t res = LV_RESULT_INVALID;
+    if(job->state == ASYNC_JOB_STATE_DONE) {
+        /*If a recently decoded image is not in the cache anymore, the visible images don't fit into the cache.
+         *Decode it while rendering from now on, else it would be decoded and dropped again and again.*/
+        lv_image_cache_data_t search_key;
+        search_key.src_type = src_type;
+        search_key.src = src;
+        lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+        if(entry) lv_cache_release(img_cache_p, entry, NULL);
+        else job->state = ASYNC_JOB_STATE_SYNC;
+        res = LV_RESULT_OK;
+    }
+    else if(job->state == ASYNC_JOB_STATE_READY || job->state == ASYNC_JOB_STATE_SYNC) {
+        res = LV_RESULT_OK;
+    }
+    else if(!add_target) {
+        /*Prefetched, nothing to redraw*/
+    }
+    else if(obj) {
+        uint32_t i;
+        for(i = 0; i < job->target_cnt; i++) {
+            if(job->targets[i] == obj) break;
+        }
+
+        if(i == job->target_cnt) {
+            if(job->target_cnt < ASYNC_TARGET_MAX) job->targets[job->target_cnt++] = obj;
+            else job->target_overflow = 1;
+        }
+    }
+    else {
+        job->target_overflow = 1;
+    }
+
+    async_unlock();
+
+    return res;
+}
+
+static async_job_t * async_job_find(const void * src, lv_image_src_t src_type)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    async_job_t * job;
+    LV_LL_READ(&async->job_ll, job) {
+        if(job->src_type != src_type) continue;
+        if(src_type == LV_IMAGE_SRC_FILE) {
+            if(lv_strcmp(job->src, src) == 0) return job;
+        }
+        else if(job->src == src) {
+            return job;
+        }
+    }
+
+    return NULL;
+}
+
+static async_job_t * async_job_get_waiting(void)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    async_job_t * job;
+    LV_LL_READ(&async->job_ll, job) {
+        if(job->state == ASYNC_JOB_STATE_WAITING) return job;
+    }
+
+    return NULL;
+}
+
+static void async_job_delete(async_job_t * job)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+    if(job->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)job->src);
+    lv_ll_remove(&async->job_ll, job);
+    lv_free(job);
+}
+
+/**
+ * Decode an image into the cache. Called without holding the lock.
+ * @param job       the job in `ASYNC_JOB_STATE_DECODING` state
+ */
+static void async_decode(async_job_t * job)
+{
+    lv_image_decoder_async_t * async = img_decoder_async_p;
+
+    /*Open and close it as drawing would do. The decoded image remains in the cache.*/
+    lv_image_decoder_dsc_t dsc;
+    lv_result_t res = lv_image_decoder_open(&dsc, job->src, NULL);
+    bool cached = res == LV_RESULT_OK && dsc.cache_entry != NULL;
+    if(res == LV_RESULT_OK) lv_image_decoder_close(&dsc);
+
+    async_lock();
+    job->state = cached ? ASYNC_JOB_STATE_READY : ASYNC_JOB_STATE_SYNC;
+    async->pending_cnt--;
+    async_unlock();
+}
+
+static void async_timer_cb(lv_timer_t * t)
+{
+    lv_image_decoder_async_t * async = lv_timer_get_user_data(t);
+
+#if LV_USE_OS == LV_OS_NONE
+    /*Decode only one image per call to let the other timers and the rendering run in between*/
+    async_job_t * job_waiting = async_job_get_waiting();
+    if(job_waiting) {
+        job_waiting->state = ASYNC_JOB_STATE_DECODING;
+        async_decode(job_waiting);
+    }
+#endif
+
+    /*Redraw the widgets of the decoded images*/
+    bool inv_screens = false;
+    uint32_t done_cnt = 0;
+    async_lock();
+    async_job_t * job = lv_ll_get_tail(&async->job_ll);
+    while(job) {
+        async_job_t * job_prev = lv_ll_get_prev(&async->job_ll, job);
+        if(job->state == ASYNC_JOB_STATE_DONE) {
+            /*Forget the oldest decoded images*/
+            done_cnt++;
+            if(done_cnt > ASYNC_DONE_MAX) async_job_delete(job);
+        }
+        job = job_prev;
+    }
+
+    job = lv_ll_get_head(&async->job_ll);
+    while(job) {
+        async_job_t * job_next = lv_ll_get_next(&async->job_ll, job);
+        if(job->state == ASYNC_JOB_STATE_READY || job->state == ASYNC_JOB_STATE_SYNC) {
+            uint32_t i;
+            for(i = 0; i < job->target_cnt; i++) {
+                if(lv_obj_is_valid(job->targets[i])) lv_obj_invalidate(job->targets[i]);
+            }
+            if(job->target_overflow) inv_screens = true;
+
+            /*Keep the not cached images to not decode them in the background again*/
+            if(job->state == ASYNC_JOB_STATE_READY) {
+                /*Move it to the end to keep the jobs in the order of decoding*/
+                job->state = ASYNC_JOB_STATE_DONE;
+                lv_ll_move_before(&async->job_ll, job, NULL);
+            }
+            job->target_cnt = 0;
+            job->target_overflow = 0;
+        }
+        job = job_next;
+    }
+
+    if(async->pending_cnt == 0) lv_timer_pause(t);
+    async_unlock();
+
+    if(inv_screens) {
+        lv_display_t * disp = lv_display_get_next(NULL);
+        while(disp) {
+            lv_obj_invalidate(lv_display_get_screen_active(disp));
+            disp = lv_display_get_next(disp);
+        }
+    }
+}
+
+static inline void async_lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&img_decoder_async_p->mutex);
+#endif
+}
+
+static inline void async_unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&img_decoder_async_p->mutex);
+#endif
+}
+
+#if LV_USE_OS
+static void async_thread_cb(void * user_data)
+{
+    lv_image_decoder_async_t * async = user_data;
+
+    while(1) {
+        lv_mutex_lock(&async->mutex);
+        bool exit_status = async->exit_status;
+        async_job_t * job = exit_status ? NULL : async_job_get_waiting();
+        if(job) job->state = ASYNC_JOB_STATE_DECODING;
+        bool more = job && async_job_get_waiting() != NULL;
+        lv_mutex_unlock(&async->mutex);
+
+        if(exit_status) break;
+
+        if(job == NULL) {
+            lv_thread_sync_wait(&async->sync);
+            continue;
+        }
+
+        /*Let an other thread take the next image*/
+        if(more) lv_thread_sync_signal(&async->sync);
+
+        async_decode(job);
+    }
+
+    /*Wake up the other threads to exit too*/
+    lv_thread_sync_signal(&async->sync);
+}
+#endif
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
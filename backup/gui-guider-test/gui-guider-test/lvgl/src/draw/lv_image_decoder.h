@@ -183,6 +183,14 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
  */
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Get the number of images which are waiting to be decoded or being decoded in the background
+ * @return          number of images
+ */
+uint32_t lv_image_decoder_async_get_pending_count(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
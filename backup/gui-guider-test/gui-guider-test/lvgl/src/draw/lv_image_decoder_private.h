@@ -53,7 +53,11 @@ struct lv_image_decoder_t {
 };
 
 struct lv_image_cache_data_t {
+#if LV_USE_IMAGE_CACHE_COST
+    lv_cache_slot_size_cost_t slot;
+#else
     lv_cache_slot_size_t slot;
+#endif
 
     const void * src;
     lv_image_src_t src_type;
@@ -131,6 +135,94 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+#if LV_USE_IMAGE_CACHE_COST
+/**
+ * Count an opening of a cached image in its cache statistics.
+ * At most `LV_IMAGE_CACHE_STATS_CNT` sources are counted.
+ * @param src       the image source
+ * @param hit       true: opened from the cache; false: decoded
+ * @param time      time of decoding [ms]
+ */
+void lv_image_cache_stats_add(const void * src, bool hit, uint32_t time);
+
+/**
+ * Free the cache statistics. Called in `lv_image_decoder_deinit()`.
+ */
+void lv_image_cache_stats_deinit(void);
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+/**
+ * Free the native color format policies. Called in `lv_image_decoder_deinit()`.
+ */
+void lv_image_cache_native_deinit(void);
+#endif
+
+#if LV_USE_IMAGE_HEADER_INDEX
+/**
+ * Create the persistent image header index. The index file is loaded on first use.
+ */
+void lv_image_header_index_init(void);
+
+/**
+ * Free the image header index
+ */
+void lv_image_header_index_deinit(void);
+
+/**
+ * Get the header of an image file from the index if the file hasn't changed
+ * @param src       path of the image
+ * @param header    store the header here
+ * @return          the decoder which can open the image, or NULL if the image is not in the index
+ */
+lv_image_decoder_t * lv_image_header_index_get(const char * src, lv_image_header_t * header);
+
+/**
+ * Add the header of an image file to the index and append it to the index file
+ * @param src       path of the image
+ * @param header    the header of the image
+ * @param decoder   the decoder which can open the image
+ */
+void lv_image_header_index_add(const char * src, const lv_image_header_t * header, const lv_image_decoder_t * decoder);
+#endif
+
+#if LV_BIN_DECODER_ROW_GROUPS
+/**
+ * Drop the decompressed row groups of an image from the bin decoder's cache
+ * @param src       the image source or NULL for all images
+ */
+void lv_bin_decoder_row_group_drop(const void * src);
+
+/**
+ * Free the row group cache of the bin decoder. Called in `lv_image_decoder_deinit()`.
+ */
+void lv_bin_decoder_row_group_deinit(void);
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Check if an image can be drawn now. If it needs to be decoded, start decoding it in the background.
+ * @param src       the image source
+ * @param header    the header of the image
+ * @param obj       the widget drawing the image. It's invalidated when the image is decoded. Can be NULL.
+ * @return          LV_RESULT_OK: the image can be drawn; LV_RESULT_INVALID: it's being decoded, draw a placeholder
+ */
+lv_result_t lv_image_decoder_async_request(const void * src, const lv_image_header_t * header, lv_obj_t * obj);
+
+/**
+ * Start decoding an image in the background if it's not in the cache yet
+ * @param src       the image source
+ */
+void lv_image_decoder_async_prefetch(const void * src);
+
+/**
+ * Forget that an image couldn't be cached or was decoded recently, so it's decoded in the background again
+ * when it's drawn next time
+ * @param src       the image source or NULL for all images
+ */
+void lv_image_decoder_async_drop(const void * src);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -38,7 +38,8 @@ typedef enum lv_image_flags_t {
     /**
      * The image data is compressed, so decoder needs to decode image firstly.
      * If this flag is set, the whole image will be decompressed upon decode, and
-     * `get_area_cb` won't be necessary.
+     * `get_area_cb` won't be necessary, unless the image has a row group index and
+     * `LV_BIN_DECODER_ROW_GROUPS` is enabled.
      */
     LV_IMAGE_FLAGS_COMPRESSED       = 0x0008,
 
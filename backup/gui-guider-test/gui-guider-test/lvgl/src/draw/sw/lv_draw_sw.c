@@ -13,6 +13,7 @@
 #include "../../core/lv_refr.h"
 #include "../../display/lv_display_private.h"
 #include "../../stdlib/lv_string.h"
+#include "../../misc/lv_area_private.h"
 #include "../../core/lv_global.h"
 
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
@@ -541,6 +542,16 @@ static void execute_drawing(lv_draw_sw_unit_t * u)
             break;
     }
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_REGION_CNT && LV_MEM_REGION_SIM
+    /*Account writing the drawn area to the simulated cost of the layer's memory*/
+    lv_layer_t * target_layer = u->base_unit.target_layer;
+    lv_area_t sim_area;
+    if(target_layer->draw_buf && lv_area_intersect(&sim_area, &t->area, u->base_unit.clip_area)) {
+        lv_mem_region_sim_access(target_layer->draw_buf->data,
+                                 lv_area_get_size(&sim_area) * lv_color_format_get_size(target_layer->color_format));
+    }
+#endif
+
 #if LV_USE_PARALLEL_DRAW_DEBUG
     /*Layers manage it for themselves*/
     if(t->type != LV_DRAW_TASK_TYPE_LAYER) {
@@ -121,6 +121,12 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+    /*The cached glyphs are identified by the font's address which might be reused*/
+    lv_font_fmt_txt_glyph_cache_drop();
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    lv_font_fmt_txt_cmap_index_delete(font);
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -8,6 +8,7 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt_private.h"
 #include "../misc/lv_text_private.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
@@ -53,9 +54,15 @@ void lv_font_glyph_release_draw_data(lv_font_glyph_dsc_t * g_dsc)
 {
     const lv_font_t * font = g_dsc->resolved_font;
 
-    if(font != NULL && font->release_glyph) {
+    if(font == NULL) return;
+
+    if(font->release_glyph) {
         font->release_glyph(font, g_dsc);
     }
+    /*The built-in fonts are constant and don't set `release_glyph`, but might return cached bitmaps*/
+    else if(font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt) {
+        lv_font_release_glyph_fmt_txt(font, g_dsc);
+    }
 }
 
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
@@ -72,6 +79,7 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
     const lv_font_t * f = font_p;
 
     dsc_out->resolved_font = NULL;
+    dsc_out->entry = NULL;
 
     while(f) {
         bool found = f->get_glyph_dsc(f, dsc_out, letter, f->kerning == LV_FONT_KERNING_NONE ? 0 : letter_next);
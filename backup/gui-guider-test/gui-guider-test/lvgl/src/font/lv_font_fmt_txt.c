@@ -14,6 +14,8 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../draw/lv_draw_buf.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +24,12 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#define CACHE_NAME  "FONT_FMT_TXT_GLYPH"
+
+#define glyph_cache (LV_GLOBAL_DEFAULT()->font_fmt_txt_glyph_cache)
+#define cmap_index_head (LV_GLOBAL_DEFAULT()->font_fmt_txt_cmap_index_head)
+#define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,11 +38,47 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+typedef struct {
+    uint32_t unicode;       /**< 0: empty slot*/
+    uint32_t gid;
+} cmap_index_slot_t;
+
+struct lv_font_fmt_txt_cmap_index_t {
+    struct lv_font_fmt_txt_cmap_index_t * next;
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    cmap_index_slot_t * slots;
+    uint32_t mask;          /**< Number of slots - 1. The number of slots is a power of 2*/
+    uint8_t shift;          /**< Shift the multiplicative hash by this to get the slot index*/
+};
+#endif /*LV_USE_FONT_FMT_TXT_CMAP_INDEX*/
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    const lv_font_t * font;
+    uint32_t gid;
+
+    lv_draw_buf_t * draw_buf;
+} glyph_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t get_glyph_dsc_id_from_cmaps(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    static const lv_font_fmt_txt_cmap_index_t * cmap_index_find(const lv_font_fmt_txt_dsc_t * fdsc);
+    static void cmap_index_insert(lv_font_fmt_txt_cmap_index_t * index, uint32_t unicode, uint32_t gid);
+    static inline uint32_t cmap_index_hash(const lv_font_fmt_txt_cmap_index_t * index, uint32_t unicode);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static bool decode_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                         uint8_t * bitmap_out);
+static lv_draw_buf_t * glyph_cache_get_bitmap(lv_font_glyph_dsc_t * g_dsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc);
+static bool glyph_cache_create_cb(glyph_cache_data_t * node, void * user_data);
+static lv_cache_compare_res_t glyph_cache_compare_cb(const glyph_cache_data_t * lhs, const glyph_cache_data_t * rhs);
+static void glyph_cache_free_cb(glyph_cache_data_t * node, void * user_data);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
@@ -78,7 +122,6 @@ static const uint8_t opa2_table[4] = {0, 85, 170, 255};
 const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
 {
     const lv_font_t * font = g_dsc->resolved_font;
-    uint8_t * bitmap_out = draw_buf->data;
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
     uint32_t gid = g_dsc->gid.index;
@@ -89,6 +132,311 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
     if(gsize == 0) return NULL;
 
+    if(glyph_cache.cache && lv_cache_is_enabled(glyph_cache.cache)) {
+        lv_draw_buf_t * cached = glyph_cache_get_bitmap(g_dsc, gdsc);
+        if(cached) return cached;
+    }
+
+    if(!decode_glyph(fdsc, gdsc, draw_buf->data)) return NULL;
+
+    return draw_buf;
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                   uint32_t unicode_letter_next)
+{
+    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+        if(gid_next) {
+            kvalue = get_kern_value(font, gid, gid_next);
+        }
+    }
+
+    /*Put together a glyph dsc*/
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->format = (uint8_t)fdsc->bpp;
+    dsc_out->is_placeholder = false;
+    dsc_out->gid.index = gid;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+lv_result_t lv_font_fmt_txt_glyph_cache_init(uint32_t size)
+{
+    if(glyph_cache.cache != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    glyph_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(glyph_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+    });
+
+#if LV_USE_OS
+    lv_mutex_init(&glyph_cache.lock);
+#endif
+    lv_cache_set_name(glyph_cache.cache, CACHE_NAME);
+    return glyph_cache.cache != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_font_fmt_txt_glyph_cache_deinit(void)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_destroy(glyph_cache.cache, NULL);
+    glyph_cache.cache = NULL;
+#if LV_USE_OS
+    lv_mutex_delete(&glyph_cache.lock);
+#endif
+}
+
+void lv_font_fmt_txt_glyph_cache_resize(uint32_t new_size, bool evict_now)
+{
+    lv_cache_set_max_size(glyph_cache.cache, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(glyph_cache.cache, new_size, NULL);
+    }
+}
+
+void lv_font_fmt_txt_glyph_cache_drop(void)
+{
+    lv_cache_drop_all(glyph_cache.cache, NULL);
+}
+
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    lv_memzero(stats, sizeof(lv_font_fmt_txt_glyph_cache_stats_t));
+    if(glyph_cache.cache == NULL) return;
+
+#if LV_USE_OS
+    lv_mutex_lock(&glyph_cache.lock);
+#endif
+    stats->hit_cnt = glyph_cache.hit_cnt;
+    stats->miss_cnt = glyph_cache.miss_cnt;
+#if LV_USE_OS
+    lv_mutex_unlock(&glyph_cache.lock);
+#endif
+    stats->size = (uint32_t)lv_cache_get_size(glyph_cache.cache, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(glyph_cache.cache, NULL);
+}
+
+void lv_font_release_glyph_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_UNUSED(font);
+
+    if(g_dsc->entry == NULL) return;
+
+    lv_cache_release(glyph_cache.cache, g_dsc->entry, NULL);
+    g_dsc->entry = NULL;
+}
+
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+
+lv_result_t lv_font_fmt_txt_cmap_index_create(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(cmap_index_find(fdsc)) return LV_RESULT_OK;
+
+    /*Count the code points which can have a glyph*/
+    uint32_t cnt = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            cnt += cmap->range_length;
+        }
+        else {
+            cnt += cmap->list_length;
+        }
+    }
+
+    /*Keep the load factor below 75% to have short probe sequences*/
+    uint32_t slot_cnt = 4;
+    uint8_t shift = 30;
+    while(slot_cnt * 3 < cnt * 4) {
+        slot_cnt <<= 1;
+        shift--;
+    }
+
+    lv_font_fmt_txt_cmap_index_t * index = lv_malloc_zeroed(sizeof(lv_font_fmt_txt_cmap_index_t));
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) return LV_RESULT_INVALID;
+
+    index->slots = lv_malloc_zeroed(slot_cnt * sizeof(cmap_index_slot_t));
+    LV_ASSERT_MALLOC(index->slots);
+    if(index->slots == NULL) {
+        lv_free(index);
+        return LV_RESULT_INVALID;
+    }
+
+    index->fdsc = fdsc;
+    index->mask = slot_cnt - 1;
+    index->shift = shift;
+
+    /*Resolve every candidate with the regular search so the index gives exactly the same results.
+     *Code points not stored in the index have no glyph.*/
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t j;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            for(j = 0; j < cmap->range_length; j++) {
+                uint32_t unicode = cmap->range_start + j;
+                cmap_index_insert(index, unicode, get_glyph_dsc_id_from_cmaps(fdsc, unicode));
+            }
+        }
+        else {
+            for(j = 0; j < cmap->list_length; j++) {
+                uint32_t unicode = cmap->range_start + cmap->unicode_list[j];
+                cmap_index_insert(index, unicode, get_glyph_dsc_id_from_cmaps(fdsc, unicode));
+            }
+        }
+    }
+
+    index->next = cmap_index_head;
+    cmap_index_head = index;
+
+    return LV_RESULT_OK;
+}
+
+void lv_font_fmt_txt_cmap_index_delete(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    lv_font_fmt_txt_cmap_index_t ** prev_next = &cmap_index_head;
+    while(*prev_next) {
+        lv_font_fmt_txt_cmap_index_t * index = *prev_next;
+        if(index->fdsc == font->dsc) {
+            *prev_next = index->next;
+            lv_free(index->slots);
+            lv_free(index);
+            return;
+        }
+        prev_next = &index->next;
+    }
+}
+
+void lv_font_fmt_txt_cmap_index_deinit(void)
+{
+    while(cmap_index_head) {
+        lv_font_fmt_txt_cmap_index_t * index = cmap_index_head;
+        cmap_index_head = index->next;
+        lv_free(index->slots);
+        lv_free(index);
+    }
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_CMAP_INDEX*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_draw_buf_t * glyph_cache_get_bitmap(lv_font_glyph_dsc_t * g_dsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    glyph_cache_data_t search_key = {
+        .font = g_dsc->resolved_font,
+        .gid = g_dsc->gid.index,
+    };
+    /*The size of the slot needs to be known before the bitmap is created to make room for it*/
+    search_key.slot.size = lv_draw_buf_width_to_stride_ex(font_draw_buf_handlers, gdsc->box_w, LV_COLOR_FORMAT_A8) *
+                           gdsc->box_h;
+
+    /*Fails if the bitmap is larger than the whole cache or out of memory*/
+    bool created = false;
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(glyph_cache.cache, &search_key, &created);
+
+#if LV_USE_OS
+    lv_mutex_lock(&glyph_cache.lock);
+#endif
+    if(created) glyph_cache.miss_cnt++;
+    else if(entry) glyph_cache.hit_cnt++;
+#if LV_USE_OS
+    lv_mutex_unlock(&glyph_cache.lock);
+#endif
+
+    if(entry == NULL) return NULL;
+
+    g_dsc->entry = entry;
+    glyph_cache_data_t * cached = lv_cache_entry_get_data(entry);
+    return cached->draw_buf;
+}
+
+static bool glyph_cache_create_cb(glyph_cache_data_t * node, void * user_data)
+{
+    bool * created = user_data;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = node->font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[node->gid];
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(font_draw_buf_handlers, gdsc->box_w, gdsc->box_h,
+                                                    LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(decoded == NULL) return false;
+
+    if(!decode_glyph(fdsc, gdsc, decoded->data)) {
+        lv_draw_buf_destroy(decoded);
+        return false;
+    }
+
+    node->draw_buf = decoded;
+    *created = true;
+    return true;
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const glyph_cache_data_t * lhs, const glyph_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static void glyph_cache_free_cb(glyph_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_draw_buf_destroy(node->draw_buf);
+}
+
+static bool decode_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                         uint8_t * bitmap_out)
+{
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
         uint8_t * bitmap_out_tmp = bitmap_out;
@@ -146,7 +494,7 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
                 bitmap_out_tmp += stride;
             }
         }
-        return draw_buf;
+        return true;
     }
     /*Handle compressed bitmap*/
     else {
@@ -154,72 +502,39 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return draw_buf;
+        return true;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
-        return NULL;
+        return false;
 #endif
     }
-
-    /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
 }
 
-bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
-                                   uint32_t unicode_letter_next)
-{
-    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
-    bool is_tab = unicode_letter == '\t';
-    if(is_tab) {
-        unicode_letter = ' ';
-    }
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
-    if(!gid) return false;
 
-    int8_t kvalue = 0;
-    if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
-        }
-    }
 
-    /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
-
-    uint32_t adv_w = gdsc->adv_w;
-    if(is_tab) adv_w *= 2;
-
-    adv_w += kv;
-    adv_w  = (adv_w + (1 << 3)) >> 4;
+static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+{
+    if(letter == '\0') return 0;
 
-    dsc_out->adv_w = adv_w;
-    dsc_out->box_h = gdsc->box_h;
-    dsc_out->box_w = gdsc->box_w;
-    dsc_out->ofs_x = gdsc->ofs_x;
-    dsc_out->ofs_y = gdsc->ofs_y;
-    dsc_out->format = (uint8_t)fdsc->bpp;
-    dsc_out->is_placeholder = false;
-    dsc_out->gid.index = gid;
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
 
-    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    const lv_font_fmt_txt_cmap_index_t * index = cmap_index_find(fdsc);
+    if(index) {
+        uint32_t s = cmap_index_hash(index, letter);
+        while(index->slots[s].unicode != 0) {
+            if(index->slots[s].unicode == letter) return index->slots[s].gid;
+            s = (s + 1) & index->mask;
+        }
+        return 0;
+    }
+#endif
 
-    return true;
+    return get_glyph_dsc_id_from_cmaps(fdsc, letter);
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+static uint32_t get_glyph_dsc_id_from_cmaps(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
 {
-    if(letter == '\0') return 0;
-
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -263,6 +578,42 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+
+static const lv_font_fmt_txt_cmap_index_t * cmap_index_find(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    const lv_font_fmt_txt_cmap_index_t * index = cmap_index_head;
+    while(index) {
+        if(index->fdsc == fdsc) return index;
+        index = index->next;
+    }
+
+    return NULL;
+}
+
+static void cmap_index_insert(lv_font_fmt_txt_cmap_index_t * index, uint32_t unicode, uint32_t gid)
+{
+    /*0 is used to mark the empty slots. U+0000 has no glyph anyway.*/
+    if(gid == 0 || unicode == 0) return;
+
+    uint32_t s = cmap_index_hash(index, unicode);
+    while(index->slots[s].unicode != 0) {
+        if(index->slots[s].unicode == unicode) return;
+        s = (s + 1) & index->mask;
+    }
+
+    index->slots[s].unicode = unicode;
+    index->slots[s].gid = gid;
+}
+
+static inline uint32_t cmap_index_hash(const lv_font_fmt_txt_cmap_index_t * index, uint32_t unicode)
+{
+    /*Fibonacci hashing: the top bits of the product are well distributed even for consecutive code points*/
+    return ((unicode * 2654435761U) >> index->shift) & index->mask;
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_CMAP_INDEX*/
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -185,6 +185,14 @@ typedef struct {
     uint16_t bitmap_format  : 2;
 } lv_font_fmt_txt_dsc_t;
 
+/** Statistics of the glyph bitmap cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of bitmaps served from the cache*/
+    uint32_t miss_cnt;      /**< Number of bitmaps decoded because they were not cached*/
+    uint32_t size;          /**< Bytes used by the cached bitmaps*/
+    uint32_t max_size;      /**< Maximum size of the cache in bytes*/
+} lv_font_fmt_txt_glyph_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -209,6 +217,48 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Set the maximum size of the glyph bitmap cache.
+ * The cache stores the decompressed/expanded A8 bitmaps of the glyphs so they don't need to be decoded on every draw.
+ * @param new_size      the new maximum size in bytes. 0: disable the cache
+ * @param evict_now     true: evict the glyphs immediately to fit into the new size,
+ *                      false: evict them only when new glyphs are added
+ */
+void lv_font_fmt_txt_glyph_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop all glyphs from the glyph bitmap cache.
+ * Needs to be called before a font descriptor allocated at run time is freed or modified.
+ */
+void lv_font_fmt_txt_glyph_cache_drop(void);
+
+/**
+ * Get the statistics of the glyph bitmap cache.
+ * @param stats     store the result here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats);
+
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+
+/**
+ * Build a hash table from the character maps of a font to find the glyph of a letter in constant time
+ * instead of walking the character maps and binary searching the sparse ranges.
+ * Useful for fonts with thousands of glyphs, e.g. CJK fonts. It uses 11..22 bytes of RAM per glyph.
+ * @param font      pointer to a font of the built-in format
+ * @return          LV_RESULT_OK: the index is created or already exists, LV_RESULT_INVALID: out of memory
+ * @note            shouldn't be called while rendering
+ */
+lv_result_t lv_font_fmt_txt_cmap_index_create(const lv_font_t * font);
+
+/**
+ * Delete the index created by `lv_font_fmt_txt_cmap_index_create`.
+ * Needs to be called before a font descriptor allocated at run time is freed.
+ * @param font      pointer to a font of the built-in format
+ */
+void lv_font_fmt_txt_cmap_index_delete(const lv_font_t * font);
+
+#endif /*LV_USE_FONT_FMT_TXT_CMAP_INDEX*/
+
 /**********************
  *      MACROS
  **********************/
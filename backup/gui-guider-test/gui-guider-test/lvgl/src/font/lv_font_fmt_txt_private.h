@@ -15,6 +15,8 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../misc/cache/lv_cache.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -41,10 +43,50 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+/** Hash table mapping the code points of a font to glyph ids.
+ * The indexes of all fonts are chained into a list. */
+typedef struct lv_font_fmt_txt_cmap_index_t lv_font_fmt_txt_cmap_index_t;
+
+typedef struct {
+    lv_cache_t * cache;     /**< Size based LRU cache of the decoded A8 glyph bitmaps*/
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+#if LV_USE_OS
+    lv_mutex_t lock;        /**< Protects the counters as the glyphs can be drawn by several threads*/
+#endif
+} lv_font_fmt_txt_glyph_cache_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize the glyph bitmap cache of the built-in font format.
+ * @param size      the maximum size of the cache in bytes. 0: disable the cache
+ * @return          LV_RESULT_OK: the cache is created, LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_font_fmt_txt_glyph_cache_init(uint32_t size);
+
+/**
+ * Free all cached glyph bitmaps and delete the cache.
+ */
+void lv_font_fmt_txt_glyph_cache_deinit(void);
+
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+/**
+ * Delete the code point indexes of all fonts.
+ */
+void lv_font_fmt_txt_cmap_index_deinit(void);
+#endif
+
+/**
+ * Give back the cached bitmap acquired by `lv_font_get_bitmap_fmt_txt`.
+ * Called by `lv_font_glyph_release_draw_data` for the fonts of the built-in format.
+ * @param font      pointer to font
+ * @param g_dsc     the glyph descriptor whose `entry` was set by `lv_font_get_bitmap_fmt_txt`
+ */
+void lv_font_release_glyph_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc);
+
 /**********************
  *      MACROS
  **********************/
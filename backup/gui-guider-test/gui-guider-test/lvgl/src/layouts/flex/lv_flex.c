@@ -17,10 +17,20 @@
  *      DEFINES
  *********************/
 #define layout_list_def LV_GLOBAL_DEFAULT()->layout_list
+#define flex_items LV_GLOBAL_DEFAULT()->flex_items
+#define flex_item_cap LV_GLOBAL_DEFAULT()->flex_item_cap
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    int32_t margin_main_start;
+    int32_t margin_main_end;
+    int32_t margin_cross_start;
+    int32_t margin_cross_end;
+    uint8_t grow;
+} flex_item_t;
+
 typedef struct {
     lv_flex_align_t main_place;
     lv_flex_align_t cross_place;
@@ -28,6 +38,7 @@ typedef struct {
     uint8_t row : 1;
     uint8_t wrap : 1;
     uint8_t rev : 1;
+    flex_item_t * items;    /*Measured style properties of the items by child index or NULL*/
 } flex_t;
 
 typedef struct {
@@ -64,8 +75,10 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 static void place_content(lv_flex_align_t place, int32_t max_size, int32_t content_size, int32_t item_cnt,
                           int32_t * start_pos, int32_t * gap);
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
-static int32_t lv_obj_get_width_with_margin(const lv_obj_t * obj);
-static int32_t lv_obj_get_height_with_margin(const lv_obj_t * obj);
+static const flex_item_t * get_item_dsc(const flex_t * f, lv_obj_t * item, int32_t item_id, flex_item_t * buf);
+static void measure_item(const flex_t * f, lv_obj_t * item, flex_item_t * dsc);
+static int32_t get_main_size(const flex_t * f, const lv_obj_t * item, const flex_item_t * dsc);
+static int32_t get_cross_size(const flex_t * f, const lv_obj_t * item, const flex_item_t * dsc);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -136,6 +149,27 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     f.main_place = lv_obj_get_style_flex_main_place(cont, LV_PART_MAIN);
     f.cross_place = lv_obj_get_style_flex_cross_place(cont, LV_PART_MAIN);
     f.track_place = lv_obj_get_style_flex_track_place(cont, LV_PART_MAIN);
+    f.items = NULL;
+
+#if LV_USE_LAYOUT_INCREMENTAL
+    /*Measure the items once as they are visited several times while finding and placing the tracks.
+     *The buffer is reused by the next updates as the layout updates can't be nested.*/
+    uint32_t child_cnt = lv_obj_get_child_count(cont);
+    if(child_cnt > flex_item_cap) {
+        flex_item_t * new_items = lv_realloc(flex_items, sizeof(flex_item_t) * child_cnt);
+        if(new_items) {
+            flex_items = new_items;
+            flex_item_cap = child_cnt;
+        }
+    }
+    if(child_cnt && child_cnt <= flex_item_cap) f.items = flex_items;
+    if(f.items) {
+        uint32_t i;
+        for(i = 0; i < child_cnt; i++) {
+            measure_item(&f, cont->spec_attr->children[i], &f.items[i]);
+        }
+    }
+#endif
 
     bool rtl = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL;
     int32_t track_gap = !f.row ? lv_obj_get_style_pad_column(cont, LV_PART_MAIN) : lv_obj_get_style_pad_row(cont,
@@ -240,9 +274,8 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     if(f->wrap && ((f->row && w_set == LV_SIZE_CONTENT) || (!f->row && h_set == LV_SIZE_CONTENT))) {
         f->wrap = false;
     }
-    int32_t(*get_main_size)(const lv_obj_t *) = (f->row ? lv_obj_get_width_with_margin : lv_obj_get_height_with_margin);
-    int32_t(*get_cross_size)(const lv_obj_t *) = (!f->row ? lv_obj_get_width_with_margin :
-                                                  lv_obj_get_height_with_margin);
+    flex_item_t dsc_buf;
+    const flex_item_t * dsc;
 
     t->track_main_size = 0;
     t->track_fix_main_size = 0;
@@ -258,7 +291,8 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
         if(item_id != item_start_id && lv_obj_has_flag(item, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)) break;
 
         if(!lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
-            uint8_t grow_value = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
+            dsc = get_item_dsc(f, item, item_id, &dsc_buf);
+            uint8_t grow_value = dsc->grow;
             if(grow_value) {
                 t->grow_item_cnt++;
                 t->track_fix_main_size += item_gap;
@@ -278,12 +312,12 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                 }
             }
             else {
-                int32_t item_size = get_main_size(item);
+                int32_t item_size = get_main_size(f, item, dsc);
                 if(f->wrap && t->track_fix_main_size + item_size > max_main_size) break;
                 t->track_fix_main_size += item_size + item_gap;
             }
 
-            t->track_cross_size = LV_MAX(get_cross_size(item), t->track_cross_size);
+            t->track_cross_size = LV_MAX(get_cross_size(f, item, dsc), t->track_cross_size);
             t->item_cnt++;
         }
 
@@ -300,10 +334,11 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     /*Have at least one item in a row*/
     if(item && item_id == item_start_id) {
         item = cont->spec_attr->children[item_id];
+        dsc = get_item_dsc(f, item, item_id, &dsc_buf);
         get_next_item(cont, f->rev, &item_id);
         if(item) {
-            t->track_cross_size = get_cross_size(item);
-            t->track_main_size = get_main_size(item);
+            t->track_cross_size = get_cross_size(f, item, dsc);
+            t->track_main_size = get_main_size(f, item, dsc);
             t->item_cnt = 1;
         }
     }
@@ -320,12 +355,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     void (*area_set_main_size)(lv_area_t *, int32_t) = (f->row ? lv_area_set_width : lv_area_set_height);
     int32_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
     int32_t (*area_get_cross_size)(const lv_area_t *) = (!f->row ? lv_area_get_width : lv_area_get_height);
-
-    typedef int32_t (*margin_func_t)(const lv_obj_t *, uint32_t);
-    margin_func_t get_margin_main_start = (f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
-    margin_func_t get_margin_main_end = (f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
-    margin_func_t get_margin_cross_start = (!f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
-    margin_func_t get_margin_cross_end = (!f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
+    flex_item_t dsc_buf;
 
     /*Calculate the size of grow items first*/
     uint32_t i;
@@ -377,7 +407,8 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
             item = get_next_item(cont, f->rev, &item_first_id);
             continue;
         }
-        int32_t grow_size = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
+        const flex_item_t * dsc = get_item_dsc(f, item, item_first_id, &dsc_buf);
+        int32_t grow_size = dsc->grow;
         if(grow_size) {
             int32_t s = 0;
             for(i = 0; i < t->grow_item_cnt; i++) {
@@ -418,14 +449,14 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
                 /*Round up the cross size to avoid rounding error when dividing by 2
                  *The issue comes up e,g, with column direction with center cross direction if an element's width changes*/
                 cross_pos = (((t->track_cross_size + 1) & (~1)) - area_get_cross_size(&item->coords)) / 2;
-                cross_pos += (get_margin_cross_start(item, LV_PART_MAIN) - get_margin_cross_end(item, LV_PART_MAIN)) / 2;
+                cross_pos += (dsc->margin_cross_start - dsc->margin_cross_end) / 2;
                 break;
             case LV_FLEX_ALIGN_END:
                 cross_pos = t->track_cross_size - area_get_cross_size(&item->coords);
-                cross_pos -= get_margin_cross_end(item, LV_PART_MAIN);
+                cross_pos -= dsc->margin_cross_end;
                 break;
             default:
-                cross_pos += get_margin_cross_start(item, LV_PART_MAIN);
+                cross_pos += dsc->margin_cross_start;
                 break;
         }
 
@@ -441,8 +472,8 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
         int32_t diff_x = abs_x - item->coords.x1 + tr_x;
         int32_t diff_y = abs_y - item->coords.y1 + tr_y;
-        diff_x += f->row ? main_pos + get_margin_main_start(item, LV_PART_MAIN) : cross_pos;
-        diff_y += f->row ? cross_pos : main_pos + get_margin_main_start(item, LV_PART_MAIN);
+        diff_x += f->row ? main_pos + dsc->margin_main_start : cross_pos;
+        diff_y += f->row ? cross_pos : main_pos + dsc->margin_main_start;
 
         if(diff_x || diff_y) {
             lv_obj_invalidate(item);
@@ -455,8 +486,8 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
         }
 
         if(!(f->row && rtl)) main_pos += area_get_main_size(&item->coords) + item_gap + place_gap
-                                             + get_margin_main_start(item, LV_PART_MAIN)
-                                             + get_margin_main_end(item, LV_PART_MAIN);
+                                             + dsc->margin_main_start
+                                             + dsc->margin_main_end;
         else main_pos -= item_gap + place_gap;
 
         item = get_next_item(cont, f->rev, &item_first_id);
@@ -519,18 +550,46 @@ static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id)
     }
 }
 
-static int32_t lv_obj_get_width_with_margin(const lv_obj_t * obj)
+/**
+ * Get the measured style properties of an item
+ * @param f         the flex descriptor of the container
+ * @param item      pointer to an item
+ * @param item_id   index of `item` among the children of the container
+ * @param buf       measure here if the items are not measured in advance
+ * @return          the measured properties
+ */
+static const flex_item_t * get_item_dsc(const flex_t * f, lv_obj_t * item, int32_t item_id, flex_item_t * buf)
+{
+    if(f->items) return &f->items[item_id];
+
+    measure_item(f, item, buf);
+    return buf;
+}
+
+static void measure_item(const flex_t * f, lv_obj_t * item, flex_item_t * dsc)
+{
+    int32_t margin_left = lv_obj_get_style_margin_left(item, LV_PART_MAIN);
+    int32_t margin_right = lv_obj_get_style_margin_right(item, LV_PART_MAIN);
+    int32_t margin_top = lv_obj_get_style_margin_top(item, LV_PART_MAIN);
+    int32_t margin_bottom = lv_obj_get_style_margin_bottom(item, LV_PART_MAIN);
+
+    dsc->margin_main_start = f->row ? margin_left : margin_top;
+    dsc->margin_main_end = f->row ? margin_right : margin_bottom;
+    dsc->margin_cross_start = f->row ? margin_top : margin_left;
+    dsc->margin_cross_end = f->row ? margin_bottom : margin_right;
+    dsc->grow = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
+}
+
+static int32_t get_main_size(const flex_t * f, const lv_obj_t * item, const flex_item_t * dsc)
 {
-    return lv_obj_get_style_margin_left(obj, LV_PART_MAIN)
-           + lv_obj_get_width(obj)
-           + lv_obj_get_style_margin_right(obj, LV_PART_MAIN);
+    int32_t size = f->row ? lv_obj_get_width(item) : lv_obj_get_height(item);
+    return dsc->margin_main_start + size + dsc->margin_main_end;
 }
 
-static int32_t lv_obj_get_height_with_margin(const lv_obj_t * obj)
+static int32_t get_cross_size(const flex_t * f, const lv_obj_t * item, const flex_item_t * dsc)
 {
-    return lv_obj_get_style_margin_top(obj, LV_PART_MAIN)
-           + lv_obj_get_height(obj)
-           + lv_obj_get_style_margin_bottom(obj, LV_PART_MAIN);
+    int32_t size = f->row ? lv_obj_get_height(item) : lv_obj_get_width(item);
+    return dsc->margin_cross_start + size + dsc->margin_cross_end;
 }
 
 #endif /*LV_USE_FLEX*/
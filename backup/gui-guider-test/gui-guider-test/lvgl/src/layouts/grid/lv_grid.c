@@ -58,6 +58,10 @@ static void calc(lv_obj_t * obj, lv_grid_calc_t * calc);
 static void calc_free(lv_grid_calc_t * calc);
 static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c);
 static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c);
+#if LV_USE_LAYOUT_INCREMENTAL
+    static void calc_content_tracks(lv_obj_t * cont, const int32_t * templ, uint32_t track_num, int32_t * size_array,
+                                    bool row);
+#endif
 static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t * hint);
 static int32_t grid_align(int32_t cont_size, bool auto_size, lv_grid_align_t align, int32_t gap,
                           uint32_t track_num,
@@ -304,6 +308,9 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
 
     /*Set sizes for CONTENT cells*/
     uint32_t i;
+#if LV_USE_LAYOUT_INCREMENTAL
+    calc_content_tracks(cont, col_templ, c->col_num, c->w, false);
+#else
     for(i = 0; i < c->col_num; i++) {
         int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(col_templ[i])) {
@@ -324,6 +331,7 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
             else c->w[i] = 0;
         }
     }
+#endif
 
     uint32_t col_fr_cnt = 0;
     int32_t grid_w = 0;
@@ -393,6 +401,9 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     c->h = lv_malloc(sizeof(int32_t) * c->row_num);
     /*Set sizes for CONTENT cells*/
     uint32_t i;
+#if LV_USE_LAYOUT_INCREMENTAL
+    calc_content_tracks(cont, row_templ, c->row_num, c->h, true);
+#else
     for(i = 0; i < c->row_num; i++) {
         int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(row_templ[i])) {
@@ -413,6 +424,7 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
             else c->h[i] = 0;
         }
     }
+#endif
 
     uint32_t row_fr_cnt = 0;
     int32_t grid_h = 0;
@@ -454,6 +466,48 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     }
 }
 
+#if LV_USE_LAYOUT_INCREMENTAL
+/**
+ * Set the size of the CONTENT tracks from the size of their children.
+ * All the children are measured in one pass instead of scanning them for each track.
+ * @param cont          an object that has a grid
+ * @param templ         the row or column template
+ * @param track_num     number of tracks in `templ`
+ * @param size_array    write the size of the CONTENT tracks here
+ * @param row           true: measure the rows; false: measure the columns
+ */
+static void calc_content_tracks(lv_obj_t * cont, const int32_t * templ, uint32_t track_num, int32_t * size_array,
+                                bool row)
+{
+    uint32_t i;
+    bool has_content = false;
+    for(i = 0; i < track_num; i++) {
+        size_array[i] = LV_COORD_MIN;
+        if(IS_CONTENT(templ[i])) has_content = true;
+    }
+
+    if(!has_content) return;
+
+    uint32_t child_cnt = lv_obj_get_child_count(cont);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+        uint32_t span = row ? get_row_span(item) : get_col_span(item);
+        if(span != 1) continue;
+
+        uint32_t pos = row ? get_row_pos(item) : get_col_pos(item);
+        if(pos >= track_num || !IS_CONTENT(templ[pos])) continue;
+
+        int32_t size = row ? lv_obj_get_height(item) : lv_obj_get_width(item);
+        size_array[pos] = LV_MAX(size_array[pos], size);
+    }
+
+    for(i = 0; i < track_num; i++) {
+        if(IS_CONTENT(templ[i]) && size_array[i] < 0) size_array[i] = 0;
+    }
+}
+#endif
+
 /**
  * Reposition a grid item in its cell
  * @param item a grid item to reposition
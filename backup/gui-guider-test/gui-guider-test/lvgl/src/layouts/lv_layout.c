@@ -53,6 +53,11 @@ void lv_layout_init(void)
 void lv_layout_deinit(void)
 {
     lv_free(layout_list_def);
+#if LV_USE_FLEX && LV_USE_LAYOUT_INCREMENTAL
+    lv_free(LV_GLOBAL_DEFAULT()->flex_items);
+    LV_GLOBAL_DEFAULT()->flex_items = NULL;
+    LV_GLOBAL_DEFAULT()->flex_item_cap = 0;
+#endif
 }
 
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
@@ -30,6 +30,11 @@
 #define DECODER_NAME    "BIN"
 
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define row_group_cache_p (LV_GLOBAL_DEFAULT()->bin_decoder_row_group_cache)
+#define row_group_max (LV_GLOBAL_DEFAULT()->bin_decoder_row_group_max)
+
+/*Size of the compression header following the image header*/
+#define COMPRESSED_HEADER_SIZE  12
 
 /**********************
  *      TYPEDEFS
@@ -37,11 +42,16 @@
 
 /**
  * Data format for compressed image data.
+ *
+ * If `group_rows` is not 0, the image is split to groups of `group_rows` rows which are compressed
+ * one by one. The compressed data then starts with a `uint32_t` offset of each group and the end of
+ * the last group, relative to the end of this offset table, followed by the compressed groups.
  */
 
 typedef struct lv_image_compressed_t {
     uint32_t method: 4; /*Compression method, see `lv_image_compress_t`*/
-    uint32_t reserved : 28;  /*Reserved to be used later*/
+    uint32_t group_rows: 12; /*Number of rows compressed together, 0: the whole image is compressed at once*/
+    uint32_t reserved : 16;  /*Reserved to be used later*/
     uint32_t compressed_size;  /*Compressed data size in byte*/
     uint32_t decompressed_size;  /*Decompressed data size in byte*/
     const uint8_t * data; /*Compressed data*/
@@ -56,8 +66,21 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+#if LV_BIN_DECODER_ROW_GROUPS
+    uint32_t * group_offsets;           /*Offset of the compressed row groups, see `lv_image_compressed_t`*/
+    lv_cache_entry_t * group_entry;     /*The decompressed row group returned by get_area_cb*/
+#endif
 } decoder_data_t;
 
+#if LV_BIN_DECODER_ROW_GROUPS
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    uint32_t group;
+    lv_draw_buf_t * decoded;
+} row_group_cache_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -76,6 +99,20 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
 static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff, uint32_t btr, uint32_t * br);
 
 static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+static lv_result_t decompress_data(const lv_image_compressed_t * compressed, lv_color_format_t cf,
+                                   const uint8_t * input, uint32_t input_len, uint8_t * output, uint32_t out_len);
+
+#if LV_BIN_DECODER_ROW_GROUPS
+    static lv_result_t read_compressed_header(lv_image_decoder_dsc_t * dsc, lv_image_compressed_t * compressed);
+    static lv_result_t open_row_groups(lv_image_decoder_dsc_t * dsc);
+    static lv_result_t get_area_row_groups(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                           lv_area_t * decoded_area);
+    static void release_row_group(decoder_data_t * decoder_data);
+    static lv_cache_compare_res_t row_group_compare_cb(const row_group_cache_data_t * lhs,
+                                                       const row_group_cache_data_t * rhs);
+    static bool row_group_create_cb(row_group_cache_data_t * node, lv_image_decoder_dsc_t * dsc);
+    static void row_group_free_cb(row_group_cache_data_t * node, void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -402,6 +439,10 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
         return LV_RESULT_INVALID;
     }
 
+#if LV_BIN_DECODER_ROW_GROUPS
+    if(decoder_data->group_offsets) return get_area_row_groups(dsc, full_area, decoded_area);
+#endif
+
     lv_fs_file_t * f = decoder_data->f;
     uint32_t bpp = lv_color_format_get_bpp(cf);
     int32_t w_px = lv_area_get_width(full_area);
@@ -513,6 +554,39 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
     return LV_RESULT_INVALID;
 }
 
+#if LV_BIN_DECODER_ROW_GROUPS
+
+void lv_bin_decoder_row_group_drop(const void * src)
+{
+    if(row_group_cache_p == NULL) return;
+
+    if(src == NULL) {
+        lv_cache_drop_all(row_group_cache_p, NULL);
+        return;
+    }
+
+    /*The groups are cached one by one, so try all group indexes used so far*/
+    row_group_cache_data_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    for(search_key.group = 0; search_key.group <= row_group_max; search_key.group++) {
+        lv_cache_drop(row_group_cache_p, &search_key, NULL);
+    }
+}
+
+void lv_bin_decoder_row_group_deinit(void)
+{
+    if(row_group_cache_p == NULL) return;
+
+    lv_cache_destroy(row_group_cache_p, NULL);
+    row_group_cache_p = NULL;
+    row_group_max = 0;
+}
+
+#endif /*LV_BIN_DECODER_ROW_GROUPS*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -546,6 +620,10 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
 
     if(decoder_data->decoded) lv_draw_buf_destroy(decoder_data->decoded);
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
+#if LV_BIN_DECODER_ROW_GROUPS
+    release_row_group(decoder_data);
+    lv_free(decoder_data->group_offsets);
+#endif
     lv_free(decoder_data->palette);
     lv_free(decoder_data);
     dsc->user_data = NULL;
@@ -893,6 +971,14 @@ static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_deco
 
 static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
+#if LV_BIN_DECODER_ROW_GROUPS
+    /*Images with row groups are decompressed in get_area_cb*/
+    lv_image_compressed_t header;
+    if(read_compressed_header(dsc, &header) == LV_RESULT_OK && header.group_rows != 0) {
+        return open_row_groups(dsc);
+    }
+#endif
+
 #if LV_BIN_DECODER_RAM_LOAD
     uint32_t rn;
     uint32_t len;
@@ -915,10 +1001,10 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
         }
 
         compressed_len -= sizeof(lv_image_header_t);
-        compressed_len -= 12;
+        compressed_len -= COMPRESSED_HEADER_SIZE;
 
         /*Read compress header*/
-        len = 12;
+        len = COMPRESSED_HEADER_SIZE;
         fs_res = fs_read_file_at(f, sizeof(lv_image_header_t), compressed, len, &rn);
         if(fs_res != LV_FS_RES_OK || rn != len) {
             LV_LOG_WARN("Read compressed header failed: %d", fs_res);
@@ -953,7 +1039,7 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
         compressed_len = image->data_size;
 
         /*Read compress header*/
-        len = 12;
+        len = COMPRESSED_HEADER_SIZE;
         compressed_len -= len;
         lv_memcpy(compressed, image->data, len);
         compressed->data = image->data + len;
@@ -1105,53 +1191,341 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
 
     img_data = decompressed->data;
 
+    if(decompress_data(compressed, dsc->header.cf, compressed->data, input_len, img_data, out_len) != LV_RESULT_OK) {
+        lv_draw_buf_destroy(decompressed);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decompress a block of data which must have exactly `out_len` bytes when decompressed
+ */
+static lv_result_t decompress_data(const lv_image_compressed_t * compressed, lv_color_format_t cf,
+                                   const uint8_t * input, uint32_t input_len, uint8_t * output, uint32_t out_len)
+{
+    LV_UNUSED(cf);
+    LV_UNUSED(input);
+    LV_UNUSED(input_len);
+    LV_UNUSED(output);
+
     if(compressed->method == LV_IMAGE_COMPRESS_RLE) {
 #if LV_USE_RLE
         /*Compress always happen on byte*/
         uint32_t pixel_byte;
-        if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8)
+        if(cf == LV_COLOR_FORMAT_RGB565A8)
             pixel_byte = 2;
         else
-            pixel_byte = (lv_color_format_get_bpp(dsc->header.cf) + 7) >> 3;
-        const uint8_t * input = compressed->data;
-        uint8_t * output = img_data;
+            pixel_byte = (lv_color_format_get_bpp(cf) + 7) >> 3;
         uint32_t len;
         len = lv_rle_decompress(input, input_len, output, out_len, pixel_byte);
-        if(len != compressed->decompressed_size) {
+        if(len != out_len) {
             LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
-            lv_draw_buf_destroy(decompressed);
             return LV_RESULT_INVALID;
         }
 #else
         LV_LOG_WARN("RLE decompress is not enabled");
-        lv_draw_buf_destroy(decompressed);
         return LV_RESULT_INVALID;
 #endif
     }
     else if(compressed->method == LV_IMAGE_COMPRESS_LZ4) {
 #if LV_USE_LZ4
-        const char * input = (const char *)compressed->data;
-        char * output = (char *)img_data;
         int len;
-        len = LZ4_decompress_safe(input, output, input_len, out_len);
-        if(len < 0 || (uint32_t)len != compressed->decompressed_size) {
+        len = LZ4_decompress_safe((const char *)input, (char *)output, input_len, out_len);
+        if(len < 0 || (uint32_t)len != out_len) {
             LV_LOG_WARN("Decompress failed: %" LV_PRId32 ", got: %" LV_PRId32, out_len, len);
-            lv_draw_buf_destroy(decompressed);
             return LV_RESULT_INVALID;
         }
 #else
         LV_LOG_WARN("LZ4 decompress is not enabled");
-        lv_draw_buf_destroy(decompressed);
         return LV_RESULT_INVALID;
 #endif
     }
     else {
-        LV_UNUSED(img_data);
         LV_LOG_WARN("Unknown compression method: %d", compressed->method);
-        lv_draw_buf_destroy(decompressed);
         return LV_RESULT_INVALID;
     }
 
-    decoder_data->decompressed = decompressed; /*Free on decoder close*/
     return LV_RESULT_OK;
 }
+
+#if LV_BIN_DECODER_ROW_GROUPS
+
+static lv_result_t read_compressed_header(lv_image_decoder_dsc_t * dsc, lv_image_compressed_t * compressed)
+{
+    lv_memzero(compressed, sizeof(lv_image_compressed_t));
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        decoder_data_t * decoder_data = dsc->user_data;
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t), compressed,
+                                             COMPRESSED_HEADER_SIZE, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != COMPRESSED_HEADER_SIZE) {
+            LV_LOG_WARN("Read compressed header failed: %d", fs_res);
+            return LV_RESULT_INVALID;
+        }
+    }
+    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * image = dsc->src;
+        if(image->data_size < COMPRESSED_HEADER_SIZE) return LV_RESULT_INVALID;
+
+        lv_memcpy(compressed, image->data, COMPRESSED_HEADER_SIZE);
+        compressed->data = image->data + COMPRESSED_HEADER_SIZE;
+    }
+    else {
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Load the row group index of a compressed image. The groups are decompressed in get_area_cb.
+ */
+static lv_result_t open_row_groups(lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = get_decoder_data(dsc);
+    if(decoder_data == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_image_compressed_t * compressed = &decoder_data->compressed;
+    if(read_compressed_header(dsc, compressed) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+
+    /*Only the formats whose rows are stored one after the other can be decompressed in groups*/
+    lv_color_format_t cf = dsc->header.cf;
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_RGB888
+       && cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_ARGB8565) {
+        LV_LOG_WARN("Row groups are not supported for CF: %d", cf);
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t group_rows = compressed->group_rows;
+    uint32_t group_cnt = (dsc->header.h + group_rows - 1) / group_rows;
+    uint32_t index_size = (group_cnt + 1) * sizeof(uint32_t);
+    if(compressed->compressed_size < index_size
+       || compressed->decompressed_size != dsc->header.h * dsc->header.stride) {
+        LV_LOG_WARN("Invalid row group header");
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t * offsets = lv_malloc(index_size);
+    if(offsets == NULL) {
+        LV_LOG_WARN("No memory for row group index");
+        return LV_RESULT_INVALID;
+    }
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        lv_fs_file_t * f = decoder_data->f;
+        uint32_t file_len;
+        uint32_t rn;
+        lv_fs_res_t fs_res = LV_FS_RES_UNKNOWN;
+        if(lv_fs_seek(f, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(f, &file_len) == LV_FS_RES_OK
+           && file_len == sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE + compressed->compressed_size) {
+            fs_res = fs_read_file_at(f, sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE, offsets, index_size, &rn);
+        }
+
+        if(fs_res != LV_FS_RES_OK || rn != index_size) {
+            LV_LOG_WARN("Read row group index failed: %d", fs_res);
+            lv_free(offsets);
+            return LV_RESULT_INVALID;
+        }
+
+        compressed->data = NULL; /*The groups are read from the file when they are needed*/
+    }
+    else {
+        const lv_image_dsc_t * image = dsc->src;
+        if(image->data_size != COMPRESSED_HEADER_SIZE + compressed->compressed_size) {
+            LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32, compressed->compressed_size,
+                        image->data_size - COMPRESSED_HEADER_SIZE);
+            lv_free(offsets);
+            return LV_RESULT_INVALID;
+        }
+
+        lv_memcpy(offsets, compressed->data, index_size); /*The index might be unaligned in the image data*/
+        compressed->data += index_size;
+    }
+
+    /*Check the index once so that the groups can be read without further checks*/
+    uint32_t i;
+    for(i = 0; i < group_cnt; i++) {
+        if(offsets[i] > offsets[i + 1]) break;
+    }
+
+    if(i != group_cnt || offsets[group_cnt] > compressed->compressed_size - index_size) {
+        LV_LOG_WARN("Invalid row group index");
+        lv_free(offsets);
+        return LV_RESULT_INVALID;
+    }
+
+    if(row_group_cache_p == NULL) {
+        row_group_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(row_group_cache_data_t),
+        LV_BIN_DECODER_ROW_GROUP_CACHE_CNT, (lv_cache_ops_t) {
+            .compare_cb = (lv_cache_compare_cb_t)row_group_compare_cb,
+            .create_cb = (lv_cache_create_cb_t)row_group_create_cb,
+            .free_cb = (lv_cache_free_cb_t)row_group_free_cb,
+        });
+        if(row_group_cache_p == NULL) {
+            lv_free(offsets);
+            return LV_RESULT_INVALID;
+        }
+        lv_cache_set_name(row_group_cache_p, "BIN_ROW_GROUP");
+    }
+
+    decoder_data->group_offsets = offsets;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Return the decompressed row groups covering `full_area` one by one.
+ * The whole groups are returned so that the cached data can be drawn directly.
+ */
+static lv_result_t get_area_row_groups(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                       lv_area_t * decoded_area)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    int32_t group_rows = decoder_data->compressed.group_rows;
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1;
+
+    release_row_group(decoder_data);
+    dsc->decoded = NULL;
+
+    if(y > full_area->y2) {
+        return LV_RESULT_INVALID;
+    }
+
+    row_group_cache_data_t search_key = {
+        .src = dsc->src,
+        .src_type = dsc->src_type,
+        .group = y / group_rows,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(row_group_cache_p, &search_key, dsc);
+    if(entry == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->group_entry = entry; /*Released on the next call or when the decoder closes*/
+    row_group_cache_data_t * cached = lv_cache_entry_get_data(entry);
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = dsc->header.w - 1;
+    decoded_area->y1 = search_key.group * group_rows;
+    decoded_area->y2 = decoded_area->y1 + cached->decoded->header.h - 1;
+
+    dsc->decoded = cached->decoded;
+    return LV_RESULT_OK;
+}
+
+static void release_row_group(decoder_data_t * decoder_data)
+{
+    if(decoder_data->group_entry == NULL) return;
+
+    lv_cache_release(row_group_cache_p, decoder_data->group_entry, NULL);
+    decoder_data->group_entry = NULL;
+}
+
+static lv_cache_compare_res_t row_group_compare_cb(const row_group_cache_data_t * lhs,
+                                                   const row_group_cache_data_t * rhs)
+{
+    if(lhs->group != rhs->group) {
+        return lhs->group > rhs->group ? 1 : -1;
+    }
+
+    if(lhs->src_type != rhs->src_type) {
+        return lhs->src_type > rhs->src_type ? 1 : -1;
+    }
+
+    if(lhs->src_type == LV_IMAGE_SRC_FILE) {
+        int32_t cmp_res = lv_strcmp(lhs->src, rhs->src);
+        if(cmp_res != 0) {
+            return cmp_res > 0 ? 1 : -1;
+        }
+    }
+    else if(lhs->src != rhs->src) {
+        return lhs->src > rhs->src ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static bool row_group_create_cb(row_group_cache_data_t * node, lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    const uint32_t * offsets = decoder_data->group_offsets;
+    uint32_t group_rows = compressed->group_rows;
+    uint32_t rows = LV_MIN(group_rows, dsc->header.h - node->group * group_rows);
+    uint32_t input_len = offsets[node->group + 1] - offsets[node->group];
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, rows,
+                                                    dsc->header.cf, dsc->header.stride);
+    if(decoded == NULL) {
+        LV_LOG_WARN("No memory for row group");
+        return false;
+    }
+
+    uint8_t * file_buf = NULL;
+    const uint8_t * input;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        file_buf = lv_malloc(input_len);
+        if(file_buf == NULL) {
+            LV_LOG_WARN("No memory for compressed row group");
+            lv_draw_buf_destroy(decoded);
+            return false;
+        }
+
+        uint32_t group_cnt = (dsc->header.h + group_rows - 1) / group_rows;
+        uint32_t pos = sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE;
+        pos += (group_cnt + 1) * sizeof(uint32_t); /*Skip the index*/
+        pos += offsets[node->group];
+
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, pos, file_buf, input_len, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != input_len) {
+            LV_LOG_WARN("Read row group failed: %d", fs_res);
+            lv_free(file_buf);
+            lv_draw_buf_destroy(decoded);
+            return false;
+        }
+        input = file_buf;
+    }
+    else {
+        input = compressed->data + offsets[node->group];
+    }
+
+    lv_result_t res = decompress_data(compressed, dsc->header.cf, input, input_len, decoded->data,
+                                      rows * dsc->header.stride);
+    lv_free(file_buf);
+    if(res != LV_RESULT_OK) {
+        lv_draw_buf_destroy(decoded);
+        return false;
+    }
+
+    /*The source is only borrowed in the search key*/
+    if(node->src_type == LV_IMAGE_SRC_FILE) {
+        node->src = lv_strdup(node->src);
+        if(node->src == NULL) {
+            lv_draw_buf_destroy(decoded);
+            return false;
+        }
+    }
+
+    node->decoded = decoded;
+    if(node->group > row_group_max) row_group_max = node->group;
+    return true;
+}
+
+static void row_group_free_cb(row_group_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_draw_buf_destroy(node->decoded);
+    if(node->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)node->src);
+}
+
+#endif /*LV_BIN_DECODER_ROW_GROUPS*/
@@ -13,6 +13,7 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <dirent.h>
 #include <unistd.h>
 #include <errno.h>
@@ -57,6 +58,7 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, uint32_t * size, uint32_t * mtime);
 
 /**********************
  *  STATIC VARIABLES
@@ -97,6 +99,8 @@ void lv_fs_posix_init(void)
     fs_drv_p->dir_open_cb = fs_dir_open;
     fs_drv_p->dir_read_cb = fs_dir_read;
 
+    fs_drv_p->stat_cb = fs_stat;
+
     lv_fs_drv_register(fs_drv_p);
 }
 
@@ -332,6 +336,29 @@ static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p)
 
     return LV_FS_RES_OK;
 }
+
+/**
+ * Get the size and the modification time of a file
+ * @param drv       pointer to a driver where this function belongs
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @param size      store the size of the file here
+ * @param mtime     store the modification time here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, uint32_t * size, uint32_t * mtime)
+{
+    LV_UNUSED(drv);
+
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_POSIX_PATH "%s", path);
+
+    struct stat st;
+    if(stat(buf, &st) != 0) return LV_FS_RES_NOT_EX;
+
+    *size = (uint32_t)st.st_size;
+    *mtime = (uint32_t)st.st_mtime;
+    return LV_FS_RES_OK;
+}
 #else /*LV_USE_FS_POSIX == 0*/
 
 #if defined(LV_FS_POSIX_LETTER) && LV_FS_POSIX_LETTER != '\0'
@@ -10,6 +10,7 @@
 #if LV_USE_FS_STDIO != '\0'
 
 #include <stdio.h>
+#include <sys/stat.h>
 #ifndef WIN32
     #include <dirent.h>
     #include <unistd.h>
@@ -60,6 +61,7 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, uint32_t * size, uint32_t * mtime);
 
 /**********************
  *  STATIC VARIABLES
@@ -100,6 +102,8 @@ void lv_fs_stdio_init(void)
     fs_drv_p->dir_open_cb = fs_dir_open;
     fs_drv_p->dir_read_cb = fs_dir_read;
 
+    fs_drv_p->stat_cb = fs_stat;
+
     lv_fs_drv_register(fs_drv_p);
 }
 
@@ -350,6 +354,29 @@ static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p)
     return LV_FS_RES_OK;
 }
 
+/**
+ * Get the size and the modification time of a file
+ * @param drv       pointer to a driver where this function belongs
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @param size      store the size of the file here
+ * @param mtime     store the modification time here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, uint32_t * size, uint32_t * mtime)
+{
+    LV_UNUSED(drv);
+
+    char buf[MAX_PATH_LEN];
+    lv_snprintf(buf, sizeof(buf), LV_FS_STDIO_PATH "%s", path);
+
+    struct stat st;
+    if(stat(buf, &st) != 0) return LV_FS_RES_NOT_EX;
+
+    *size = (uint32_t)st.st_size;
+    *mtime = (uint32_t)st.st_mtime;
+    return LV_FS_RES_OK;
+}
+
 #else /*LV_USE_FS_STDIO == 0*/
 
 #if defined(LV_FS_STDIO_LETTER) && LV_FS_STDIO_LETTER != '\0'
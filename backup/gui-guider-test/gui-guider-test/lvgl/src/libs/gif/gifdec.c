@@ -29,11 +29,23 @@ typedef struct Table {
 #define LZW_CACHE_SIZE              (LZW_TABLE_SIZE * 4)
 #endif
 
+#if LV_GIF_DIFF_RENDER && LV_COLOR_DEPTH == 16
+#define CANVAS_PX_SIZE              3   /* RGB565 and an A8 plane used only if needed */
+#else
+#define CANVAS_PX_SIZE              4
+#endif
+
 static gd_GIF  * gif_open(gd_GIF * gif);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
 static void f_gif_close(gd_GIF * gif);
+#if LV_GIF_DIFF_RENDER
+static void mark_changed(gd_GIF * gif, int32_t x1, int32_t y, int32_t x2);
+static void render_frame_diff(gd_GIF * gif, uint8_t * buffer);
+static void set_dispose_area(gd_GIF * gif, const uint8_t * color, uint8_t opa);
+static void fill_dispose_area(gd_GIF * gif, uint8_t * buffer, bool skip_frame_px);
+#endif
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "gifdec_mve.h"
@@ -118,17 +130,17 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
         goto fail;
     }
 #if LV_GIF_CACHE_DECODE_DATA
-    if(0 == (INT_MAX - sizeof(gd_GIF) - LZW_CACHE_SIZE) / width / height / 5){
+    if(0 == (INT_MAX - sizeof(gd_GIF) - LZW_CACHE_SIZE) / width / height / (CANVAS_PX_SIZE + 1)){
         LV_LOG_WARN("Image dimensions are too large");
         goto fail;
     } 
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height + LZW_CACHE_SIZE);
+    gif = lv_malloc(sizeof(gd_GIF) + (CANVAS_PX_SIZE + 1) * width * height + LZW_CACHE_SIZE);
     #else
-    if(0 == (INT_MAX - sizeof(gd_GIF)) / width / height / 5){
+    if(0 == (INT_MAX - sizeof(gd_GIF)) / width / height / (CANVAS_PX_SIZE + 1)){
         LV_LOG_WARN("Image dimensions are too large");
         goto fail;
     } 
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height);
+    gif = lv_malloc(sizeof(gd_GIF) + (CANVAS_PX_SIZE + 1) * width * height);
     #endif
     if(!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
@@ -141,7 +153,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
-    gif->frame = &gif->canvas[4 * width * height];
+    gif->frame = &gif->canvas[CANVAS_PX_SIZE * width * height];
     if(gif->bgindex) {
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
     }
@@ -150,9 +162,27 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->lzw_cache = gif->frame + width * height;
     #endif
 
-#ifdef GIFDEC_FILL_BG
+#if LV_GIF_DIFF_RENDER
+    lv_area_set(&gif->changed, 0, 0, width - 1, height - 1);
+    lv_area_set(&gif->dispose_area, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+#endif
+
+#if LV_GIF_DIFF_RENDER && LV_COLOR_DEPTH == 16
+    /* Start without alpha plane, it's added when a disposal makes the canvas transparent */
+    gif->canvas_cf = LV_COLOR_FORMAT_RGB565;
+    uint16_t bg16 = lv_color_to_u16(lv_color_make(bgcolor[0], bgcolor[1], bgcolor[2]));
+    for(int i = 0; i < gif->width * gif->height; i++) {
+        ((uint16_t *)gif->canvas)[i] = bg16;
+    }
+#elif defined(GIFDEC_FILL_BG)
+#if LV_GIF_DIFF_RENDER
+    gif->canvas_cf = LV_COLOR_FORMAT_ARGB8888;
+#endif
     GIFDEC_FILL_BG(gif->canvas, gif->width * gif->height, 1, gif->width * gif->height, bgcolor, 0xff);
 #else
+#if LV_GIF_DIFF_RENDER
+    gif->canvas_cf = LV_COLOR_FORMAT_ARGB8888;
+#endif
     for(int i = 0; i < gif->width * gif->height; i++) {
         gif->canvas[i * 4 + 0] = *(bgcolor + 2);
         gif->canvas[i * 4 + 1] = *(bgcolor + 1);
@@ -660,6 +690,9 @@ read_image(gd_GIF * gif)
 static void
 render_frame_rect(gd_GIF * gif, uint8_t * buffer)
 {
+#if LV_GIF_DIFF_RENDER
+    render_frame_diff(gif, buffer);
+#else
     int i = gif->fy * gif->width + gif->fx;
 #ifdef GIFDEC_RENDER_FRAME
     GIFDEC_RENDER_FRAME(&buffer[i * 4], gif->fw, gif->fh, gif->width,
@@ -683,6 +716,7 @@ render_frame_rect(gd_GIF * gif, uint8_t * buffer)
         i += gif->width;
     }
 #endif
+#endif /*LV_GIF_DIFF_RENDER*/
 }
 
 static void
@@ -697,6 +731,10 @@ dispose(gd_GIF * gif)
             uint8_t opa = 0xff;
             if(gif->gce.transparency) opa = 0x00;
 
+#if LV_GIF_DIFF_RENDER
+            LV_UNUSED(i);
+            set_dispose_area(gif, bgcolor, opa);
+#else
             i = gif->fy * gif->width + gif->fx;
 #ifdef GIFDEC_FILL_BG
             GIFDEC_FILL_BG(&(gif->canvas[i * 4]), gif->fw, gif->fh, gif->width, bgcolor, opa);
@@ -712,12 +750,17 @@ dispose(gd_GIF * gif)
                 i += gif->width;
             }
 #endif
+#endif /*LV_GIF_DIFF_RENDER*/
             break;
         case 3: /* Restore to previous, i.e., don't update canvas.*/
             break;
         default:
+#if !LV_GIF_DIFF_RENDER
             /* Add frame non-transparent pixels to canvas. */
             render_frame_rect(gif, gif->canvas);
+#endif
+            /* Else the frame was rendered to the canvas by gd_render_frame already. */
+            break;
     }
 }
 
@@ -727,6 +770,11 @@ gd_get_frame(gd_GIF * gif)
 {
     char sep;
 
+#if LV_GIF_DIFF_RENDER
+    lv_area_set(&gif->changed, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+    /* Apply the disposal of the previous frame if it wasn't rendered */
+    fill_dispose_area(gif, gif->canvas, false);
+#endif
     dispose(gif);
     f_gif_read(gif, &sep, 1);
     while(sep != ',') {
@@ -819,4 +867,140 @@ static void f_gif_close(gd_GIF * gif)
     }
 }
 
+#if LV_GIF_DIFF_RENDER
+
+static void mark_changed(gd_GIF * gif, int32_t x1, int32_t y, int32_t x2)
+{
+    lv_area_t * a = &gif->changed;
+    if(x1 < a->x1) a->x1 = x1;
+    if(x2 > a->x2) a->x2 = x2;
+    if(y < a->y1) a->y1 = y;
+    if(y > a->y2) a->y2 = y;
+}
+
+/* Render the frame's non-transparent pixels through a palette LUT and write
+ * only the pixels which are different on the canvas */
+static void render_frame_diff(gd_GIF * gif, uint8_t * buffer)
+{
+    int tindex = gif->gce.transparency ? gif->gce.tindex : 0x100;
+    uint32_t px_cnt = gif->width * gif->height;
+    int i, j, k;
+
+    fill_dispose_area(gif, buffer, true);
+
+#if LV_COLOR_DEPTH == 16
+    uint16_t lut[256];
+    for(i = 0; i < gif->palette->size; i++) {
+        const uint8_t * c = &gif->palette->colors[i * 3];
+        lut[i] = lv_color_to_u16(lv_color_make(c[0], c[1], c[2]));
+    }
+    /* Indices out of the palette are black */
+    for(; i < 256; i++) lut[i] = 0;
+    uint8_t * alpha = gif->canvas_cf == LV_COLOR_FORMAT_RGB565A8 ? &buffer[px_cnt * 2] : NULL;
+#else
+    uint32_t lut[256];
+    for(i = 0; i < gif->palette->size; i++) {
+        const uint8_t * c = &gif->palette->colors[i * 3];
+        lv_color32_t c32 = {.blue = c[2], .green = c[1], .red = c[0], .alpha = 0xff};
+        lut[i] = *(uint32_t *)&c32;
+    }
+    for(; i < 256; i++) lut[i] = 0xff000000;
+    LV_UNUSED(px_cnt);
+#endif
+
+    for(j = 0; j < gif->fh; j++) {
+        i = (gif->fy + j) * gif->width + gif->fx;
+        const uint8_t * index = &gif->frame[i];
+        int x1 = -1;
+        int x2 = -1;
+#if LV_COLOR_DEPTH == 16
+        uint16_t * dest = &((uint16_t *)buffer)[i];
+#else
+        uint32_t * dest = &((uint32_t *)buffer)[i];
+#endif
+        for(k = 0; k < gif->fw; k++) {
+            if(index[k] == tindex) continue;
+#if LV_COLOR_DEPTH == 16
+            if(dest[k] == lut[index[k]] && (alpha == NULL || alpha[i + k] == 0xff)) continue;
+            if(alpha) alpha[i + k] = 0xff;
+#else
+            if(dest[k] == lut[index[k]]) continue;
+#endif
+            dest[k] = lut[index[k]];
+            if(x1 < 0) x1 = k;
+            x2 = k;
+        }
+        if(x1 >= 0) mark_changed(gif, gif->fx + x1, gif->fy + j, gif->fx + x2);
+    }
+}
+
+/* Save the frame's area to be restored to the background color when the next frame is rendered.
+ * Filling them together writes only the pixels which really change. */
+static void set_dispose_area(gd_GIF * gif, const uint8_t * color, uint8_t opa)
+{
+    lv_area_set(&gif->dispose_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    gif->dispose_opa = opa;
+
+#if LV_COLOR_DEPTH == 16
+    if(opa != 0xff && gif->canvas_cf == LV_COLOR_FORMAT_RGB565) {
+        /* Add the alpha plane. The format change redraws the whole image. */
+        uint32_t px_cnt = gif->width * gif->height;
+        lv_memset(&gif->canvas[px_cnt * 2], 0xff, px_cnt);
+        gif->canvas_cf = LV_COLOR_FORMAT_RGB565A8;
+    }
+    gif->dispose_color = lv_color_to_u16(lv_color_make(color[0], color[1], color[2]));
+#else
+    lv_color32_t c32 = {.blue = color[2], .green = color[1], .red = color[0], .alpha = opa};
+    gif->dispose_color = *(uint32_t *)&c32;
+#endif
+}
+
+/* Fill the dispose area with the background color, writing only the pixels which are different.
+ * If `skip_frame_px` is set the pixels to be covered by the current frame are left as they are. */
+static void fill_dispose_area(gd_GIF * gif, uint8_t * buffer, bool skip_frame_px)
+{
+    lv_area_t * a = &gif->dispose_area;
+    if(a->x1 > a->x2) return;
+
+    int tindex = gif->gce.transparency ? gif->gce.tindex : 0x100;
+    uint8_t opa = gif->dispose_opa;
+    int32_t x, y;
+
+#if LV_COLOR_DEPTH == 16
+    uint32_t px_cnt = gif->width * gif->height;
+    uint8_t * alpha = gif->canvas_cf == LV_COLOR_FORMAT_RGB565A8 ? &buffer[px_cnt * 2] : NULL;
+    uint16_t c = (uint16_t)gif->dispose_color;
+    uint16_t * dest = (uint16_t *)buffer;
+#else
+    uint32_t c = gif->dispose_color;
+    uint32_t * dest = (uint32_t *)buffer;
+#endif
+
+    for(y = a->y1; y <= a->y2; y++) {
+        bool frame_row = skip_frame_px && y >= gif->fy && y < gif->fy + gif->fh;
+        int32_t x1 = -1;
+        int32_t x2 = -1;
+        for(x = a->x1; x <= a->x2; x++) {
+            if(frame_row && x >= gif->fx && x < gif->fx + gif->fw &&
+               gif->frame[y * gif->width + x] != tindex) continue;
+
+            int32_t i = y * gif->width + x;
+#if LV_COLOR_DEPTH == 16
+            if(dest[i] == c && (alpha == NULL || alpha[i] == opa)) continue;
+            if(alpha) alpha[i] = opa;
+#else
+            if(dest[i] == c) continue;
+#endif
+            dest[i] = c;
+            if(x1 < 0) x1 = x;
+            x2 = x;
+        }
+        if(x1 >= 0) mark_changed(gif, x1, y, x2);
+    }
+
+    lv_area_set(a, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+}
+
+#endif /*LV_GIF_DIFF_RENDER*/
+
 #endif /*LV_USE_GIF*/
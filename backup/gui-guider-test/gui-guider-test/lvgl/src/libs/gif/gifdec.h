@@ -6,6 +6,8 @@ extern "C" {
 #endif
 
 #include "../../misc/lv_fs.h"
+#include "../../misc/lv_area.h"
+#include "../../misc/lv_color.h"
 
 #if LV_USE_GIF
 #include <stdint.h>
@@ -50,6 +52,13 @@ typedef struct _gd_GIF {
     #if LV_GIF_CACHE_DECODE_DATA
     uint8_t *lzw_cache;
     #endif
+    #if LV_GIF_DIFF_RENDER
+    lv_color_format_t canvas_cf;    /* RGB565, RGB565A8 or ARGB8888 */
+    lv_area_t changed;              /* Canvas area changed by the last gd_get_frame and gd_render_frame */
+    lv_area_t dispose_area;         /* Area to restore to the background when the next frame is rendered */
+    uint32_t dispose_color;         /* Background color of the dispose area in the canvas' format */
+    uint8_t dispose_opa;
+    #endif
 } gd_GIF;
 
 gd_GIF * gd_open_gif_file(const char * fname);
@@ -28,6 +28,10 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+#if LV_GIF_DIFF_RENDER
+    static void set_canvas_format(lv_gif_t * gifobj);
+    static void invalidate_changed_area(lv_obj_t * obj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -88,11 +92,15 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     gifobj->imgdsc.data = gif->canvas;
     gifobj->imgdsc.header.magic = LV_IMAGE_HEADER_MAGIC;
     gifobj->imgdsc.header.flags = LV_IMAGE_FLAGS_MODIFIABLE;
-    gifobj->imgdsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
     gifobj->imgdsc.header.h = gif->height;
     gifobj->imgdsc.header.w = gif->width;
+#if LV_GIF_DIFF_RENDER
+    set_canvas_format(gifobj);
+#else
+    gifobj->imgdsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
     gifobj->imgdsc.header.stride = gif->width * 4;
     gifobj->imgdsc.data_size = gif->width * gif->height * 4;
+#endif
 
     gifobj->last_call = lv_tick_get();
 
@@ -214,7 +222,69 @@ static void next_frame_task_cb(lv_timer_t * t)
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
     lv_image_cache_drop(lv_image_get_src(obj));
+
+#if LV_GIF_DIFF_RENDER
+    if(gifobj->gif->canvas_cf != gifobj->imgdsc.header.cf) {
+        /*An alpha plane was added to the canvas, refresh the whole image with the new format*/
+        set_canvas_format(gifobj);
+        lv_image_set_src(obj, &gifobj->imgdsc);
+        return;
+    }
+
+    invalidate_changed_area(obj);
+#else
     lv_obj_invalidate(obj);
+#endif
+}
+
+#if LV_GIF_DIFF_RENDER
+
+static void set_canvas_format(lv_gif_t * gifobj)
+{
+    gd_GIF * gif = gifobj->gif;
+    uint32_t px_cnt = gif->width * gif->height;
+
+    gifobj->imgdsc.header.cf = gif->canvas_cf;
+    if(gif->canvas_cf == LV_COLOR_FORMAT_ARGB8888) {
+        gifobj->imgdsc.header.stride = gif->width * 4;
+        gifobj->imgdsc.data_size = px_cnt * 4;
+    }
+    else {
+        /*RGB565 or RGB565 with an A8 plane after the colors*/
+        gifobj->imgdsc.header.stride = gif->width * 2;
+        gifobj->imgdsc.data_size = px_cnt * (gif->canvas_cf == LV_COLOR_FORMAT_RGB565A8 ? 3 : 2);
+    }
 }
 
+/**
+ * Invalidate only the area changed by the last frame
+ */
+static void invalidate_changed_area(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    lv_image_t * img = (lv_image_t *) obj;
+    const lv_area_t * changed = &gifobj->gif->changed;
+
+    if(changed->x1 > changed->x2) return;
+
+    /*With transformations it's simpler to redraw the whole image*/
+    if(img->rotation != 0 || img->scale_x != LV_SCALE_NONE || img->scale_y != LV_SCALE_NONE ||
+       img->align >= LV_IMAGE_ALIGN_AUTO_TRANSFORM) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Place the image the same way as `lv_image` draws it*/
+    lv_area_t image_area;
+    lv_area_set(&image_area, obj->coords.x1, obj->coords.y1,
+                obj->coords.x1 + img->w - 1, obj->coords.y1 + img->h - 1);
+    lv_area_align(&obj->coords, &image_area, img->align, img->offset.x, img->offset.y);
+
+    lv_area_t area = *changed;
+    lv_area_move(&area, image_area.x1, image_area.y1);
+    lv_obj_invalidate_area(obj, &area);
+}
+
+#endif /*LV_GIF_DIFF_RENDER*/
+
 #endif /*LV_USE_GIF*/
@@ -13,6 +13,7 @@
 
 #include "lv_lodepng.h"
 #include "lodepng.h"
+#include "lv_png_stream.h"
 #include <stdlib.h>
 
 /*********************
@@ -22,11 +23,23 @@
 #define DECODER_NAME    "LODEPNG"
 
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+
+#define STREAM_ROW_CNT  8   /*Rows decoded at once by `decoder_get_area`*/
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_LODEPNG_STREAM
+typedef struct {
+    lv_fs_file_t file;
+    bool file_opened;
+    lv_png_stream_t * stream;
+    lv_draw_buf_t * decoded_partial;    /*A few rows decoded via get_area_cb*/
+} stream_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -34,7 +47,15 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_d
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static void decoder_close(lv_image_decoder_t * dec, lv_image_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img_p, uint32_t px_cnt);
+static lv_draw_buf_t * decode_png(lv_image_decoder_dsc_t * dsc);
 static lv_draw_buf_t * decode_png_data(const void * png_data, size_t png_data_size);
+#if LV_LODEPNG_STREAM
+    static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                        const lv_area_t * full_area, lv_area_t * decoded_area);
+    static stream_data_t * open_stream(lv_image_decoder_dsc_t * dsc);
+    static lv_draw_buf_t * decode_stream(lv_image_decoder_dsc_t * dsc, stream_data_t * data);
+    static void close_stream(stream_data_t * data);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -56,6 +77,9 @@ void lv_lodepng_init(void)
     lv_image_decoder_set_info_cb(dec, decoder_info);
     lv_image_decoder_set_open_cb(dec, decoder_open);
     lv_image_decoder_set_close_cb(dec, decoder_close);
+#if LV_LODEPNG_STREAM
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+#endif
 
     dec->name = DECODER_NAME;
 }
@@ -118,12 +142,27 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_d
             if(lv_memcmp(img_dsc->data, magic, sizeof(magic)) != 0) return LV_RESULT_INVALID;
         }
 
+        /*The image header stores the size on 16 bits, so the upper 2 bytes of the big endian values must be 0*/
+        if((size[0] & 0x0000ffff) || (size[1] & 0x0000ffff)) {
+            LV_LOG_WARN("Too large PNG");
+            return LV_RESULT_INVALID;
+        }
+
         /*Save the data in the header*/
         header->cf = LV_COLOR_FORMAT_ARGB8888;
         /*The width and height are stored in Big endian format so convert them to little endian*/
         header->w = (int32_t)((size[0] & 0xff000000) >> 24) + ((size[0] & 0x00ff0000) >> 8);
         header->h = (int32_t)((size[1] & 0xff000000) >> 24) + ((size[1] & 0x00ff0000) >> 8);
 
+#if LV_LODEPNG_STREAM
+        /*Opaque images can be decoded straight to RGB565 row by row*/
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        lv_color_format_t stream_cf = src_type == LV_IMAGE_SRC_FILE ?
+                                      lv_png_stream_get_cf(&dsc->file, NULL, 0) :
+                                      lv_png_stream_get_cf(NULL, img_dsc->data, img_dsc->data_size);
+        if(stream_cf != LV_COLOR_FORMAT_UNKNOWN) header->cf = stream_cf;
+#endif
+
         return LV_RESULT_OK;
     }
 
@@ -140,34 +179,26 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 {
     LV_UNUSED(decoder);
 
-    const uint8_t * png_data = NULL;
-    size_t png_data_size = 0;
-    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
-        const char * fn = dsc->src;
-        if(lv_strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
-            unsigned error;
-            error = lodepng_load_file((void *)&png_data, &png_data_size, fn);  /*Load the file*/
-            if(error) {
-                if(png_data != NULL) {
-                    lv_free((void *)png_data);
-                }
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
-                return LV_RESULT_INVALID;
-            }
+    lv_draw_buf_t * decoded;
+#if LV_LODEPNG_STREAM
+    stream_data_t * data = open_stream(dsc);
+    if(data) {
+        /*Decode only the rows being drawn if the image won't be kept in the cache*/
+        uint32_t size = lv_draw_buf_width_to_stride(dsc->header.w, dsc->header.cf) * dsc->header.h;
+        if(dsc->args.no_cache || !lv_image_cache_is_enabled() || size > lv_cache_get_max_size(img_cache_p, NULL)) {
+            dsc->user_data = data;
+            return LV_RESULT_OK;
         }
-    }
-    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
-        const lv_image_dsc_t * img_dsc = dsc->src;
-        png_data = img_dsc->data;
-        png_data_size = img_dsc->data_size;
+
+        decoded = decode_stream(dsc, data);
+        close_stream(data);
     }
     else {
-        return LV_RESULT_INVALID;
+        decoded = decode_png(dsc);
     }
-
-    lv_draw_buf_t * decoded = decode_png_data(png_data, png_data_size);
-
-    if(dsc->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)png_data);
+#else
+    decoded = decode_png(dsc);
+#endif
 
     if(!decoded) {
         LV_LOG_WARN("Error decoding PNG");
@@ -219,10 +250,158 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder);
 
+#if LV_LODEPNG_STREAM
+    /*Decoded via get_area_cb, `decoded` is the partial buffer*/
+    if(dsc->user_data) {
+        close_stream(dsc->user_data);
+        dsc->user_data = NULL;
+        dsc->decoded = NULL;
+        return;
+    }
+#endif
+
     if(dsc->args.no_cache ||
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
 
+#if LV_LODEPNG_STREAM
+
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder);
+
+    stream_data_t * data = dsc->user_data;
+    if(data == NULL) return LV_RESULT_INVALID;
+
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1;
+    if(y > full_area->y2 || y >= dsc->header.h) return LV_RESULT_INVALID;
+
+    int32_t row_cnt = LV_MIN(STREAM_ROW_CNT, full_area->y2 - y + 1);
+    if(data->decoded_partial == NULL) {
+        data->decoded_partial = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, STREAM_ROW_CNT,
+                                                      dsc->header.cf, LV_STRIDE_AUTO);
+        if(data->decoded_partial == NULL) return LV_RESULT_INVALID;
+    }
+
+    lv_draw_buf_t * decoded = lv_draw_buf_reshape(data->decoded_partial, dsc->header.cf, dsc->header.w, row_cnt,
+                                                  LV_STRIDE_AUTO);
+    if(decoded == NULL) return LV_RESULT_INVALID;
+
+    /*The stream continues from the last decoded row or restarts from the top if needed*/
+    if(lv_png_stream_read_rows(data->stream, y, row_cnt, decoded->data, decoded->header.stride) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = dsc->header.w - 1;
+    decoded_area->y1 = y;
+    decoded_area->y2 = y + row_cnt - 1;
+    dsc->decoded = decoded;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Prepare a PNG to be decoded row by row
+ * @param dsc       decoded image descriptor
+ * @return          the stream data or NULL if the PNG should be decoded by lodepng
+ */
+static stream_data_t * open_stream(lv_image_decoder_dsc_t * dsc)
+{
+    stream_data_t * data = lv_malloc_zeroed(sizeof(stream_data_t));
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) return NULL;
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        const char * fn = dsc->src;
+        if(lv_strcmp(lv_fs_get_ext(fn), "png") != 0 ||
+           lv_fs_open(&data->file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_free(data);
+            return NULL;
+        }
+        data->file_opened = true;
+        data->stream = lv_png_stream_create(&data->file, NULL, 0, dsc->header.cf,
+                                            dsc->header.w, dsc->header.h);
+    }
+    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        data->stream = lv_png_stream_create(NULL, img_dsc->data, img_dsc->data_size, dsc->header.cf,
+                                            dsc->header.w, dsc->header.h);
+    }
+
+    if(data->stream == NULL) {
+        close_stream(data);
+        return NULL;
+    }
+
+    return data;
+}
+
+static lv_draw_buf_t * decode_stream(lv_image_decoder_dsc_t * dsc, stream_data_t * data)
+{
+    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, dsc->header.h,
+                                                    dsc->header.cf, LV_STRIDE_AUTO);
+    if(decoded == NULL) return NULL;
+
+    if(lv_png_stream_read_rows(data->stream, 0, dsc->header.h, decoded->data,
+                               decoded->header.stride) != LV_RESULT_OK) {
+        lv_draw_buf_destroy(decoded);
+        return NULL;
+    }
+
+    return decoded;
+}
+
+static void close_stream(stream_data_t * data)
+{
+    if(data->decoded_partial) lv_draw_buf_destroy(data->decoded_partial);
+    lv_png_stream_delete(data->stream);
+    if(data->file_opened) lv_fs_close(&data->file);
+    lv_free(data);
+}
+
+#endif /*LV_LODEPNG_STREAM*/
+
+/**
+ * Load a PNG from a file or variable and decode it with lodepng
+ * @param dsc       decoded image descriptor
+ * @return          the decoded ARGB8888 image or NULL on error
+ */
+static lv_draw_buf_t * decode_png(lv_image_decoder_dsc_t * dsc)
+{
+    const uint8_t * png_data = NULL;
+    size_t png_data_size = 0;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        const char * fn = dsc->src;
+        if(lv_strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
+            unsigned error;
+            error = lodepng_load_file((void *)&png_data, &png_data_size, fn);  /*Load the file*/
+            if(error) {
+                if(png_data != NULL) {
+                    lv_free((void *)png_data);
+                }
+                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+                return NULL;
+            }
+        }
+    }
+    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        png_data = img_dsc->data;
+        png_data_size = img_dsc->data_size;
+    }
+    else {
+        return NULL;
+    }
+
+    lv_draw_buf_t * decoded = decode_png_data(png_data, png_data_size);
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)png_data);
+
+    return decoded;
+}
+
 static lv_draw_buf_t * decode_png_data(const void * png_data, size_t png_data_size)
 {
     unsigned png_width;             /*Not used, just required by the decoder*/
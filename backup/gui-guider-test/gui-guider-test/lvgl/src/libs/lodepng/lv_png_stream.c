@@ -0,0 +1,905 @@
+/**
+ * @file lv_png_stream.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_png_stream.h"
+#if LV_USE_LODEPNG && LV_LODEPNG_STREAM
+
+#include "../../stdlib/lv_mem.h"
+#include "../../stdlib/lv_string.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define IN_BUF_SIZE     512     /*Bytes read from the file at once*/
+#define CHUNK_LEN_MAX   0x7fffffffU /*Longest chunk allowed by the PNG specification*/
+
+#define MAX_BITS        15      /*Longest Huffman code*/
+#define FAST_BITS       9       /*Codes up to this length are decoded by a single table lookup*/
+#define SYM_BITS        9       /*Bits of the symbol in the lookup table entries*/
+
+#define MAX_LEN_SYMS    288
+#define MAX_DIST_SYMS   30
+
+#define COLOR_TYPE_GRAY         0
+#define COLOR_TYPE_RGB          2
+#define COLOR_TYPE_PALETTE      3
+#define COLOR_TYPE_GRAY_ALPHA   4
+#define COLOR_TYPE_RGBA         6
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    BLOCK_NONE,
+    BLOCK_STORED,
+    BLOCK_HUFFMAN,
+} block_type_t;
+
+typedef struct {
+    uint16_t count[MAX_BITS + 1];       /*Number of codes of each length*/
+    uint16_t symbol[MAX_LEN_SYMS];      /*Symbols ordered by their code*/
+    uint16_t fast[1 << FAST_BITS];      /*(code length << SYM_BITS) | symbol. 0: longer code*/
+} huffman_t;
+
+typedef struct {
+    lv_fs_file_t * file;
+    const uint8_t * data;
+    uint32_t data_size;
+    uint32_t pos;
+} png_input_t;
+
+typedef struct {
+    uint32_t w;
+    uint32_t h;
+    uint8_t bit_depth;
+    uint8_t color_type;
+    bool interlaced;
+    bool has_trns;
+    uint32_t idat_pos;                  /*Position of the first IDAT chunk*/
+} png_info_t;
+
+struct lv_png_stream_t {
+    png_info_t info;
+    lv_color_format_t cf;
+
+    /*Reading the concatenated IDAT chunks*/
+    png_input_t input;
+    const uint8_t * in_buf;             /*`in_buf_file` or the PNG data*/
+    uint32_t in_len;
+    uint32_t in_idx;
+    uint32_t chunk_left;                /*Bytes left in the current IDAT chunk*/
+    bool idat_end;
+
+    /*Inflating*/
+    uint32_t bit_buf;
+    uint32_t bit_cnt;
+    uint8_t * window;                   /*The last `window_size` inflated bytes for the back references*/
+    uint32_t window_size;
+    uint32_t window_pos;                /*Number of inflated bytes*/
+    uint32_t copy_len;                  /*Bytes left from the current back reference*/
+    uint32_t copy_dist;
+    uint32_t stored_left;               /*Bytes left from the current stored block*/
+    block_type_t block;
+    bool last_block;
+    huffman_t len_code;
+    huffman_t dist_code;
+
+    /*Unfiltering*/
+    uint8_t * row;
+    uint8_t * prev_row;
+    uint32_t row_bytes;
+    uint32_t px_bytes;                  /*Distance of the bytes of the neighbor pixels in the filters*/
+    uint32_t y;                         /*Index of the next row*/
+
+    lv_color32_t palette[256];
+    uint8_t in_buf_file[IN_BUF_SIZE];
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_result_t parse_chunks(png_input_t * input, png_info_t * info, lv_color32_t * palette);
+static lv_color_format_t get_cf(const png_info_t * info);
+static lv_result_t restart(lv_png_stream_t * stream);
+static lv_result_t next_row(lv_png_stream_t * stream);
+static void convert_row(lv_png_stream_t * stream, uint8_t * buf);
+static uint32_t inflate_read(lv_png_stream_t * stream, uint8_t * out, uint32_t len);
+static lv_result_t next_block(lv_png_stream_t * stream);
+static lv_result_t read_dynamic_codes(lv_png_stream_t * stream);
+static lv_result_t huffman_build(huffman_t * h, const uint8_t * lengths, uint32_t sym_cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t dist_base[MAX_DIST_SYMS] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint8_t dist_extra[MAX_DIST_SYMS] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+#if LV_LODEPNG_STREAM_DITHER
+static const uint8_t dither_matrix[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_color_format_t lv_png_stream_get_cf(lv_fs_file_t * file, const uint8_t * data, uint32_t data_size)
+{
+    png_input_t input = {file, data, data_size, 0};
+    png_info_t info;
+    if(file) lv_fs_seek(file, 0, LV_FS_SEEK_SET);
+    if(parse_chunks(&input, &info, NULL) != LV_RESULT_OK) return LV_COLOR_FORMAT_UNKNOWN;
+
+    return get_cf(&info);
+}
+
+lv_png_stream_t * lv_png_stream_create(lv_fs_file_t * file, const uint8_t * data, uint32_t data_size,
+                                       lv_color_format_t cf, uint32_t w, uint32_t h)
+{
+    lv_png_stream_t * stream = lv_malloc_zeroed(sizeof(lv_png_stream_t));
+    LV_ASSERT_MALLOC(stream);
+    if(stream == NULL) return NULL;
+
+    stream->input.file = file;
+    stream->input.data = data;
+    stream->input.data_size = data_size;
+
+    uint32_t i;
+    for(i = 0; i < 256; i++) stream->palette[i].alpha = 0xff;
+
+    if(file) lv_fs_seek(file, 0, LV_FS_SEEK_SET);
+    if(parse_chunks(&stream->input, &stream->info, stream->palette) != LV_RESULT_OK) {
+        lv_free(stream);
+        return NULL;
+    }
+
+    /*The header might have been read with different settings or the file might have changed since then*/
+    stream->cf = get_cf(&stream->info);
+    if(stream->cf == LV_COLOR_FORMAT_UNKNOWN || stream->cf != cf || stream->info.w != w || stream->info.h != h) {
+        lv_free(stream);
+        return NULL;
+    }
+
+    static const uint8_t channels[] = {1, 0, 3, 1, 2, 0, 4};
+    uint32_t bpp = channels[stream->info.color_type] * stream->info.bit_depth;
+    if(bpp == 0 || stream->info.w > (UINT32_MAX - 7) / bpp) {
+        LV_LOG_WARN("Too large PNG");
+        lv_free(stream);
+        return NULL;
+    }
+    stream->row_bytes = (stream->info.w * bpp + 7) / 8;
+    stream->px_bytes = LV_MAX(bpp / 8, 1);
+
+    stream->row = lv_malloc(stream->row_bytes);
+    stream->prev_row = lv_malloc(stream->row_bytes);
+    if(stream->row == NULL || stream->prev_row == NULL) {
+        LV_LOG_WARN("Out of memory");
+        lv_png_stream_delete(stream);
+        return NULL;
+    }
+
+    if(restart(stream) != LV_RESULT_OK) {
+        lv_png_stream_delete(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+lv_result_t lv_png_stream_read_rows(lv_png_stream_t * stream, uint32_t y, uint32_t row_cnt, uint8_t * buf,
+                                    uint32_t stride)
+{
+    LV_ASSERT_NULL(stream);
+
+    if(y + row_cnt > stream->info.h) return LV_RESULT_INVALID;
+
+    if(y < stream->y) {
+        if(restart(stream) != LV_RESULT_OK) return LV_RESULT_INVALID;
+    }
+
+    /*Rows above `y` are inflated and unfiltered too as the next rows depend on them*/
+    while(stream->y < y + row_cnt) {
+        if(next_row(stream) != LV_RESULT_OK) {
+            LV_LOG_WARN("Corrupted PNG data");
+            stream->y = UINT32_MAX;     /*Restart on the next call*/
+            return LV_RESULT_INVALID;
+        }
+
+        if(stream->y >= y) {
+            convert_row(stream, buf);
+            buf += stride;
+        }
+        stream->y++;
+    }
+
+    return LV_RESULT_OK;
+}
+
+void lv_png_stream_delete(lv_png_stream_t * stream)
+{
+    if(stream == NULL) return;
+
+    lv_free(stream->window);
+    lv_free(stream->row);
+    lv_free(stream->prev_row);
+    lv_free(stream);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline uint32_t read_be32(const uint8_t * buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+static bool input_read(png_input_t * input, void * buf, uint32_t len)
+{
+    if(input->file) {
+        uint32_t rn;
+        if(lv_fs_read(input->file, buf, len, &rn) != LV_FS_RES_OK || rn != len) return false;
+    }
+    else {
+        if(len > input->data_size - input->pos) return false;
+        lv_memcpy(buf, input->data + input->pos, len);
+    }
+
+    input->pos += len;
+    return true;
+}
+
+static bool input_skip(png_input_t * input, uint32_t len)
+{
+    /*Check before moving to not let the position wrap around*/
+    if(input->file) {
+        if(len > UINT32_MAX - input->pos) return false;
+        input->pos += len;
+        return lv_fs_seek(input->file, input->pos, LV_FS_SEEK_SET) == LV_FS_RES_OK;
+    }
+    else {
+        if(len > input->data_size - input->pos) return false;
+        input->pos += len;
+        return true;
+    }
+}
+
+/**
+ * Read the chunks before the image data
+ * @param input     the PNG at its beginning
+ * @param info      store the header here
+ * @param palette   store the palette here or NULL if not required
+ * @return          LV_RESULT_OK: no error; LV_RESULT_INVALID: not a PNG or corrupted
+ */
+static lv_result_t parse_chunks(png_input_t * input, png_info_t * info, lv_color32_t * palette)
+{
+    static const uint8_t magic[] = {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
+    uint8_t buf[13];
+
+    if(!input_read(input, buf, sizeof(magic))) return LV_RESULT_INVALID;
+    if(lv_memcmp(buf, magic, sizeof(magic)) != 0) return LV_RESULT_INVALID;
+
+    lv_memzero(info, sizeof(png_info_t));
+
+    while(1) {
+        /*Length and type of the chunk*/
+        if(!input_read(input, buf, 8)) return LV_RESULT_INVALID;
+        uint32_t len = read_be32(buf);
+        const uint8_t * type = &buf[4];
+        if(len > CHUNK_LEN_MAX) return LV_RESULT_INVALID;
+
+        if(lv_memcmp(type, "IHDR", 4) == 0) {
+            if(len != 13 || !input_read(input, buf, 13)) return LV_RESULT_INVALID;
+            info->w = read_be32(&buf[0]);
+            info->h = read_be32(&buf[4]);
+            info->bit_depth = buf[8];
+            info->color_type = buf[9];
+            info->interlaced = buf[12] != 0;
+            len = 0;
+        }
+        else if(lv_memcmp(type, "PLTE", 4) == 0 && palette) {
+            uint32_t i;
+            for(i = 0; i < len / 3 && i < 256; i++) {
+                if(!input_read(input, buf, 3)) return LV_RESULT_INVALID;
+                palette[i].red = buf[0];
+                palette[i].green = buf[1];
+                palette[i].blue = buf[2];
+            }
+            len -= i * 3;
+        }
+        else if(lv_memcmp(type, "tRNS", 4) == 0) {
+            info->has_trns = true;
+            if(palette && info->color_type == COLOR_TYPE_PALETTE) {
+                uint32_t i;
+                for(i = 0; i < len && i < 256; i++) {
+                    if(!input_read(input, buf, 1)) return LV_RESULT_INVALID;
+                    palette[i].alpha = buf[0];
+                }
+                len -= i;
+            }
+        }
+        else if(lv_memcmp(type, "IDAT", 4) == 0) {
+            if(info->w == 0 || info->h == 0) return LV_RESULT_INVALID;
+            info->idat_pos = input->pos - 8;
+            return LV_RESULT_OK;
+        }
+        else if(lv_memcmp(type, "IEND", 4) == 0) {
+            return LV_RESULT_INVALID;
+        }
+
+        /*Skip the rest of the chunk and the CRC*/
+        if(!input_skip(input, len + 4)) return LV_RESULT_INVALID;
+    }
+}
+
+static lv_color_format_t get_cf(const png_info_t * info)
+{
+    if(info->interlaced) return LV_COLOR_FORMAT_UNKNOWN;
+
+    bool opaque;
+    switch(info->color_type) {
+        case COLOR_TYPE_GRAY:
+        case COLOR_TYPE_RGB:
+            /*Colour key transparency is not supported*/
+            if(info->bit_depth != 8 || info->has_trns) return LV_COLOR_FORMAT_UNKNOWN;
+            opaque = true;
+            break;
+        case COLOR_TYPE_PALETTE:
+            if(info->bit_depth != 1 && info->bit_depth != 2 && info->bit_depth != 4 && info->bit_depth != 8) {
+                return LV_COLOR_FORMAT_UNKNOWN;
+            }
+            opaque = !info->has_trns;
+            break;
+        case COLOR_TYPE_GRAY_ALPHA:
+        case COLOR_TYPE_RGBA:
+            if(info->bit_depth != 8) return LV_COLOR_FORMAT_UNKNOWN;
+            opaque = false;
+            break;
+        default:
+            return LV_COLOR_FORMAT_UNKNOWN;
+    }
+
+#if LV_COLOR_DEPTH == 16
+    if(opaque) return LV_COLOR_FORMAT_RGB565;
+#else
+    LV_UNUSED(opaque);
+#endif
+    return LV_COLOR_FORMAT_ARGB8888;
+}
+
+static uint8_t read_byte(lv_png_stream_t * stream)
+{
+    if(stream->in_idx == stream->in_len) {
+        if(stream->input.file == NULL) return 0;
+        lv_fs_read(stream->input.file, stream->in_buf_file, IN_BUF_SIZE, &stream->in_len);
+        stream->in_idx = 0;
+        if(stream->in_len == 0) return 0;
+    }
+
+    return stream->in_buf[stream->in_idx++];
+}
+
+/**
+ * Get the next byte of the compressed data which can be split into multiple IDAT chunks.
+ * Returns 0 after the last IDAT chunk.
+ */
+static uint8_t read_idat_byte(lv_png_stream_t * stream)
+{
+    while(stream->chunk_left == 0) {
+        if(stream->idat_end) return 0;
+
+        /*CRC of the previous chunk, then the length and type of the next one*/
+        uint8_t buf[12];
+        uint32_t i;
+        for(i = 0; i < sizeof(buf); i++) buf[i] = read_byte(stream);
+        if(lv_memcmp(&buf[8], "IDAT", 4) != 0) {
+            stream->idat_end = true;
+            return 0;
+        }
+        stream->chunk_left = read_be32(&buf[4]);
+    }
+
+    stream->chunk_left--;
+    return read_byte(stream);
+}
+
+static inline uint32_t get_bits(lv_png_stream_t * stream, uint32_t n)
+{
+    while(stream->bit_cnt < n) {
+        stream->bit_buf |= (uint32_t)read_idat_byte(stream) << stream->bit_cnt;
+        stream->bit_cnt += 8;
+    }
+
+    uint32_t v = stream->bit_buf & ((1UL << n) - 1);
+    stream->bit_buf >>= n;
+    stream->bit_cnt -= n;
+    return v;
+}
+
+/**
+ * Decode a symbol
+ * @return  the symbol or -1 on invalid code
+ */
+static inline int32_t huffman_decode(lv_png_stream_t * stream, const huffman_t * h)
+{
+    while(stream->bit_cnt < FAST_BITS) {
+        stream->bit_buf |= (uint32_t)read_idat_byte(stream) << stream->bit_cnt;
+        stream->bit_cnt += 8;
+    }
+
+    uint32_t e = h->fast[stream->bit_buf & ((1 << FAST_BITS) - 1)];
+    if(e) {
+        stream->bit_buf >>= e >> SYM_BITS;
+        stream->bit_cnt -= e >> SYM_BITS;
+        return e & ((1 << SYM_BITS) - 1);
+    }
+
+    /*Longer code, walk the canonical code bit by bit*/
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    uint32_t len;
+    for(len = 1; len <= MAX_BITS; len++) {
+        code |= get_bits(stream, 1);
+        int32_t count = h->count[len];
+        if(code - count < first) return h->symbol[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+static lv_result_t restart(lv_png_stream_t * stream)
+{
+    /*Start at the CRC of the chunk before the first IDAT to handle it like a chunk boundary*/
+    uint32_t start = stream->info.idat_pos - 4;
+    if(stream->input.file) {
+        if(lv_fs_seek(stream->input.file, start, LV_FS_SEEK_SET) != LV_FS_RES_OK) return LV_RESULT_INVALID;
+        stream->in_buf = stream->in_buf_file;
+        stream->in_len = 0;
+        stream->in_idx = 0;
+    }
+    else {
+        stream->in_buf = stream->input.data;
+        stream->in_len = stream->input.data_size;
+        stream->in_idx = start;
+    }
+    stream->chunk_left = 0;
+    stream->idat_end = false;
+
+    stream->bit_buf = 0;
+    stream->bit_cnt = 0;
+    stream->window_pos = 0;
+    stream->copy_len = 0;
+    stream->stored_left = 0;
+    stream->block = BLOCK_NONE;
+    stream->last_block = false;
+
+    /*zlib header*/
+    uint32_t cmf = get_bits(stream, 8);
+    uint32_t flg = get_bits(stream, 8);
+    if((cmf & 0x0f) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+        LV_LOG_WARN("Unsupported zlib stream");
+        return LV_RESULT_INVALID;
+    }
+
+    if(stream->window == NULL) {
+        /*The back references can't point before the beginning of the image data,
+         *so small images need only a small window*/
+        uint64_t raw_size = (uint64_t)(stream->row_bytes + 1) * stream->info.h;
+        uint32_t size = 1UL << ((cmf >> 4) + 8);
+        while(size > 256 && size / 2 >= raw_size) size /= 2;
+
+        stream->window = lv_malloc(size);
+        LV_ASSERT_MALLOC(stream->window);
+        if(stream->window == NULL) return LV_RESULT_INVALID;
+        stream->window_size = size;
+    }
+
+    /*It becomes the previous row of the first row*/
+    lv_memzero(stream->row, stream->row_bytes);
+    stream->y = 0;
+
+    return LV_RESULT_OK;
+}
+
+static inline uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+{
+    int32_t pa = LV_ABS((int32_t)b - c);
+    int32_t pb = LV_ABS((int32_t)a - c);
+    int32_t pc = LV_ABS((int32_t)a + b - c - c);
+
+    if(pa <= pb && pa <= pc) return a;
+    else if(pb <= pc) return b;
+    else return c;
+}
+
+/**
+ * Inflate and unfilter the next row into `stream->row`
+ */
+static lv_result_t next_row(lv_png_stream_t * stream)
+{
+    uint8_t * tmp = stream->prev_row;
+    stream->prev_row = stream->row;
+    stream->row = tmp;
+
+    uint8_t filter;
+    uint32_t n = stream->row_bytes;
+    if(inflate_read(stream, &filter, 1) != 1) return LV_RESULT_INVALID;
+    if(inflate_read(stream, stream->row, n) != n) return LV_RESULT_INVALID;
+
+    uint8_t * row = stream->row;
+    const uint8_t * prev = stream->prev_row;
+    uint32_t bpp = stream->px_bytes;
+    uint32_t i;
+    switch(filter) {
+        case 0:
+            break;
+        case 1: /*Sub*/
+            for(i = bpp; i < n; i++) row[i] += row[i - bpp];
+            break;
+        case 2: /*Up*/
+            for(i = 0; i < n; i++) row[i] += prev[i];
+            break;
+        case 3: /*Average*/
+            for(i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+            for(; i < n; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4: /*Paeth*/
+            for(i = 0; i < bpp; i++) row[i] += prev[i];
+            for(; i < n; i++) row[i] += paeth(row[i - bpp], prev[i], prev[i - bpp]);
+            break;
+        default:
+            return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+static inline uint16_t to_rgb565(uint32_t r, uint32_t g, uint32_t b, uint32_t x, uint32_t y)
+{
+#if LV_LODEPNG_STREAM_DITHER
+    /*Add an ordered threshold below the quantization step of each channel*/
+    uint32_t d = dither_matrix[y & 3][x & 3];
+    r = LV_MIN(r + (d >> 1), 255);
+    g = LV_MIN(g + (d >> 2), 255);
+    b = LV_MIN(b + (d >> 1), 255);
+#else
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+#endif
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+/**
+ * Convert the last unfiltered row to the color format of the stream
+ */
+static void convert_row(lv_png_stream_t * stream, uint8_t * buf)
+{
+    const uint8_t * src = stream->row;
+    lv_color32_t * dest32 = (lv_color32_t *)buf;
+    uint16_t * dest16 = (uint16_t *)buf;
+    bool rgb565 = stream->cf == LV_COLOR_FORMAT_RGB565;
+    uint32_t w = stream->info.w;
+    uint32_t y = stream->y;
+    uint32_t x;
+
+    switch(stream->info.color_type) {
+        case COLOR_TYPE_RGBA:
+            for(x = 0; x < w; x++) {
+                dest32[x].red = src[0];
+                dest32[x].green = src[1];
+                dest32[x].blue = src[2];
+                dest32[x].alpha = src[3];
+                src += 4;
+            }
+            break;
+        case COLOR_TYPE_GRAY_ALPHA:
+            for(x = 0; x < w; x++) {
+                dest32[x].red = src[0];
+                dest32[x].green = src[0];
+                dest32[x].blue = src[0];
+                dest32[x].alpha = src[1];
+                src += 2;
+            }
+            break;
+        case COLOR_TYPE_RGB:
+            for(x = 0; x < w; x++) {
+                if(rgb565) {
+                    dest16[x] = to_rgb565(src[0], src[1], src[2], x, y);
+                }
+                else {
+                    dest32[x].red = src[0];
+                    dest32[x].green = src[1];
+                    dest32[x].blue = src[2];
+                    dest32[x].alpha = 0xff;
+                }
+                src += 3;
+            }
+            break;
+        case COLOR_TYPE_GRAY:
+            for(x = 0; x < w; x++) {
+                if(rgb565) {
+                    dest16[x] = to_rgb565(src[x], src[x], src[x], x, y);
+                }
+                else {
+                    dest32[x].red = src[x];
+                    dest32[x].green = src[x];
+                    dest32[x].blue = src[x];
+                    dest32[x].alpha = 0xff;
+                }
+            }
+            break;
+        case COLOR_TYPE_PALETTE: {
+                uint32_t depth = stream->info.bit_depth;
+                uint32_t mask = (1 << depth) - 1;
+                for(x = 0; x < w; x++) {
+                    uint32_t bit = x * depth;
+                    uint32_t index = (src[bit >> 3] >> (8 - depth - (bit & 7))) & mask;
+                    lv_color32_t c = stream->palette[index];
+                    if(rgb565) dest16[x] = to_rgb565(c.red, c.green, c.blue, x, y);
+                    else dest32[x] = c;
+                }
+                break;
+            }
+        default:
+            break;
+    }
+}
+
+static inline void put_byte(lv_png_stream_t * stream, uint8_t * out, uint8_t b)
+{
+    stream->window[stream->window_pos++ & (stream->window_size - 1)] = b;
+    *out = b;
+}
+
+/**
+ * Inflate the next bytes of the image data. Can stop anywhere and continue with the next call.
+ * @param stream    pointer to a stream
+ * @param out       store the bytes here
+ * @param len       number of bytes to inflate
+ * @return          number of inflated bytes. Less than `len` on error or at the end of the data.
+ */
+static uint32_t inflate_read(lv_png_stream_t * stream, uint8_t * out, uint32_t len)
+{
+    uint32_t mask = stream->window_size - 1;
+    uint32_t done = 0;
+
+    while(done < len) {
+        if(stream->copy_len) {
+            uint32_t cnt = LV_MIN(stream->copy_len, len - done);
+            uint32_t from = stream->window_pos - stream->copy_dist;
+            stream->copy_len -= cnt;
+            while(cnt) {
+                put_byte(stream, &out[done], stream->window[from & mask]);
+                from++;
+                done++;
+                cnt--;
+            }
+        }
+        else if(stream->block == BLOCK_HUFFMAN) {
+            int32_t sym = huffman_decode(stream, &stream->len_code);
+            if(sym < 0) return done;
+
+            if(sym < 256) {
+                put_byte(stream, &out[done], (uint8_t)sym);
+                done++;
+            }
+            else if(sym == 256) {
+                stream->block = BLOCK_NONE;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return done;
+                uint32_t copy_len = len_base[sym] + get_bits(stream, len_extra[sym]);
+
+                int32_t dist_sym = huffman_decode(stream, &stream->dist_code);
+                if(dist_sym < 0 || dist_sym >= MAX_DIST_SYMS) return done;
+                uint32_t dist = dist_base[dist_sym] + get_bits(stream, dist_extra[dist_sym]);
+                if(dist > stream->window_pos || dist > stream->window_size) return done;
+
+                stream->copy_len = copy_len;
+                stream->copy_dist = dist;
+            }
+        }
+        else if(stream->block == BLOCK_STORED) {
+            if(stream->stored_left == 0) {
+                stream->block = BLOCK_NONE;
+            }
+            else {
+                put_byte(stream, &out[done], (uint8_t)get_bits(stream, 8));
+                done++;
+                stream->stored_left--;
+            }
+        }
+        else {
+            if(stream->last_block) return done;
+            if(next_block(stream) != LV_RESULT_OK) return done;
+        }
+    }
+
+    return done;
+}
+
+static lv_result_t next_block(lv_png_stream_t * stream)
+{
+    stream->last_block = get_bits(stream, 1);
+
+    switch(get_bits(stream, 2)) {
+        case 0: {
+                /*Stored: skip to a byte boundary*/
+                get_bits(stream, stream->bit_cnt & 7);
+                uint32_t len = get_bits(stream, 16);
+                uint32_t nlen = get_bits(stream, 16);
+                if(len != (~nlen & 0xffff)) return LV_RESULT_INVALID;
+                stream->stored_left = len;
+                stream->block = BLOCK_STORED;
+                return LV_RESULT_OK;
+            }
+        case 1: {
+                uint8_t lengths[MAX_LEN_SYMS];
+                lv_memset(&lengths[0], 8, 144);
+                lv_memset(&lengths[144], 9, 112);
+                lv_memset(&lengths[256], 7, 24);
+                lv_memset(&lengths[280], 8, 8);
+                huffman_build(&stream->len_code, lengths, MAX_LEN_SYMS);
+                lv_memset(lengths, 5, MAX_DIST_SYMS);
+                huffman_build(&stream->dist_code, lengths, MAX_DIST_SYMS);
+                stream->block = BLOCK_HUFFMAN;
+                return LV_RESULT_OK;
+            }
+        case 2:
+            if(read_dynamic_codes(stream) != LV_RESULT_OK) return LV_RESULT_INVALID;
+            stream->block = BLOCK_HUFFMAN;
+            return LV_RESULT_OK;
+        default:
+            return LV_RESULT_INVALID;
+    }
+}
+
+static lv_result_t read_dynamic_codes(lv_png_stream_t * stream)
+{
+    static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    uint8_t lengths[MAX_LEN_SYMS + MAX_DIST_SYMS];
+
+    uint32_t len_cnt = get_bits(stream, 5) + 257;
+    uint32_t dist_cnt = get_bits(stream, 5) + 1;
+    uint32_t code_cnt = get_bits(stream, 4) + 4;
+    if(len_cnt > 286 || dist_cnt > MAX_DIST_SYMS) return LV_RESULT_INVALID;
+
+    /*The code lengths are Huffman coded too. Use `dist_code` for that code temporarily.*/
+    uint32_t i;
+    for(i = 0; i < 19; i++) lengths[order[i]] = i < code_cnt ? (uint8_t)get_bits(stream, 3) : 0;
+    if(huffman_build(&stream->dist_code, lengths, 19) != LV_RESULT_OK) return LV_RESULT_INVALID;
+
+    i = 0;
+    while(i < len_cnt + dist_cnt) {
+        int32_t sym = huffman_decode(stream, &stream->dist_code);
+        if(sym < 0) return LV_RESULT_INVALID;
+
+        if(sym < 16) {
+            lengths[i++] = (uint8_t)sym;
+            continue;
+        }
+
+        uint8_t len = 0;
+        uint32_t repeat;
+        if(sym == 16) {
+            if(i == 0) return LV_RESULT_INVALID;
+            len = lengths[i - 1];
+            repeat = 3 + get_bits(stream, 2);
+        }
+        else if(sym == 17) {
+            repeat = 3 + get_bits(stream, 3);
+        }
+        else {
+            repeat = 11 + get_bits(stream, 7);
+        }
+
+        if(i + repeat > len_cnt + dist_cnt) return LV_RESULT_INVALID;
+        lv_memset(&lengths[i], len, repeat);
+        i += repeat;
+    }
+
+    /*The end of block code is required*/
+    if(lengths[256] == 0) return LV_RESULT_INVALID;
+
+    if(huffman_build(&stream->len_code, lengths, len_cnt) != LV_RESULT_OK) return LV_RESULT_INVALID;
+    if(huffman_build(&stream->dist_code, &lengths[len_cnt], dist_cnt) != LV_RESULT_OK) return LV_RESULT_INVALID;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Build the canonical Huffman code from the code lengths
+ * @param h         store the code here
+ * @param lengths   code length of each symbol. 0: unused symbol
+ * @param sym_cnt   number of symbols
+ * @return          LV_RESULT_OK: no error; LV_RESULT_INVALID: over-subscribed code
+ */
+static lv_result_t huffman_build(huffman_t * h, const uint8_t * lengths, uint32_t sym_cnt)
+{
+    uint16_t offs[MAX_BITS + 1];
+    uint32_t sym;
+    uint32_t len;
+
+    lv_memzero(h->count, sizeof(h->count));
+    lv_memzero(h->fast, sizeof(h->fast));
+    for(sym = 0; sym < sym_cnt; sym++) h->count[lengths[sym]]++;
+    h->count[0] = 0;
+
+    /*Incomplete codes are accepted, the unused codes are invalid in `huffman_decode`*/
+    int32_t left = 1;
+    for(len = 1; len <= MAX_BITS; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if(left < 0) return LV_RESULT_INVALID;
+    }
+
+    offs[1] = 0;
+    for(len = 1; len < MAX_BITS; len++) offs[len + 1] = offs[len] + h->count[len];
+    for(sym = 0; sym < sym_cnt; sym++) {
+        if(lengths[sym]) h->symbol[offs[lengths[sym]]++] = (uint16_t)sym;
+    }
+
+    /*The codes are stored from the MSB so index the lookup table with the reversed codes*/
+    uint32_t code = 0;
+    uint32_t index = 0;
+    for(len = 1; len <= FAST_BITS; len++) {
+        uint32_t i;
+        for(i = 0; i < h->count[len]; i++) {
+            uint32_t rev = 0;
+            uint32_t b;
+            for(b = 0; b < len; b++) rev |= ((code >> b) & 1) << (len - 1 - b);
+
+            uint16_t e = (uint16_t)((len << SYM_BITS) | h->symbol[index]);
+            for(; rev < (1 << FAST_BITS); rev += 1 << len) h->fast[rev] = e;
+
+            code++;
+            index++;
+        }
+        code <<= 1;
+    }
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_USE_LODEPNG && LV_LODEPNG_STREAM*/
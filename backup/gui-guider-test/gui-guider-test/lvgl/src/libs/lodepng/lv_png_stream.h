@@ -0,0 +1,90 @@
+/**
+ * @file lv_png_stream.h
+ *
+ */
+
+#ifndef LV_PNG_STREAM_H
+#define LV_PNG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#if LV_USE_LODEPNG && LV_LODEPNG_STREAM
+
+#include "../../misc/lv_fs.h"
+#include "../../misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct lv_png_stream_t lv_png_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the color format a PNG is decoded to row by row.
+ * Opaque images are decoded to RGB565 if LV_COLOR_DEPTH is 16, the others to ARGB8888.
+ * @param file          an opened PNG file or NULL to use `data`
+ * @param data          the PNG data if `file` is NULL
+ * @param data_size     size of `data` in bytes
+ * @return              the color format or LV_COLOR_FORMAT_UNKNOWN if the PNG can't be decoded row by row
+ *                      (interlaced, 16 bit or colour key transparency)
+ */
+lv_color_format_t lv_png_stream_get_cf(lv_fs_file_t * file, const uint8_t * data, uint32_t data_size);
+
+/**
+ * Prepare a PNG to be decoded row by row.
+ * Only the rows being decoded and the LZ77 window are kept in the memory.
+ * @param file          an opened PNG file or NULL to use `data`. It should be kept open until the stream is deleted.
+ * @param data          the PNG data if `file` is NULL
+ * @param data_size     size of `data` in bytes
+ * @param cf            the color format returned by `lv_png_stream_get_cf` when the header was read
+ * @param w             the width read from the header
+ * @param h             the height read from the header
+ * @return              the new stream or NULL if the PNG can't be decoded row by row to `cf` in the given size
+ */
+lv_png_stream_t * lv_png_stream_create(lv_fs_file_t * file, const uint8_t * data, uint32_t data_size,
+                                       lv_color_format_t cf, uint32_t w, uint32_t h);
+
+/**
+ * Decode rows in the color format returned by `lv_png_stream_get_cf`.
+ * The rows should be read from top to bottom, going back restarts the decoding from the first row.
+ * @param stream        pointer to a stream
+ * @param y             index of the first row to decode
+ * @param row_cnt       number of rows to decode
+ * @param buf           store the rows here
+ * @param stride        the distance between the rows in `buf` in bytes
+ * @return              LV_RESULT_OK: no error; LV_RESULT_INVALID: the data is corrupted
+ */
+lv_result_t lv_png_stream_read_rows(lv_png_stream_t * stream, uint32_t y, uint32_t row_cnt, uint8_t * buf,
+                                    uint32_t stride);
+
+/**
+ * Free a stream. The file passed to `lv_png_stream_create` is not closed.
+ * @param stream        pointer to a stream
+ */
+void lv_png_stream_delete(lv_png_stream_t * stream);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_LODEPNG && LV_LODEPNG_STREAM*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PNG_STREAM_H*/
@@ -28,6 +28,20 @@
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    JDEC jd;
+    lv_cache_entry_t * rst_index;       /*Positions of the restart markers or NULL if not known*/
+} tjpgd_data_t;
+
+#if LV_TJPGD_RST_INDEX_CNT
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    uint32_t * marker_pos;              /*File position of each restart marker*/
+    uint32_t marker_cnt;
+} rst_index_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -39,6 +53,13 @@ static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
+static lv_result_t decoder_seek(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, uint32_t mcu_row,
+                                bool fresh, lv_area_t * decoded_area);
+#if LV_TJPGD_RST_INDEX_CNT
+    static lv_cache_compare_res_t rst_index_compare_cb(const rst_index_t * lhs, const rst_index_t * rhs);
+    static bool rst_index_create_cb(rst_index_t * node, JDEC * jd);
+    static void rst_index_free_cb(rst_index_t * node, void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -61,6 +82,16 @@ void lv_tjpgd_init(void)
     lv_image_decoder_set_close_cb(dec, decoder_close);
 
     dec->name = DECODER_NAME;
+
+#if LV_TJPGD_RST_INDEX_CNT
+    dec->user_data = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(rst_index_t), LV_TJPGD_RST_INDEX_CNT,
+    (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)rst_index_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)rst_index_create_cb,
+        .free_cb = (lv_cache_free_cb_t)rst_index_free_cb,
+    });
+    if(dec->user_data) lv_cache_set_name(dec->user_data, "TJPGD_RST_INDEX");
+#endif
 }
 
 void lv_tjpgd_deinit(void)
@@ -68,6 +99,7 @@ void lv_tjpgd_deinit(void)
     lv_image_decoder_t * dec = NULL;
     while((dec = lv_image_decoder_get_next(dec)) != NULL) {
         if(dec->info_cb == decoder_info) {
+            if(dec->user_data) lv_cache_destroy(dec->user_data, NULL);
             lv_image_decoder_delete(dec);
             break;
         }
@@ -152,7 +184,6 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
  */
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
-    LV_UNUSED(decoder);
     lv_fs_file_t * f = lv_malloc(sizeof(lv_fs_file_t));
     if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
 #if LV_USE_FS_MEMFS
@@ -185,8 +216,9 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     }
 
     uint8_t * workb_temp = lv_malloc(TJPGD_WORKBUFF_SIZE);
-    JDEC * jd = lv_malloc(sizeof(JDEC));
-    dsc->user_data = jd;
+    tjpgd_data_t * data = lv_malloc_zeroed(sizeof(tjpgd_data_t));
+    JDEC * jd = &data->jd;
+    dsc->user_data = data;
     JRESULT rc = jd_prepare(jd, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, f);
     if(rc) return LV_RESULT_INVALID;
 
@@ -197,80 +229,92 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     if(rc != JDR_OK) {
         lv_free(workb_temp);
-        lv_free(jd);
+        lv_free(data);
         return LV_RESULT_INVALID;
     }
 
+#if LV_TJPGD_RST_INDEX_CNT
+    /*Find the restart markers once to start decoding at any of them later*/
+    if(jd->nrst && decoder->user_data) {
+        rst_index_t search_key = {
+            .src = dsc->src,
+            .src_type = dsc->src_type,
+        };
+        data->rst_index = lv_cache_acquire_or_create(decoder->user_data, &search_key, jd);
+    }
+#else
+    LV_UNUSED(decoder);
+#endif
+
     return LV_RESULT_OK;
 }
 
 static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
                                     const lv_area_t * full_area, lv_area_t * decoded_area)
 {
-    LV_UNUSED(decoder);
-    LV_UNUSED(full_area);
-
-    JDEC * jd = dsc->user_data;
+    tjpgd_data_t * data = dsc->user_data;
+    JDEC * jd = &data->jd;
     lv_draw_buf_t * decoded = (void *)dsc->decoded;
 
-    uint32_t  mx, my;
+    int32_t mx, my;
     mx = jd->msx * 8;
     my = jd->msy * 8;         /* Size of the MCU (pixel) */
     if(decoded_area->y1 == LV_COORD_MIN) {
-        decoded_area->y1 = 0;
-        decoded_area->y2 = my - 1;
-        decoded_area->x1 = -((int32_t)mx);
-        decoded_area->x2 = -1;
-        jd->scale = 0;
-        jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
-        jd->rst = 0;
-        jd->rsc = 0;
+        bool fresh = decoded == NULL;
         if(decoded == NULL) {
             decoded = lv_malloc_zeroed(sizeof(lv_draw_buf_t));
             dsc->decoded = decoded;
         }
-        else {
-            lv_fs_seek(jd->device, 0, LV_FS_SEEK_SET);
-            JRESULT rc = jd_prepare(jd, input_func, jd->pool_original, (size_t)TJPGD_WORKBUFF_SIZE, jd->device);
-            if(rc) return LV_RESULT_INVALID;
+
+        /*Start at the MCU row of the first row to draw, or as close to it as possible*/
+        if(decoder_seek(decoder, dsc, full_area->y1 / my, fresh, decoded_area) != LV_RESULT_OK) {
+            return LV_RESULT_INVALID;
         }
+
         decoded->data = jd->workbuf;
         decoded->header = dsc->header;
     }
 
-    decoded_area->x1 += mx;
-    decoded_area->x2 += mx;
+    /*Load the MCUs one by one, but convert only the ones on the area to draw*/
+    while(1) {
+        decoded_area->x1 += mx;
+        if(decoded_area->x1 >= jd->width) {
+            decoded_area->x1 = 0;
+            decoded_area->y1 += my;
+        }
 
-    if(decoded_area->x1 >= jd->width) {
-        decoded_area->x1 = 0;
-        decoded_area->x2 = mx - 1;
-        decoded_area->y1 += my;
-        decoded_area->y2 += my;
-    }
+        if(decoded_area->y1 >= jd->height || decoded_area->y1 > full_area->y2) return LV_RESULT_INVALID;
 
-    if(decoded_area->x2 >= jd->width) decoded_area->x2 = jd->width - 1;
-    if(decoded_area->y2 >= jd->height) decoded_area->y2 = jd->height - 1;
+        decoded_area->x2 = LV_MIN(decoded_area->x1 + mx - 1, jd->width - 1);
+        decoded_area->y2 = LV_MIN(decoded_area->y1 + my - 1, jd->height - 1);
 
-    decoded->header.w = lv_area_get_width(decoded_area);
-    decoded->header.h = lv_area_get_height(decoded_area);
-    decoded->header.stride = decoded->header.w * 3;
-    decoded->data_size = decoded->header.stride * decoded->header.h;
+        /* Process restart interval if enabled */
+        JRESULT rc;
+        if(jd->nrst && jd->rst++ == jd->nrst) {
+            rc = jd_restart(jd, jd->rsc++);
+            if(rc != JDR_OK) return LV_RESULT_INVALID;
+            jd->rst = 1;
+        }
 
-    /* Process restart interval if enabled */
-    JRESULT rc;
-    if(jd->nrst && jd->rst++ == jd->nrst) {
-        rc = jd_restart(jd, jd->rsc++);
+        /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+        rc = jd_mcu_load(jd);
         if(rc != JDR_OK) return LV_RESULT_INVALID;
-        jd->rst = 1;
-    }
 
-    /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
-    rc = jd_mcu_load(jd);
-    if(rc != JDR_OK) return LV_RESULT_INVALID;
+        if(decoded_area->y2 < full_area->y1 || decoded_area->x2 < full_area->x1 || decoded_area->x1 > full_area->x2) {
+            continue;
+        }
 
-    /* Output the MCU (YCbCr to RGB, scaling and output) */
-    rc = jd_mcu_output(jd, NULL, decoded_area->x1, decoded_area->y1);
-    if(rc != JDR_OK) return LV_RESULT_INVALID;
+        /* Output the MCU (YCbCr to RGB, scaling and output) */
+        rc = jd_mcu_output(jd, NULL, decoded_area->x1, decoded_area->y1);
+        if(rc != JDR_OK) return LV_RESULT_INVALID;
+
+        break;
+    }
+
+    decoded->header.w = lv_area_get_width(decoded_area);
+    decoded->header.h = lv_area_get_height(decoded_area);
+    decoded->header.stride = decoded->header.w * 3;
+    decoded->data_size = decoded->header.stride * decoded->header.h;
 
     return LV_RESULT_OK;
 }
@@ -282,12 +326,13 @@ static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
  */
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
-    LV_UNUSED(decoder);
-    JDEC * jd = dsc->user_data;
+    tjpgd_data_t * data = dsc->user_data;
+    JDEC * jd = &data->jd;
+    if(data->rst_index) lv_cache_release(decoder->user_data, data->rst_index, NULL);
     lv_fs_close(jd->device);
     lv_free(jd->device);
     lv_free(jd->pool_original);
-    lv_free(jd);
+    lv_free(data);
     lv_free((void *)dsc->decoded);
 }
 
@@ -298,4 +343,178 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
     return memcmp(jpg_signature, raw_data, sizeof(jpg_signature)) == 0;
 }
 
+/**
+ * Prepare to decode from the start of an MCU row. If the restart markers are known
+ * decoding starts from the last restart marker before the row, else from the beginning.
+ * @param decoder       pointer to the decoder
+ * @param dsc           pointer to the decoder descriptor
+ * @param mcu_row       index of the MCU row to decode
+ * @param fresh         true: nothing is decoded since `jd_prepare()`
+ * @param decoded_area  set to the MCU before the first MCU to decode
+ * @return              LV_RESULT_OK: ready to decode; LV_RESULT_INVALID: error
+ */
+static lv_result_t decoder_seek(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, uint32_t mcu_row,
+                                bool fresh, lv_area_t * decoded_area)
+{
+    tjpgd_data_t * data = dsc->user_data;
+    JDEC * jd = &data->jd;
+    uint32_t mx = jd->msx * 8;
+    uint32_t my = jd->msy * 8;
+    uint32_t mcu_per_row = (jd->width + mx - 1) / mx;
+    uint32_t marker = 0;    /*Number of restart markers to skip*/
+
+#if LV_TJPGD_RST_INDEX_CNT
+    if(data->rst_index) {
+        rst_index_t * index = lv_cache_entry_get_data(data->rst_index);
+        marker = LV_MIN(mcu_row * mcu_per_row / jd->nrst, index->marker_cnt);
+    }
+
+    if(marker > 0) {
+        rst_index_t * index = lv_cache_entry_get_data(data->rst_index);
+        lv_fs_seek(jd->device, index->marker_pos[marker - 1], LV_FS_SEEK_SET);
+        jd->dctr = 0;   /*Drop the buffered data, the input buffer will be read again from the marker*/
+        jd->dbit = 0;
+#if JD_FASTDECODE >= 1
+        jd->wreg = 0;
+        jd->marker = 0;
+#endif
+
+        /*Also checks that the file hasn't changed since the markers were found*/
+        if(jd_restart(jd, marker - 1) == JDR_OK) {
+            jd->rst = 0;
+            jd->rsc = marker;
+        }
+        else {
+            LV_LOG_WARN("Restart marker not found, decoding from the beginning");
+            lv_cache_drop(decoder->user_data, index, NULL);
+            lv_cache_release(decoder->user_data, data->rst_index, NULL);
+            data->rst_index = NULL;
+            marker = 0;
+            fresh = false;
+        }
+    }
+#else
+    LV_UNUSED(decoder);
+    LV_UNUSED(mcu_row);
+#endif
+
+    uint32_t mcu = marker * jd->nrst;   /*Index of the first MCU to decode*/
+    if(marker == 0) {
+        jd->scale = 0;
+        jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
+        jd->rst = 0;
+        jd->rsc = 0;
+        if(!fresh) {
+            lv_fs_seek(jd->device, 0, LV_FS_SEEK_SET);
+            JRESULT rc = jd_prepare(jd, input_func, jd->pool_original, (size_t)TJPGD_WORKBUFF_SIZE, jd->device);
+            if(rc) return LV_RESULT_INVALID;
+        }
+    }
+
+    decoded_area->x1 = (int32_t)((mcu % mcu_per_row) * mx) - (int32_t)mx;
+    decoded_area->y1 = (mcu / mcu_per_row) * my;
+
+    return LV_RESULT_OK;
+}
+
+#if LV_TJPGD_RST_INDEX_CNT
+
+static lv_cache_compare_res_t rst_index_compare_cb(const rst_index_t * lhs, const rst_index_t * rhs)
+{
+    if(lhs->src_type != rhs->src_type) {
+        return lhs->src_type > rhs->src_type ? 1 : -1;
+    }
+
+    if(lhs->src_type == LV_IMAGE_SRC_FILE) {
+        int32_t cmp_res = lv_strcmp(lhs->src, rhs->src);
+        if(cmp_res != 0) {
+            return cmp_res > 0 ? 1 : -1;
+        }
+    }
+    else if(lhs->src != rhs->src) {
+        return lhs->src > rhs->src ? 1 : -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Scan the compressed data for the restart markers. The position of the file is restored afterwards.
+ */
+static bool rst_index_create_cb(rst_index_t * node, JDEC * jd)
+{
+    lv_fs_file_t * f = jd->device;
+    uint32_t mx = jd->msx * 8;
+    uint32_t my = jd->msy * 8;
+    uint32_t mcu_cnt = ((jd->width + mx - 1) / mx) * ((jd->height + my - 1) / my);
+    uint32_t marker_max = (mcu_cnt - 1) / jd->nrst;
+    if(marker_max == 0) return false;
+
+    uint32_t pos;
+    if(lv_fs_tell(f, &pos) != LV_FS_RES_OK) return false;
+
+    node->marker_pos = lv_malloc(marker_max * sizeof(uint32_t));
+    uint8_t * buf = lv_malloc(JD_SZBUF);
+    if(node->marker_pos == NULL || buf == NULL) {
+        lv_free(node->marker_pos);
+        lv_free(buf);
+        return false;
+    }
+
+    /*The compressed data starts at the unread part of the input buffer*/
+    uint32_t buf_pos = pos - (uint32_t)jd->dctr;
+    uint32_t cnt = 0;
+    bool prev_ff = false;
+    bool end = false;
+    lv_fs_seek(f, buf_pos, LV_FS_SEEK_SET);
+    while(!end && cnt < marker_max) {
+        uint32_t rn;
+        if(lv_fs_read(f, buf, JD_SZBUF, &rn) != LV_FS_RES_OK || rn == 0) break;
+
+        uint32_t i;
+        for(i = 0; i < rn && cnt < marker_max; i++) {
+            uint8_t b = buf[i];
+            if(prev_ff && b >= 0xD0 && b <= 0xD7) {
+                /*The markers are numbered 0..7 cyclically*/
+                if((b & 0x7) != (cnt & 0x7)) {
+                    end = true;
+                    break;
+                }
+                node->marker_pos[cnt] = buf_pos + i - 1;
+                cnt++;
+            }
+            else if(prev_ff && b != 0x00 && b != 0xFF) {
+                end = true; /*EOI or other marker*/
+                break;
+            }
+            prev_ff = b == 0xFF;
+        }
+        buf_pos += rn;
+    }
+
+    lv_free(buf);
+    lv_fs_seek(f, pos, LV_FS_SEEK_SET);
+
+    node->marker_cnt = cnt;
+    if(node->src_type == LV_IMAGE_SRC_FILE) {
+        node->src = lv_strdup(node->src);
+        if(node->src == NULL) {
+            lv_free(node->marker_pos);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void rst_index_free_cb(rst_index_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->marker_pos);
+    if(node->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)node->src);
+}
+
+#endif /*LV_TJPGD_RST_INDEX_CNT*/
+
 #endif /*LV_USE_TJPGD*/
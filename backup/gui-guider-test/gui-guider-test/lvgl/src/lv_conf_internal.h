@@ -212,6 +212,48 @@
             #endif
         #endif
     #endif
+
+    /*With an OS keep small freed blocks in per thread lists in front of TLSF.
+     *Most of the small allocations won't take the heap lock then. Needs thread local storage.*/
+    #ifndef LV_MEM_THREAD_CACHE
+        #ifdef CONFIG_LV_MEM_THREAD_CACHE
+            #define LV_MEM_THREAD_CACHE CONFIG_LV_MEM_THREAD_CACHE
+        #else
+            #define LV_MEM_THREAD_CACHE 0
+        #endif
+    #endif
+    #if LV_MEM_THREAD_CACHE
+        /*Storage class specifier of thread local variables. E.g. `__thread` or `_Thread_local`*/
+        #ifndef LV_MEM_THREAD_CACHE_TLS
+            #ifdef CONFIG_LV_MEM_THREAD_CACHE_TLS
+                #define LV_MEM_THREAD_CACHE_TLS CONFIG_LV_MEM_THREAD_CACHE_TLS
+            #else
+                #define LV_MEM_THREAD_CACHE_TLS __thread
+            #endif
+        #endif
+    #endif
+
+    /*Max number of tagged regions (e.g. internal SRAM, PSRAM) added by `lv_mem_add_region()`.
+     *Each region is a separate TLSF heap and `lv_malloc_tagged()` places the data by its tag.
+     *0: use only the LV_MEM_SIZE heap*/
+    #ifndef LV_MEM_REGION_CNT
+        #ifdef CONFIG_LV_MEM_REGION_CNT
+            #define LV_MEM_REGION_CNT CONFIG_LV_MEM_REGION_CNT
+        #else
+            #define LV_MEM_REGION_CNT 0
+        #endif
+    #endif
+    #if LV_MEM_REGION_CNT
+        /*Accumulate the simulated access cost of the regions set by `lv_mem_region_set_sim_latency()`.
+         *Allows benchmarking the placement policy on a PC where all the RAM is equally fast.*/
+        #ifndef LV_MEM_REGION_SIM
+            #ifdef CONFIG_LV_MEM_REGION_SIM
+                #define LV_MEM_REGION_SIM CONFIG_LV_MEM_REGION_SIM
+            #else
+                #define LV_MEM_REGION_SIM 0
+            #endif
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -237,6 +279,60 @@
     #endif
 #endif
 
+/*Keep the timers in a binary heap ordered by their next run time.
+ *`lv_timer_handler()` runs only the ready timers and knows the time until the next one without walking all timers.
+ *Worth it with many timers. Costs 8 bytes per timer and an array of pointers.*/
+#ifndef LV_USE_TIMER_HEAP
+    #ifdef CONFIG_LV_USE_TIMER_HEAP
+        #define LV_USE_TIMER_HEAP CONFIG_LV_USE_TIMER_HEAP
+    #else
+        #define LV_USE_TIMER_HEAP 0
+    #endif
+#endif
+
+/*Keep the running animations in an array and look up the built-in eases from tables computed on first use.
+ *A per target counter lets starting and deleting skip the scan when the target has no other animations.
+ *Worth it with many animations. Costs about 2 kB, 2 kB per used ease and 4 bytes per animation.*/
+#ifndef LV_USE_ANIM_BATCH
+    #ifdef CONFIG_LV_USE_ANIM_BATCH
+        #define LV_USE_ANIM_BATCH CONFIG_LV_USE_ANIM_BATCH
+    #else
+        #define LV_USE_ANIM_BATCH 0
+    #endif
+#endif
+
+/*In LV_DISPLAY_RENDER_MODE_DIRECT move the already rendered pixels of a scrolled widget in the frame buffer
+ *and render only the newly exposed part. Used only if the widget's class sets `scroll_blit` (`lv_obj` and `lv_list`),
+ *it has no custom draw event handlers, an opaque, plain background and nothing is drawn above it.*/
+#ifndef LV_USE_SCROLL_BLIT
+    #ifdef CONFIG_LV_USE_SCROLL_BLIT
+        #define LV_USE_SCROLL_BLIT CONFIG_LV_USE_SCROLL_BLIT
+    #else
+        #define LV_USE_SCROLL_BLIT 0
+    #endif
+#endif
+
+/*Allow rendering into more than 2 buffers in LV_DISPLAY_RENDER_MODE_PARTIAL with `lv_display_set_buffer_ring()`.
+ *The rendered buffers are queued and flushed one after the other while the next ones are rendered,
+ *so rendering waits only if all the buffers are queued or being flushed.*/
+#ifndef LV_USE_DISPLAY_BUF_RING
+    #ifdef CONFIG_LV_USE_DISPLAY_BUF_RING
+        #define LV_USE_DISPLAY_BUF_RING CONFIG_LV_USE_DISPLAY_BUF_RING
+    #else
+        #define LV_USE_DISPLAY_BUF_RING 0
+    #endif
+#endif
+#if LV_USE_DISPLAY_BUF_RING
+    /*Max number of buffers in the ring*/
+    #ifndef LV_DISPLAY_BUF_RING_MAX
+        #ifdef CONFIG_LV_DISPLAY_BUF_RING_MAX
+            #define LV_DISPLAY_BUF_RING_MAX CONFIG_LV_DISPLAY_BUF_RING_MAX
+        #else
+            #define LV_DISPLAY_BUF_RING_MAX 4
+        #endif
+    #endif
+#endif
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -311,6 +407,58 @@
     #endif
 #endif
 
+/*Keep the freed draw buffers (layers, snapshots, decoded images) in a pool and reuse them
+ *for buffers of similar size instead of allocating and freeing them again and again.
+ *The render buffers and the images of the image cache are reused only for their own kind.*/
+#ifndef LV_USE_DRAW_BUF_POOL
+    #ifdef CONFIG_LV_USE_DRAW_BUF_POOL
+        #define LV_USE_DRAW_BUF_POOL CONFIG_LV_USE_DRAW_BUF_POOL
+    #else
+        #define LV_USE_DRAW_BUF_POOL                    0
+    #endif
+#endif
+#if LV_USE_DRAW_BUF_POOL
+    /*Max total size of the idle buffers kept in the pool*/
+    #ifndef LV_DRAW_BUF_POOL_SIZE
+        #ifdef CONFIG_LV_DRAW_BUF_POOL_SIZE
+            #define LV_DRAW_BUF_POOL_SIZE CONFIG_LV_DRAW_BUF_POOL_SIZE
+        #else
+            #define LV_DRAW_BUF_POOL_SIZE               (64 * 1024)     /*[bytes]*/
+        #endif
+    #endif
+
+    /*Free the buffers which weren't reused for this long*/
+    #ifndef LV_DRAW_BUF_POOL_TRIM_TIME
+        #ifdef CONFIG_LV_DRAW_BUF_POOL_TRIM_TIME
+            #define LV_DRAW_BUF_POOL_TRIM_TIME CONFIG_LV_DRAW_BUF_POOL_TRIM_TIME
+        #else
+            #define LV_DRAW_BUF_POOL_TRIM_TIME          1000            /*[ms]*/
+        #endif
+    #endif
+#endif
+
+/*Keep the draw tasks of the display's layer queued until an area is ready, and before drawing them
+ *skip or clip the tasks which are covered by later opaque fills or opaque images.
+ *Not used with `LV_DRAW_TRANSFORM_USE_MATRIX`.*/
+#ifndef LV_USE_DRAW_OCCLUSION_CULL
+    #ifdef CONFIG_LV_USE_DRAW_OCCLUSION_CULL
+        #define LV_USE_DRAW_OCCLUSION_CULL CONFIG_LV_USE_DRAW_OCCLUSION_CULL
+    #else
+        #define LV_USE_DRAW_OCCLUSION_CULL              0
+    #endif
+#endif
+#if LV_USE_DRAW_OCCLUSION_CULL
+    /*Max number of draw tasks to keep queued. When reached, the queued tasks are culled and drawn
+     *to free their memory, but they can't be culled by the draw tasks added later.*/
+    #ifndef LV_DRAW_OCCLUSION_CULL_TASK_MAX
+        #ifdef CONFIG_LV_DRAW_OCCLUSION_CULL_TASK_MAX
+            #define LV_DRAW_OCCLUSION_CULL_TASK_MAX CONFIG_LV_DRAW_OCCLUSION_CULL_TASK_MAX
+        #else
+            #define LV_DRAW_OCCLUSION_CULL_TASK_MAX     64
+        #endif
+    #endif
+#endif
+
 /*Using matrix for transformations.
  *Requirements:
     `LV_USE_MATRIX = 1`.
@@ -337,6 +485,36 @@
     #endif
 #endif
 
+/*Keep the buffers of the drawn layers and reuse them for the next layers
+ *instead of allocating a new buffer for every layer in every refresh.*/
+#ifndef LV_USE_DRAW_LAYER_BUF_REUSE
+    #ifdef CONFIG_LV_USE_DRAW_LAYER_BUF_REUSE
+        #define LV_USE_DRAW_LAYER_BUF_REUSE CONFIG_LV_USE_DRAW_LAYER_BUF_REUSE
+    #else
+        #define LV_USE_DRAW_LAYER_BUF_REUSE             0
+    #endif
+#endif
+#if LV_USE_DRAW_LAYER_BUF_REUSE
+    /*Max number of layer buffers to keep*/
+    #ifndef LV_DRAW_LAYER_BUF_REUSE_CNT
+        #ifdef CONFIG_LV_DRAW_LAYER_BUF_REUSE_CNT
+            #define LV_DRAW_LAYER_BUF_REUSE_CNT CONFIG_LV_DRAW_LAYER_BUF_REUSE_CNT
+        #else
+            #define LV_DRAW_LAYER_BUF_REUSE_CNT         2
+        #endif
+    #endif
+
+    /*Let the simple layer chunks grow up to this size while there is enough free memory.
+     *Set to `LV_DRAW_LAYER_SIMPLE_BUF_SIZE` to always use the fixed chunk size.*/
+    #ifndef LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE
+        #ifdef CONFIG_LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE
+            #define LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE CONFIG_LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE
+        #else
+            #define LV_DRAW_LAYER_SIMPLE_BUF_MAX_SIZE   (96 * 1024)   /*[bytes]*/
+        #endif
+    #endif
+#endif
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -1096,6 +1274,94 @@
     #endif
 #endif
 
+/*Measure the decoding time of the cached images and evict the cheap ones first (Greedy-Dual-Size).
+ *Also collects hit/miss/decoding time statistics per image source, see `lv_image_cache_get_stats()`.*/
+#ifndef LV_USE_IMAGE_CACHE_COST
+    #ifdef CONFIG_LV_USE_IMAGE_CACHE_COST
+        #define LV_USE_IMAGE_CACHE_COST CONFIG_LV_USE_IMAGE_CACHE_COST
+    #else
+        #define LV_USE_IMAGE_CACHE_COST     0
+    #endif
+#endif
+#if LV_USE_IMAGE_CACHE_COST
+    /*Max number of image sources to collect statistics about*/
+    #ifndef LV_IMAGE_CACHE_STATS_CNT
+        #ifdef CONFIG_LV_IMAGE_CACHE_STATS_CNT
+            #define LV_IMAGE_CACHE_STATS_CNT CONFIG_LV_IMAGE_CACHE_STATS_CNT
+        #else
+            #define LV_IMAGE_CACHE_STATS_CNT    64
+        #endif
+    #endif
+#endif
+
+/*Convert RGB888, XRGB8888 and ARGB8888 images to the display's native color format when they are added to the cache,
+ *so drawing them is a copy instead of converting every pixel on every draw. Used only if LV_COLOR_DEPTH is 16.
+ *Opaque images become RGB565, the others RGB565A8. Set it per image source with `lv_image_cache_set_native()`.*/
+#ifndef LV_USE_IMAGE_CACHE_NATIVE
+    #ifdef CONFIG_LV_USE_IMAGE_CACHE_NATIVE
+        #define LV_USE_IMAGE_CACHE_NATIVE CONFIG_LV_USE_IMAGE_CACHE_NATIVE
+    #else
+        #define LV_USE_IMAGE_CACHE_NATIVE   0
+    #endif
+#endif
+
+/*Save the headers of the file images in an index file to not open and parse the images again after a restart.
+ *The entries are checked by the size and modification time of the files if the driver has `stat_cb`.*/
+#ifndef LV_USE_IMAGE_HEADER_INDEX
+    #ifdef CONFIG_LV_USE_IMAGE_HEADER_INDEX
+        #define LV_USE_IMAGE_HEADER_INDEX CONFIG_LV_USE_IMAGE_HEADER_INDEX
+    #else
+        #define LV_USE_IMAGE_HEADER_INDEX   0
+    #endif
+#endif
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*Path of the index file*/
+    #ifndef LV_IMAGE_HEADER_INDEX_PATH
+        #ifdef CONFIG_LV_IMAGE_HEADER_INDEX_PATH
+            #define LV_IMAGE_HEADER_INDEX_PATH CONFIG_LV_IMAGE_HEADER_INDEX_PATH
+        #else
+            #define LV_IMAGE_HEADER_INDEX_PATH  "A:lv_image_header.idx"
+        #endif
+    #endif
+#endif
+
+/*Decode the images which are not in the cache in the background instead of while rendering.
+ *Until an image is decoded a placeholder is drawn, and the widget is invalidated when the image is in the cache.
+ *Requires `LV_CACHE_DEF_SIZE > 0`. Without `LV_USE_OS` the images are decoded one by one in an `lv_timer`.*/
+#ifndef LV_USE_IMAGE_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+        #define LV_USE_IMAGE_DECODER_ASYNC CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+    #else
+        #define LV_USE_IMAGE_DECODER_ASYNC  0
+    #endif
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Number of decoding threads if `LV_USE_OS` is enabled*/
+    #ifndef LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+        #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+            #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+        #else
+            #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT           1
+        #endif
+    #endif
+
+    /*Color and opacity of the placeholder*/
+    #ifndef LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR
+        #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR
+            #define LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR CONFIG_LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR
+        #else
+            #define LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_COLOR    0x808080
+        #endif
+    #endif
+    #ifndef LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA
+        #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA
+            #define LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA CONFIG_LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA
+        #else
+            #define LV_IMAGE_DECODER_ASYNC_PLACEHOLDER_OPA      LV_OPA_30
+        #endif
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1125,6 +1391,48 @@
     #endif
 #endif
 
+/* Keep a per object table of the already resolved style properties.
+ * It's dropped when the styles or the state of the object change.
+ * The table has 16 slots of 8 bytes (16 bytes on 64-bit systems) when the object's style is first read
+ * and it's doubled as needed up to 256 slots, i.e. 2 kB (4 kB on 64-bit systems) per object at most*/
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE 0
+    #endif
+#endif
+
+/* Keep a bitmap of the set built-in properties in each lv_style_t and store the properties sorted.
+ * Not set properties are rejected in O(1) and the set ones are indexed directly. Costs 28 bytes per style*/
+#ifndef LV_STYLE_PROP_BITMAP
+    #ifdef CONFIG_LV_STYLE_PROP_BITMAP
+        #define LV_STYLE_PROP_BITMAP CONFIG_LV_STYLE_PROP_BITMAP
+    #else
+        #define LV_STYLE_PROP_BITMAP    0
+    #endif
+#endif
+
+/* Allocate the objects and their `spec_attr` from size class slabs instead of the heap one by one.
+ * It makes creating and deleting many widgets faster and keeps them from fragmenting the heap.*/
+#ifndef LV_USE_OBJ_SLAB
+    #ifdef CONFIG_LV_USE_OBJ_SLAB
+        #define LV_USE_OBJ_SLAB CONFIG_LV_USE_OBJ_SLAB
+    #else
+        #define LV_USE_OBJ_SLAB         0
+    #endif
+#endif
+#if LV_USE_OBJ_SLAB
+    /* Blocks larger than this are allocated by `lv_malloc`. Must be a multiple of 16*/
+    #ifndef LV_OBJ_SLAB_MAX_SIZE
+        #ifdef CONFIG_LV_OBJ_SLAB_MAX_SIZE
+            #define LV_OBJ_SLAB_MAX_SIZE CONFIG_LV_OBJ_SLAB_MAX_SIZE
+        #else
+            #define LV_OBJ_SLAB_MAX_SIZE    512
+        #endif
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1636,6 +1944,26 @@
     #endif
 #endif
 
+/*Size of the glyph bitmap cache of the built-in font format in bytes.
+ *Glyphs are decompressed/expanded to A8 only once and reused from the cache while drawing.
+ *0: disable the cache and decode the glyphs on every draw*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Enable `lv_font_fmt_txt_cmap_index_create()` to find the glyphs of large fonts (e.g. CJK) in constant time*/
+#ifndef LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    #ifdef CONFIG_LV_USE_FONT_FMT_TXT_CMAP_INDEX
+        #define LV_USE_FONT_FMT_TXT_CMAP_INDEX CONFIG_LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    #else
+        #define LV_USE_FONT_FMT_TXT_CMAP_INDEX 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
@@ -2030,6 +2358,13 @@
             #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
         #endif
     #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+            #define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+        #else
+            #define LV_LABEL_LAYOUT_CACHE 0  /*Store the line breaks and line widths in labels to speed up size calculation and drawing*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LED
@@ -2369,6 +2704,16 @@
     #endif
 #endif
 
+/*Update the layout only in the subtrees with invalidated layout and
+ *measure the content sized grid tracks in a single pass over the children*/
+#ifndef LV_USE_LAYOUT_INCREMENTAL
+    #ifdef CONFIG_LV_USE_LAYOUT_INCREMENTAL
+        #define LV_USE_LAYOUT_INCREMENTAL CONFIG_LV_USE_LAYOUT_INCREMENTAL
+    #else
+        #define LV_USE_LAYOUT_INCREMENTAL 0
+    #endif
+#endif
+
 /*====================
  * 3RD PARTS LIBRARIES
  *====================*/
@@ -2619,6 +2964,28 @@
         #define LV_USE_LODEPNG 0
     #endif
 #endif
+#if LV_USE_LODEPNG
+    /*Inflate and convert the PNGs row by row instead of loading and decoding the whole file at once.
+     *Opaque images are decoded to RGB565 if LV_COLOR_DEPTH is 16 and the images which are not cached
+     *are decoded only in the rows being drawn. Interlaced, 16 bit and colour keyed PNGs still use lodepng.*/
+    #ifndef LV_LODEPNG_STREAM
+        #ifdef CONFIG_LV_LODEPNG_STREAM
+            #define LV_LODEPNG_STREAM CONFIG_LV_LODEPNG_STREAM
+        #else
+            #define LV_LODEPNG_STREAM 0
+        #endif
+    #endif
+    #if LV_LODEPNG_STREAM
+        /*Use ordered dithering when converting to RGB565*/
+        #ifndef LV_LODEPNG_STREAM_DITHER
+            #ifdef CONFIG_LV_LODEPNG_STREAM_DITHER
+                #define LV_LODEPNG_STREAM_DITHER CONFIG_LV_LODEPNG_STREAM_DITHER
+            #else
+                #define LV_LODEPNG_STREAM_DITHER 0
+            #endif
+        #endif
+    #endif
+#endif
 
 /*PNG decoder(libpng) library*/
 #ifndef LV_USE_LIBPNG
@@ -2647,6 +3014,17 @@
         #define LV_USE_TJPGD 0
     #endif
 #endif
+#if LV_USE_TJPGD
+    /*Number of JPG images whose restart marker positions are kept to decode only the rows being drawn.
+     *Helps only if the images have restart markers (DRI). 0: disable*/
+    #ifndef LV_TJPGD_RST_INDEX_CNT
+        #ifdef CONFIG_LV_TJPGD_RST_INDEX_CNT
+            #define LV_TJPGD_RST_INDEX_CNT CONFIG_LV_TJPGD_RST_INDEX_CNT
+        #else
+            #define LV_TJPGD_RST_INDEX_CNT 0
+        #endif
+    #endif
+#endif
 
 /* libjpeg-turbo decoder library.
  * Supports complete JPEG specifications and high-performance JPEG decoding. */
@@ -2675,6 +3053,16 @@
             #define LV_GIF_CACHE_DECODE_DATA 0
         #endif
     #endif
+
+    /*Render only the pixels changed by each frame through a palette lookup table and redraw only their area.
+     *The frames are rendered to RGB565 if LV_COLOR_DEPTH is 16 (RGB565A8 once a frame leaves transparent parts)*/
+    #ifndef LV_GIF_DIFF_RENDER
+        #ifdef CONFIG_LV_GIF_DIFF_RENDER
+            #define LV_GIF_DIFF_RENDER CONFIG_LV_GIF_DIFF_RENDER
+        #else
+            #define LV_GIF_DIFF_RENDER 0
+        #endif
+    #endif
 #endif
 
 
@@ -2687,6 +3075,26 @@
     #endif
 #endif
 
+/*Decompress the compressed bin images having a row group index group by group while drawing
+ *instead of decompressing the whole image to RAM. See `lv_image_compressed_t` for the format.*/
+#ifndef LV_BIN_DECODER_ROW_GROUPS
+    #ifdef CONFIG_LV_BIN_DECODER_ROW_GROUPS
+        #define LV_BIN_DECODER_ROW_GROUPS CONFIG_LV_BIN_DECODER_ROW_GROUPS
+    #else
+        #define LV_BIN_DECODER_ROW_GROUPS 0
+    #endif
+#endif
+#if LV_BIN_DECODER_ROW_GROUPS
+    /*Number of decompressed row groups to keep between the draws*/
+    #ifndef LV_BIN_DECODER_ROW_GROUP_CACHE_CNT
+        #ifdef CONFIG_LV_BIN_DECODER_ROW_GROUP_CACHE_CNT
+            #define LV_BIN_DECODER_ROW_GROUP_CACHE_CNT CONFIG_LV_BIN_DECODER_ROW_GROUP_CACHE_CNT
+        #else
+            #define LV_BIN_DECODER_ROW_GROUP_CACHE_CNT 4
+        #endif
+    #endif
+#endif
+
 /*RLE decompress library*/
 #ifndef LV_USE_RLE
     #ifdef CONFIG_LV_USE_RLE
@@ -3012,6 +3420,15 @@
     #endif
 #endif
 
+/*1: Enable the benchmarks of the core modules, e.g. `lv_bench_anim()`, to measure the performance options*/
+#ifndef LV_USE_BENCH
+    #ifdef CONFIG_LV_USE_BENCH
+        #define LV_USE_BENCH CONFIG_LV_USE_BENCH
+    #else
+        #define LV_USE_BENCH 0
+    #endif
+#endif
+
 /*1: Enable grid navigation*/
 #ifndef LV_USE_GRIDNAV
     #ifdef CONFIG_LV_USE_GRIDNAV
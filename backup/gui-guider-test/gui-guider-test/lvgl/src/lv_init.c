@@ -14,6 +14,7 @@
 #include "misc/lv_timer_private.h"
 #include "misc/lv_profiler_builtin_private.h"
 #include "misc/lv_anim_private.h"
+#include "misc/lv_slab_private.h"
 #include "draw/lv_image_decoder_private.h"
 #include "draw/lv_draw_buf_private.h"
 #include "core/lv_refr_private.h"
@@ -170,6 +171,10 @@ void lv_init(void)
 
     lv_mem_init();
 
+#if LV_USE_OBJ_SLAB
+    lv_slab_init();
+#endif
+
     lv_draw_buf_init_handlers();
 
 #if LV_USE_SPAN != 0
@@ -234,6 +239,8 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+    lv_font_fmt_txt_glyph_cache_init(LV_FONT_FMT_TXT_CACHE_SIZE);
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -393,6 +400,11 @@ void lv_deinit(void)
 
     lv_image_decoder_deinit();
 
+    lv_font_fmt_txt_glyph_cache_deinit();
+#if LV_USE_FONT_FMT_TXT_CMAP_INDEX
+    lv_font_fmt_txt_cmap_index_deinit();
+#endif
+
     lv_refr_deinit();
 
     lv_obj_style_deinit();
@@ -417,6 +429,10 @@ void lv_deinit(void)
 
     lv_draw_deinit();
 
+#if LV_USE_DRAW_BUF_POOL
+    lv_draw_buf_pool_deinit();
+#endif
+
     lv_group_deinit();
 
     lv_anim_core_deinit();
@@ -435,6 +451,10 @@ void lv_deinit(void)
     lv_objid_builtin_destroy();
 #endif
 
+#if LV_USE_OBJ_SLAB
+    lv_slab_deinit();
+#endif
+
     lv_mem_deinit();
 
     lv_initialized = false;
@@ -66,6 +66,7 @@ extern "C" {
 #include "misc/lv_style_private.h"
 #include "misc/lv_color_op_private.h"
 #include "misc/lv_anim_private.h"
+#include "misc/lv_slab_private.h"
 #include "widgets/msgbox/lv_msgbox_private.h"
 #include "widgets/buttonmatrix/lv_buttonmatrix_private.h"
 #include "widgets/slider/lv_slider_private.h"
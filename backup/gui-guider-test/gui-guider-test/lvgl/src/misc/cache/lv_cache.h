@@ -21,6 +21,7 @@ extern "C" {
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
+#include "lv_image_header_index.h"
 /*********************
  *      DEFINES
  *********************/
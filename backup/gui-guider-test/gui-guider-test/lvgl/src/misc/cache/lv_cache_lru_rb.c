@@ -65,6 +65,9 @@ struct lv_lru_rb_t {
     lv_ll_t ll;
 
     get_data_size_cb_t * get_data_size_cb;
+
+    bool use_cost;          /**< The data starts with `lv_cache_slot_size_cost_t`*/
+    uint32_t cost_clock;    /**< Aging clock: priority of the last victim*/
 };
 typedef struct lv_lru_rb_t lv_lru_rb_t_;
 /**********************
@@ -74,6 +77,7 @@ typedef struct lv_lru_rb_t lv_lru_rb_t_;
 static void * alloc_cb(void);
 static bool init_cnt_cb(lv_cache_t * cache);
 static bool init_size_cb(lv_cache_t * cache);
+static bool init_size_cost_cb(lv_cache_t * cache);
 static void  destroy_cb(lv_cache_t * cache, void * user_data);
 
 static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
@@ -82,11 +86,13 @@ static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_
 static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
 static void drop_all_cb(lv_cache_t * cache, void * user_data);
 static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cost_cb(lv_cache_t * cache, void * user_data);
 static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
                                                    void * user_data);
 
 static void * alloc_new_node(lv_lru_rb_t_ * lru, void * key, void * user_data);
 inline static void ** get_lru_node(lv_lru_rb_t_ * lru, lv_rb_node_t * node);
+inline static uint32_t get_cost_priority(const lv_cache_slot_size_cost_t * slot);
 
 static uint32_t cnt_get_data_size_cb(const void * data);
 static uint32_t size_get_data_size_cb(const void * data);
@@ -121,6 +127,20 @@ const lv_cache_class_t lv_cache_class_lru_rb_size = {
     .get_victim_cb = get_victim_cb,
     .reserve_cond_cb = reserve_cond_cb
 };
+
+const lv_cache_class_t lv_cache_class_lru_rb_size_cost = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cost_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cost_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -177,6 +197,16 @@ inline static void ** get_lru_node(lv_lru_rb_t_ * lru, lv_rb_node_t * node)
     return (void **)((char *)node->data + lru->rb.size - sizeof(void *));
 }
 
+/**
+ * Greedy-Dual-Size priority of an entry: the aging clock at its last use plus its cost per kB.
+ * Entries with lower priority are evicted first.
+ */
+inline static uint32_t get_cost_priority(const lv_cache_slot_size_cost_t * slot)
+{
+    uint32_t size_kb = (uint32_t)(slot->size >> 10) + 1;
+    return slot->cost_clock + ((slot->cost << 8) / size_kb);
+}
+
 static void * alloc_cb(void)
 {
     void * res = lv_malloc(sizeof(lv_lru_rb_t_));
@@ -236,6 +266,17 @@ static bool init_size_cb(lv_cache_t * cache)
     return true;
 }
 
+static bool init_size_cost_cb(lv_cache_t * cache)
+{
+    if(!init_size_cb(cache)) return false;
+
+    lv_lru_rb_t_ * lru = (lv_lru_rb_t_ *)cache;
+    lru->use_cost = true;
+    lru->cost_clock = 0;
+
+    return true;
+}
+
 static void destroy_cb(lv_cache_t * cache, void * user_data)
 {
     LV_UNUSED(user_data);
@@ -271,6 +312,7 @@ static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * us
         void * data = node->data;
         lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
         if(lru->cache.ops.compare_cb(data, key) == 0) {
+            if(lru->use_cost) ((lv_cache_slot_size_cost_t *)data)->cost_clock = lru->cost_clock;
             return entry;
         }
     }
@@ -278,6 +320,8 @@ static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * us
     lv_rb_node_t * node = lv_rb_find(&lru->rb, key);
     /*cache hit*/
     if(node) {
+        if(lru->use_cost) ((lv_cache_slot_size_cost_t *)node->data)->cost_clock = lru->cost_clock;
+
         void * lru_node = *get_lru_node(lru, node);
         head = lv_ll_get_head(&lru->ll);
         lv_ll_move_before(&lru->ll, lru_node, head);
@@ -308,6 +352,12 @@ static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * us
 
     lv_cache_entry_t * entry = lv_cache_entry_get_entry(new_node->data, cache->node_size);
 
+    if(lru->use_cost) {
+        lv_cache_slot_size_cost_t * slot = new_node->data;
+        slot->cost = 0;
+        slot->cost_clock = lru->cost_clock;
+    }
+
     cache->size += lru->get_data_size_cb(key);
 
     return entry;
@@ -425,6 +475,38 @@ static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
     return NULL;
 }
 
+static lv_cache_entry_t * get_victim_cost_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_lru_rb_t_ * lru = (lv_lru_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(lru);
+
+    /*Find the lowest priority starting from the least recently used,
+     *so LRU decides between entries with the same priority*/
+    lv_cache_entry_t * victim = NULL;
+    uint32_t victim_prio = 0;
+    lv_rb_node_t ** tail;
+    LV_LL_READ_BACK(&lru->ll, tail) {
+        lv_rb_node_t * tail_node = *tail;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(tail_node->data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) != 0) continue;
+
+        uint32_t prio = get_cost_priority(tail_node->data);
+        /*Compare the difference to handle the overflow of the clock*/
+        if(victim == NULL || (int32_t)(prio - victim_prio) < 0) {
+            victim = entry;
+            victim_prio = prio;
+        }
+    }
+
+    /*Age the remaining entries by moving the clock forward*/
+    if(victim) lru->cost_clock = victim_prio;
+
+    return victim;
+}
+
 static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
                                                    void * user_data)
 {
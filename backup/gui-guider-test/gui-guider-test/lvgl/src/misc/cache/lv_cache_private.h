@@ -162,8 +162,10 @@ struct lv_cache_class_t {
  *----------------*/
 
 struct lv_cache_slot_size_t;
+struct lv_cache_slot_size_cost_t;
 
 typedef struct lv_cache_slot_size_t lv_cache_slot_size_t;
+typedef struct lv_cache_slot_size_cost_t lv_cache_slot_size_cost_t;
 
 /**
  * Cache entry slot struct
@@ -174,6 +176,16 @@ typedef struct lv_cache_slot_size_t lv_cache_slot_size_t;
 struct lv_cache_slot_size_t {
     size_t size;
 };
+
+/**
+ * Cache entry slot with the size and the cost of creating the data (e.g. decoding time).
+ * Used by `lv_cache_class_lru_rb_size_cost` to keep the expensive entries longer.
+ */
+struct lv_cache_slot_size_cost_t {
+    size_t size;            /**< Must be the first to be compatible with `lv_cache_slot_size_t`*/
+    uint32_t cost;          /**< Cost of creating the data. Set it after adding the entry. [ms]*/
+    uint32_t cost_clock;    /**< Value of the cache's aging clock when the entry was last used. Set by the cache.*/
+};
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -9,7 +9,11 @@
 
 #include "../../draw/lv_image_decoder_private.h"
 #include "../lv_assert.h"
+#include "../lv_rb_private.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
+#include "../../osal/lv_os.h"
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
@@ -22,11 +26,45 @@
 
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define img_cache_stats_p (LV_GLOBAL_DEFAULT()->img_cache_stats)
+#define img_cache_native_p (LV_GLOBAL_DEFAULT()->img_cache_native)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_IMAGE_CACHE_COST
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    lv_image_cache_stats_t stats;
+} stats_node_t;
+
+typedef struct lv_image_cache_stats_ctx_t {
+    lv_rb_t rb;
+    uint32_t cnt;       /**< Number of sources in `rb`*/
+#if LV_USE_OS
+    lv_mutex_t lock;
+#endif
+} lv_image_cache_stats_ctx_t;
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    lv_image_cache_native_t policy;
+} native_node_t;
+
+typedef struct lv_image_cache_native_ctx_t {
+    lv_rb_t rb;
+    lv_image_cache_native_t default_policy;
+#if LV_USE_OS
+    lv_mutex_t lock;
+#endif
+} lv_image_cache_native_ctx_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -34,6 +72,21 @@
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
+#if LV_USE_IMAGE_CACHE_COST
+    static void stats_init(void);
+    static lv_rb_compare_res_t stats_compare_cb(const stats_node_t * lhs, const stats_node_t * rhs);
+    static void stats_lock(void);
+    static void stats_unlock(void);
+    static void stats_walk(lv_rb_node_t * node, bool free_src);
+    static void stats_drop(const void * src);
+#endif
+#if LV_USE_IMAGE_CACHE_NATIVE
+    static void native_init(void);
+    static lv_rb_compare_res_t native_compare_cb(const native_node_t * lhs, const native_node_t * rhs);
+    static void native_lock(void);
+    static void native_unlock(void);
+    static void native_free_src(lv_rb_node_t * node);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -57,7 +110,11 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
+#if LV_USE_IMAGE_CACHE_COST
+    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size_cost,
+#else
     img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+#endif
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
         .create_cb = NULL,
@@ -65,6 +122,15 @@ lv_result_t lv_image_cache_init(uint32_t size)
     });
 
     lv_cache_set_name(img_cache_p, CACHE_NAME);
+
+#if LV_USE_IMAGE_CACHE_COST
+    stats_init();
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+    native_init();
+#endif
+
     return img_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
 }
 
@@ -81,6 +147,19 @@ void lv_image_cache_drop(const void * src)
     /*If user invalidate image, the header cache should be invalidated too.*/
     lv_image_header_cache_drop(src);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_drop(src);
+#endif
+
+#if LV_BIN_DECODER_ROW_GROUPS
+    lv_bin_decoder_row_group_drop(src);
+#endif
+
+#if LV_USE_IMAGE_CACHE_COST
+    /*The address might be reused by an other image*/
+    stats_drop(src);
+#endif
+
     if(src == NULL) {
         lv_cache_drop_all(img_cache_p, NULL);
         return;
@@ -99,6 +178,229 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+void lv_image_cache_prefetch(const void * const src_list[])
+{
+    LV_ASSERT_NULL(src_list);
+
+    uint32_t i;
+    for(i = 0; src_list[i] != NULL; i++) {
+        const void * src = src_list[i];
+        lv_image_src_t src_type = lv_image_src_get_type(src);
+        if(src_type != LV_IMAGE_SRC_VARIABLE && src_type != LV_IMAGE_SRC_FILE) continue;
+
+        lv_image_cache_data_t search_key = {
+            .src = src,
+            .src_type = src_type,
+        };
+
+        lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+        if(entry) {
+            lv_cache_release(img_cache_p, entry, NULL);
+            continue;
+        }
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+        lv_image_decoder_async_prefetch(src);
+#else
+        /*Opening an image leaves the decoded data in the cache*/
+        lv_image_decoder_dsc_t dsc;
+        if(lv_image_decoder_open(&dsc, src, NULL) == LV_RESULT_OK) {
+            lv_image_decoder_close(&dsc);
+        }
+#endif
+    }
+}
+
+#if LV_USE_IMAGE_CACHE_COST
+
+lv_result_t lv_image_cache_get_stats(const void * src, lv_image_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    lv_result_t res = LV_RESULT_INVALID;
+    if(img_cache_stats_p == NULL) return res;
+
+    stats_node_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    stats_lock();
+    lv_rb_node_t * node = lv_rb_find(&img_cache_stats_p->rb, &search_key);
+    if(node) {
+        *stats = ((stats_node_t *)node->data)->stats;
+        res = LV_RESULT_OK;
+    }
+    stats_unlock();
+
+    return res;
+}
+
+void lv_image_cache_dump_stats(void)
+{
+    if(img_cache_stats_p == NULL) return;
+
+    stats_lock();
+    stats_walk(img_cache_stats_p->rb.root, false);
+    stats_unlock();
+}
+
+void lv_image_cache_reset_stats(void)
+{
+    if(img_cache_stats_p == NULL) return;
+
+    stats_lock();
+    stats_walk(img_cache_stats_p->rb.root, true);
+    lv_rb_destroy(&img_cache_stats_p->rb);
+    lv_rb_init(&img_cache_stats_p->rb, (lv_rb_compare_t)stats_compare_cb, sizeof(stats_node_t));
+    img_cache_stats_p->cnt = 0;
+    stats_unlock();
+}
+
+void lv_image_cache_stats_add(const void * src, bool hit, uint32_t time)
+{
+    if(img_cache_stats_p == NULL) return;
+
+    stats_node_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    stats_lock();
+    lv_rb_node_t * node = lv_rb_find(&img_cache_stats_p->rb, &search_key);
+    if(node == NULL) {
+        /*Don't grow without limit if the sources are created dynamically*/
+        if(img_cache_stats_p->cnt >= LV_IMAGE_CACHE_STATS_CNT) {
+            stats_unlock();
+            return;
+        }
+
+        if(search_key.src_type == LV_IMAGE_SRC_FILE) {
+            search_key.src = lv_strdup(src);
+            if(search_key.src == NULL) {
+                stats_unlock();
+                return;
+            }
+        }
+
+        node = lv_rb_insert(&img_cache_stats_p->rb, &search_key);
+        if(node == NULL) {
+            if(search_key.src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
+            stats_unlock();
+            return;
+        }
+        lv_memcpy(node->data, &search_key, sizeof(stats_node_t));
+        img_cache_stats_p->cnt++;
+    }
+
+    lv_image_cache_stats_t * stats = &((stats_node_t *)node->data)->stats;
+    if(hit) {
+        stats->hit_cnt++;
+    }
+    else {
+        stats->miss_cnt++;
+        stats->decode_time += time;
+        stats->last_decode_time = time;
+    }
+    stats_unlock();
+}
+
+void lv_image_cache_stats_deinit(void)
+{
+    lv_image_cache_stats_ctx_t * ctx = img_cache_stats_p;
+    if(ctx == NULL) return;
+
+    stats_walk(ctx->rb.root, true);
+    lv_rb_destroy(&ctx->rb);
+#if LV_USE_OS
+    lv_mutex_delete(&ctx->lock);
+#endif
+    lv_free(ctx);
+    img_cache_stats_p = NULL;
+}
+
+#endif /*LV_USE_IMAGE_CACHE_COST*/
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+
+void lv_image_cache_set_native(const void * src, lv_image_cache_native_t policy)
+{
+    /*Created in `lv_image_cache_init()`*/
+    if(img_cache_native_p == NULL) return;
+
+    native_lock();
+    if(src == NULL) {
+        img_cache_native_p->default_policy = policy;
+    }
+    else {
+        native_node_t search_key = {
+            .src = src,
+            .src_type = lv_image_src_get_type(src),
+        };
+
+        lv_rb_node_t * node = lv_rb_find(&img_cache_native_p->rb, &search_key);
+        if(node == NULL) {
+            if(search_key.src_type == LV_IMAGE_SRC_FILE) {
+                search_key.src = lv_strdup(src);
+                if(search_key.src == NULL) {
+                    native_unlock();
+                    return;
+                }
+            }
+
+            node = lv_rb_insert(&img_cache_native_p->rb, &search_key);
+            if(node == NULL) {
+                if(search_key.src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
+                native_unlock();
+                return;
+            }
+            lv_memcpy(node->data, &search_key, sizeof(native_node_t));
+        }
+
+        ((native_node_t *)node->data)->policy = policy;
+    }
+    native_unlock();
+
+    /*Decode the image(s) again with the new policy*/
+    lv_image_cache_drop(src);
+}
+
+lv_image_cache_native_t lv_image_cache_get_native(const void * src)
+{
+    if(img_cache_native_p == NULL) return LV_IMAGE_CACHE_NATIVE_AUTO;
+
+    native_lock();
+    lv_image_cache_native_t policy = img_cache_native_p->default_policy;
+    if(src) {
+        native_node_t search_key = {
+            .src = src,
+            .src_type = lv_image_src_get_type(src),
+        };
+
+        lv_rb_node_t * node = lv_rb_find(&img_cache_native_p->rb, &search_key);
+        if(node) policy = ((native_node_t *)node->data)->policy;
+    }
+    native_unlock();
+
+    return policy;
+}
+
+void lv_image_cache_native_deinit(void)
+{
+    lv_image_cache_native_ctx_t * ctx = img_cache_native_p;
+    if(ctx == NULL) return;
+
+    native_free_src(ctx->rb.root);
+    lv_rb_destroy(&ctx->rb);
+#if LV_USE_OS
+    lv_mutex_delete(&ctx->lock);
+#endif
+    lv_free(ctx);
+    img_cache_native_p = NULL;
+}
+
+#endif /*LV_USE_IMAGE_CACHE_NATIVE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -143,3 +445,149 @@ static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
     /*Free the duplicated file name*/
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
 }
+
+#if LV_USE_IMAGE_CACHE_COST
+
+static void stats_init(void)
+{
+    if(img_cache_stats_p != NULL) return;
+
+    lv_image_cache_stats_ctx_t * ctx = lv_malloc_zeroed(sizeof(lv_image_cache_stats_ctx_t));
+    LV_ASSERT_MALLOC(ctx);
+    if(ctx == NULL) return;
+
+    lv_rb_init(&ctx->rb, (lv_rb_compare_t)stats_compare_cb, sizeof(stats_node_t));
+#if LV_USE_OS
+    lv_mutex_init(&ctx->lock);
+#endif
+    img_cache_stats_p = ctx;
+}
+
+static lv_rb_compare_res_t stats_compare_cb(const stats_node_t * lhs, const stats_node_t * rhs)
+{
+    return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+}
+
+static void stats_lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&img_cache_stats_p->lock);
+#endif
+}
+
+static void stats_unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&img_cache_stats_p->lock);
+#endif
+}
+
+/**
+ * Visit the nodes in order and either print or free their source
+ */
+static void stats_walk(lv_rb_node_t * node, bool free_src)
+{
+    if(node == NULL) return;
+
+    stats_walk(node->left, free_src);
+
+    stats_node_t * data = node->data;
+    if(free_src) {
+        if(data->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)data->src);
+    }
+    else {
+        const lv_image_cache_stats_t * stats = &data->stats;
+        LV_UNUSED(stats);   /*If the log is disabled*/
+        if(data->src_type == LV_IMAGE_SRC_FILE) {
+            LV_LOG_USER("%s: hit: %" LV_PRIu32 ", miss: %" LV_PRIu32 ", decode time: %" LV_PRIu32 " ms (last %" LV_PRIu32
+                        " ms)", (const char *)data->src, stats->hit_cnt, stats->miss_cnt, stats->decode_time, stats->last_decode_time);
+        }
+        else {
+            LV_LOG_USER("%p: hit: %" LV_PRIu32 ", miss: %" LV_PRIu32 ", decode time: %" LV_PRIu32 " ms (last %" LV_PRIu32
+                        " ms)", data->src, stats->hit_cnt, stats->miss_cnt, stats->decode_time, stats->last_decode_time);
+        }
+    }
+
+    stats_walk(node->right, free_src);
+}
+
+/**
+ * Forget the statistics of an image source
+ * @param src       the image source or NULL to forget all
+ */
+static void stats_drop(const void * src)
+{
+    if(src == NULL) {
+        lv_image_cache_reset_stats();
+        return;
+    }
+
+    if(img_cache_stats_p == NULL) return;
+
+    stats_node_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    stats_lock();
+    lv_rb_node_t * node = lv_rb_find(&img_cache_stats_p->rb, &search_key);
+    if(node) {
+        stats_node_t * data = node->data;
+        if(data->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)data->src);
+        lv_rb_drop_node(&img_cache_stats_p->rb, node);
+        img_cache_stats_p->cnt--;
+    }
+    stats_unlock();
+}
+
+#endif /*LV_USE_IMAGE_CACHE_COST*/
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+
+static void native_init(void)
+{
+    if(img_cache_native_p != NULL) return;
+
+    lv_image_cache_native_ctx_t * ctx = lv_malloc_zeroed(sizeof(lv_image_cache_native_ctx_t));
+    LV_ASSERT_MALLOC(ctx);
+    if(ctx == NULL) return;
+
+    lv_rb_init(&ctx->rb, (lv_rb_compare_t)native_compare_cb, sizeof(native_node_t));
+    ctx->default_policy = LV_IMAGE_CACHE_NATIVE_AUTO;
+#if LV_USE_OS
+    lv_mutex_init(&ctx->lock);
+#endif
+    img_cache_native_p = ctx;
+}
+
+static lv_rb_compare_res_t native_compare_cb(const native_node_t * lhs, const native_node_t * rhs)
+{
+    return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+}
+
+static void native_lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&img_cache_native_p->lock);
+#endif
+}
+
+static void native_unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&img_cache_native_p->lock);
+#endif
+}
+
+static void native_free_src(lv_rb_node_t * node)
+{
+    if(node == NULL) return;
+
+    native_free_src(node->left);
+    native_free_src(node->right);
+
+    native_node_t * data = node->data;
+    if(data->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)data->src);
+}
+
+#endif /*LV_USE_IMAGE_CACHE_NATIVE*/
@@ -25,6 +25,24 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_IMAGE_CACHE_COST
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of times the image was opened from the cache*/
+    uint32_t miss_cnt;          /**< Number of times the image was decoded*/
+    uint32_t decode_time;       /**< Sum of the decoding times [ms]*/
+    uint32_t last_decode_time;  /**< Time of the last decoding [ms]*/
+} lv_image_cache_stats_t;
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+typedef enum {
+    LV_IMAGE_CACHE_NATIVE_AUTO,     /**< Convert the decoded images, but draw the variables directly*/
+    LV_IMAGE_CACHE_NATIVE_ALWAYS,   /**< Convert the variables too (but not draw buffers, e.g. of canvases)
+                                     *   and keep the converted copy in the cache*/
+    LV_IMAGE_CACHE_NATIVE_NEVER,    /**< Keep the image in its decoded color format*/
+} lv_image_cache_native_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -56,6 +74,52 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Decode images into the cache before they are shown, e.g. before loading a new screen.
+ * With `LV_USE_IMAGE_DECODER_ASYNC` the images are decoded in the background.
+ * @param src_list  NULL terminated array of image sources
+ */
+void lv_image_cache_prefetch(const void * const src_list[]);
+
+#if LV_USE_IMAGE_CACHE_COST
+/**
+ * Get the cache statistics of an image source
+ * @param src       pointer to an image source
+ * @param stats     store the statistics here
+ * @return          LV_RESULT_OK: found; LV_RESULT_INVALID: the image wasn't cached yet,
+ *                  or `LV_IMAGE_CACHE_STATS_CNT` other sources are counted already
+ */
+lv_result_t lv_image_cache_get_stats(const void * src, lv_image_cache_stats_t * stats);
+
+/**
+ * Print the cache statistics of all image sources with `LV_LOG_USER`
+ */
+void lv_image_cache_dump_stats(void);
+
+/**
+ * Forget the cache statistics of all image sources
+ */
+void lv_image_cache_reset_stats(void);
+#endif
+
+#if LV_USE_IMAGE_CACHE_NATIVE
+/**
+ * Set whether an RGB888, XRGB8888 or ARGB8888 image is converted to the display's native color format
+ * when it's added to the cache. Opaque images become RGB565, the others RGB565A8.
+ * Images drawn with `bitmap_mask_src` should be `LV_IMAGE_CACHE_NATIVE_NEVER` as masked RGB565A8 images can't be drawn.
+ * @param src       pointer to an image source or NULL to set the policy of the images without their own policy
+ * @param policy    an element of `lv_image_cache_native_t`
+ */
+void lv_image_cache_set_native(const void * src, lv_image_cache_native_t policy);
+
+/**
+ * Get the native color format conversion policy of an image source
+ * @param src       pointer to an image source or NULL to get the default policy
+ * @return          the policy of the source, or the default policy if it has no own policy
+ */
+lv_image_cache_native_t lv_image_cache_get_native(const void * src);
+#endif
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -0,0 +1,596 @@
+/**
+* @file lv_image_header_index.c
+*
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_image_header_index.h"
+#if LV_USE_IMAGE_HEADER_INDEX
+
+#include "../../draw/lv_image_decoder_private.h"
+#include "../lv_assert.h"
+#include "../lv_fs.h"
+#include "../lv_rb_private.h"
+#include "../lv_timer.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../../core/lv_global.h"
+#include "../../osal/lv_os.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define img_header_index_p (LV_GLOBAL_DEFAULT()->img_header_index)
+
+#define INDEX_MAGIC             0x4948564CU /*"LVHI"*/
+#define INDEX_VERSION           1
+#define INDEX_USED_OFFSET       8           /*Offset of `used` in the file header*/
+#define DECODER_NAME_MAX        16
+#define INDEX_WRITE_PERIOD      1000        /*[ms] Write the new entries in one go at most this often*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;       /**< `sizeof(lv_image_header_t)` to not load the index of an other build*/
+    uint32_t used;              /**< Length of the valid records after the file header*/
+} index_file_header_t;
+
+/*Followed by the path and the decoder name without '\0'*/
+typedef struct {
+    uint16_t path_len;
+    uint8_t decoder_name_len;   /**< 0: the entry was dropped*/
+    uint8_t reserved;
+    uint32_t size;
+    uint32_t mtime;
+    lv_image_header_t header;
+} index_record_t;
+
+typedef struct {
+    char * src;
+    uint32_t size;
+    uint32_t mtime;
+    lv_image_header_t header;
+    char decoder_name[DECODER_NAME_MAX];
+    bool pending;               /**< Not written to the file yet*/
+} index_entry_t;
+
+typedef struct lv_image_header_index_t {
+    lv_rb_t rb;
+    uint32_t entry_cnt;
+    uint32_t record_cnt;        /**< Number of records in the file, including the outdated ones*/
+    uint32_t used;              /**< Length of the records in the file*/
+    uint32_t pending_cnt;       /**< Number of entries to append to the file*/
+    lv_timer_t * timer;         /**< Appends the pending entries*/
+    bool loaded;
+    bool file_valid;            /**< The file has a valid header, new records can be appended*/
+#if LV_USE_OS
+    lv_mutex_t lock;
+#endif
+} lv_image_header_index_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_rb_compare_res_t index_compare_cb(const index_entry_t * lhs, const index_entry_t * rhs);
+static void index_load(lv_image_header_index_t * index);
+static void index_apply(lv_image_header_index_t * index, index_entry_t * entry, bool drop);
+static void index_append(lv_image_header_index_t * index, const index_entry_t * dropped);
+static lv_result_t index_write_all(lv_image_header_index_t * index);
+static lv_result_t index_write_node(lv_fs_file_t * file, lv_rb_node_t * node, bool pending_only, uint32_t * used);
+static void index_clear_pending(lv_rb_node_t * node);
+static void index_timer_cb(lv_timer_t * t);
+static lv_result_t record_write(lv_fs_file_t * file, const index_entry_t * entry, bool drop, uint32_t * used);
+static void index_clear(lv_image_header_index_t * index);
+static void index_free_node(lv_rb_node_t * node);
+static inline void index_lock(lv_image_header_index_t * index);
+static inline void index_unlock(lv_image_header_index_t * index);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_image_header_index_init(void)
+{
+    if(img_header_index_p != NULL) return;
+
+    lv_image_header_index_t * index = lv_malloc_zeroed(sizeof(lv_image_header_index_t));
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) return;
+
+    /*Writing the new entries one by one would open the index file for each image.
+     *The timer keeps running as the entries are added from the draw and decoder threads too
+     *which must not touch the timers.*/
+    index->timer = lv_timer_create(index_timer_cb, INDEX_WRITE_PERIOD, index);
+    if(index->timer == NULL) {
+        lv_free(index);
+        return;
+    }
+
+    lv_rb_init(&index->rb, (lv_rb_compare_t)index_compare_cb, sizeof(index_entry_t));
+#if LV_USE_OS
+    lv_mutex_init(&index->lock);
+#endif
+
+    /*The index file is loaded when the first image is opened,
+     *as the file system drivers might be registered only after `lv_init()`*/
+    img_header_index_p = index;
+}
+
+void lv_image_header_index_deinit(void)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return;
+
+    if(index->pending_cnt) index_append(index, NULL);
+
+    lv_timer_delete(index->timer);
+    index_free_node(index->rb.root);
+    lv_rb_destroy(&index->rb);
+#if LV_USE_OS
+    lv_mutex_delete(&index->lock);
+#endif
+    lv_free(index);
+    img_header_index_p = NULL;
+}
+
+lv_image_decoder_t * lv_image_header_index_get(const char * src, lv_image_header_t * header)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return NULL;
+
+    index_entry_t search_key;
+    search_key.src = (char *)src;
+
+    index_lock(index);
+    if(!index->loaded) index_load(index);
+
+    lv_rb_node_t * node = lv_rb_find(&index->rb, &search_key);
+    if(node == NULL) {
+        index_unlock(index);
+        return NULL;
+    }
+
+    index_entry_t entry = *(index_entry_t *)node->data;
+    index_unlock(index);
+
+    /*Check if the image has changed since it was indexed*/
+    uint32_t size;
+    uint32_t mtime;
+    lv_fs_res_t res = lv_fs_stat(src, &size, &mtime);
+    if(res == LV_FS_RES_OK) {
+        if(size != entry.size || mtime != entry.mtime) return NULL;
+    }
+    else if(res != LV_FS_RES_NOT_IMP) {
+        return NULL;
+    }
+
+    lv_image_decoder_t * decoder = lv_image_decoder_get_next(NULL);
+    while(decoder) {
+        if(decoder->name && decoder->info_cb && decoder->open_cb &&
+           lv_strcmp(decoder->name, entry.decoder_name) == 0) {
+            *header = entry.header;
+            return decoder;
+        }
+        decoder = lv_image_decoder_get_next(decoder);
+    }
+
+    return NULL;
+}
+
+void lv_image_header_index_add(const char * src, const lv_image_header_t * header, const lv_image_decoder_t * decoder)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return;
+
+    /*The decoder is found again by its name*/
+    if(decoder->name == NULL) return;
+    size_t name_len = lv_strlen(decoder->name);
+    if(name_len == 0 || name_len >= DECODER_NAME_MAX) return;
+
+    size_t path_len = lv_strlen(src);
+    if(path_len == 0 || path_len >= LV_FS_MAX_PATH_LENGTH) return;
+
+    index_entry_t entry;
+    lv_memzero(&entry, sizeof(entry));
+    lv_fs_res_t res = lv_fs_stat(src, &entry.size, &entry.mtime);
+    if(res != LV_FS_RES_OK && res != LV_FS_RES_NOT_IMP) return;
+
+    entry.src = (char *)src;
+    entry.header = *header;
+    entry.pending = true;
+    lv_memcpy(entry.decoder_name, decoder->name, name_len);
+
+    index_lock(index);
+    if(!index->loaded) index_load(index);
+
+    if(index->loaded) {
+        /*Don't write the same entry again*/
+        lv_rb_node_t * node = lv_rb_find(&index->rb, &entry);
+        index_entry_t * old = node ? node->data : NULL;
+        if(old == NULL || old->size != entry.size || old->mtime != entry.mtime ||
+           lv_memcmp(&old->header, &entry.header, sizeof(lv_image_header_t)) != 0 ||
+           lv_strcmp(old->decoder_name, entry.decoder_name) != 0) {
+            if(old == NULL || !old->pending) index->pending_cnt++;
+            index_apply(index, &entry, false);
+        }
+    }
+    index_unlock(index);
+}
+
+void lv_image_header_index_drop(const void * src)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return;
+
+    index_lock(index);
+    if(!index->loaded) index_load(index);
+
+    if(index->loaded) {
+        if(src == NULL) {
+            index_clear(index);
+            index_write_all(index);
+        }
+        else if(lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
+            index_entry_t entry;
+            lv_memzero(&entry, sizeof(entry));
+            entry.src = (char *)src;
+            lv_rb_node_t * node = lv_rb_find(&index->rb, &entry);
+            if(node) {
+                if(((index_entry_t *)node->data)->pending) index->pending_cnt--;
+                index_apply(index, &entry, true);
+                index_append(index, &entry);
+            }
+        }
+    }
+    index_unlock(index);
+}
+
+lv_result_t lv_image_header_index_save(void)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return LV_RESULT_INVALID;
+
+    lv_result_t res = LV_RESULT_INVALID;
+    index_lock(index);
+    if(!index->loaded) index_load(index);
+    if(index->loaded) res = index_write_all(index);
+    index_unlock(index);
+
+    return res;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_rb_compare_res_t index_compare_cb(const index_entry_t * lhs, const index_entry_t * rhs)
+{
+    int32_t cmp_res = lv_strcmp(lhs->src, rhs->src);
+    if(cmp_res == 0) return 0;
+    return cmp_res > 0 ? 1 : -1;
+}
+
+/**
+ * Read the index file. Leaves `index->loaded` false if the drive is not available yet.
+ * @param index     pointer to the index
+ */
+static void index_load(lv_image_header_index_t * index)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, LV_IMAGE_HEADER_INDEX_PATH, LV_FS_MODE_RD);
+    if(res == LV_FS_RES_NOT_EX || res == LV_FS_RES_HW_ERR) return;
+
+    index->loaded = true;
+    if(res != LV_FS_RES_OK) return;
+
+    index_file_header_t file_header;
+    uint32_t br;
+    res = lv_fs_read(&file, &file_header, sizeof(file_header), &br);
+    if(res != LV_FS_RES_OK || br != sizeof(file_header) ||
+       file_header.magic != INDEX_MAGIC || file_header.version != INDEX_VERSION ||
+       file_header.header_size != sizeof(lv_image_header_t)) {
+        LV_LOG_WARN("Invalid image header index, it will be rewritten");
+        lv_fs_close(&file);
+        return;
+    }
+
+    index->file_valid = true;
+
+    /*Read all records at once as reading many small pieces is slow on most file systems*/
+    uint8_t * buf = file_header.used ? lv_malloc(file_header.used) : NULL;
+    if(buf == NULL) {
+        lv_fs_close(&file);
+        return;
+    }
+
+    res = lv_fs_read(&file, buf, file_header.used, &br);
+    lv_fs_close(&file);
+    if(res != LV_FS_RES_OK) br = 0;
+
+    /*Parse until the first broken record. New records will overwrite it.*/
+    char path[LV_FS_MAX_PATH_LENGTH];
+    uint32_t used = 0;
+    while(used + sizeof(index_record_t) <= br) {
+        index_record_t record;
+        lv_memcpy(&record, buf + used, sizeof(record));
+        if(record.path_len == 0 || record.path_len >= LV_FS_MAX_PATH_LENGTH) break;
+        if(record.decoder_name_len >= DECODER_NAME_MAX) break;
+
+        uint32_t record_len = sizeof(record) + record.path_len + record.decoder_name_len;
+        if(used + record_len > br) break;
+
+        index_entry_t entry;
+        lv_memzero(&entry, sizeof(entry));
+        lv_memcpy(path, buf + used + sizeof(record), record.path_len);
+        path[record.path_len] = '\0';
+        lv_memcpy(entry.decoder_name, buf + used + sizeof(record) + record.path_len, record.decoder_name_len);
+
+        entry.src = path;
+        entry.size = record.size;
+        entry.mtime = record.mtime;
+        entry.header = record.header;
+        index_apply(index, &entry, record.decoder_name_len == 0);
+
+        index->record_cnt++;
+        used += record_len;
+    }
+
+    index->used = used;
+    lv_free(buf);
+
+    LV_LOG_INFO("Loaded %" LV_PRIu32 " image headers from %" LV_PRIu32 " records", index->entry_cnt, index->record_cnt);
+
+    /*Remove the outdated records if they are the majority*/
+    if(index->record_cnt > 2 * index->entry_cnt + 16) index_write_all(index);
+}
+
+/**
+ * Add, update or remove an entry in memory
+ * @param index     pointer to the index
+ * @param entry     the entry to add. Its `src` is duplicated if it's a new entry.
+ * @param drop      true: remove the entry instead
+ */
+static void index_apply(lv_image_header_index_t * index, index_entry_t * entry, bool drop)
+{
+    lv_rb_node_t * node = lv_rb_find(&index->rb, entry);
+    if(drop) {
+        if(node) {
+            lv_free(((index_entry_t *)node->data)->src);
+            lv_rb_drop_node(&index->rb, node);
+            index->entry_cnt--;
+        }
+        return;
+    }
+
+    if(node) {
+        index_entry_t * old = node->data;
+        char * src = old->src;
+        *old = *entry;
+        old->src = src;
+        return;
+    }
+
+    char * src = lv_strdup(entry->src);
+    LV_ASSERT_MALLOC(src);
+    if(src == NULL) return;
+
+    node = lv_rb_insert(&index->rb, entry);
+    if(node == NULL) {
+        lv_free(src);
+        return;
+    }
+
+    lv_memcpy(node->data, entry, sizeof(index_entry_t));
+    ((index_entry_t *)node->data)->src = src;
+    index->entry_cnt++;
+}
+
+/**
+ * Add the records of the pending entries to the end of the index file
+ * @param index     pointer to the index
+ * @param dropped   an entry to write as removed, or NULL
+ */
+static void index_append(lv_image_header_index_t * index, const index_entry_t * dropped)
+{
+    if(!index->file_valid) {
+        index_write_all(index);
+        return;
+    }
+
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, LV_IMAGE_HEADER_INDEX_PATH, LV_FS_MODE_RD | LV_FS_MODE_WR);
+    if(res != LV_FS_RES_OK) {
+        index_write_all(index);
+        return;
+    }
+
+    uint32_t used = index->used;
+    lv_fs_seek(&file, sizeof(index_file_header_t) + used, LV_FS_SEEK_SET);
+
+    lv_result_t result = LV_RESULT_OK;
+    if(dropped) result = record_write(&file, dropped, true, &used);
+    if(result == LV_RESULT_OK) result = index_write_node(&file, index->rb.root, true, &used);
+
+    if(result == LV_RESULT_OK) {
+        /*Make the records valid only after they are written*/
+        uint32_t bw;
+        lv_fs_seek(&file, INDEX_USED_OFFSET, LV_FS_SEEK_SET);
+        res = lv_fs_write(&file, &used, sizeof(used), &bw);
+        if(res == LV_FS_RES_OK && bw == sizeof(used)) {
+            index->used = used;
+            index->record_cnt += index->pending_cnt + (dropped ? 1 : 0);
+            index->pending_cnt = 0;
+            index_clear_pending(index->rb.root);
+        }
+    }
+
+    lv_fs_close(&file);
+}
+
+/**
+ * Write all entries to a new index file
+ * @param index     pointer to the index
+ * @return          LV_RESULT_OK: the file was written
+ */
+static lv_result_t index_write_all(lv_image_header_index_t * index)
+{
+    index->file_valid = false;
+
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, LV_IMAGE_HEADER_INDEX_PATH, LV_FS_MODE_WR);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't create the image header index: %s", LV_IMAGE_HEADER_INDEX_PATH);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Some drivers don't truncate the file, so `used` tells where the records end*/
+    index_file_header_t file_header;
+    file_header.magic = INDEX_MAGIC;
+    file_header.version = INDEX_VERSION;
+    file_header.header_size = sizeof(lv_image_header_t);
+    file_header.used = 0;
+
+    uint32_t bw;
+    uint32_t used = 0;
+    lv_result_t result = LV_RESULT_INVALID;
+    res = lv_fs_write(&file, &file_header, sizeof(file_header), &bw);
+    if(res == LV_FS_RES_OK && bw == sizeof(file_header) &&
+       index_write_node(&file, index->rb.root, false, &used) == LV_RESULT_OK) {
+        lv_fs_seek(&file, INDEX_USED_OFFSET, LV_FS_SEEK_SET);
+        res = lv_fs_write(&file, &used, sizeof(used), &bw);
+        if(res == LV_FS_RES_OK && bw == sizeof(used)) result = LV_RESULT_OK;
+    }
+
+    lv_fs_close(&file);
+
+    if(result == LV_RESULT_OK) {
+        index->file_valid = true;
+        index->used = used;
+        index->record_cnt = index->entry_cnt;
+        index->pending_cnt = 0;
+        index_clear_pending(index->rb.root);
+    }
+
+    return result;
+}
+
+/**
+ * Write the entries of a subtree
+ * @param file          the opened index file
+ * @param node          root of the subtree
+ * @param pending_only  true: write only the entries not written yet
+ * @param used          increased by the length of the written records
+ * @return              LV_RESULT_OK: all entries were written
+ */
+static lv_result_t index_write_node(lv_fs_file_t * file, lv_rb_node_t * node, bool pending_only, uint32_t * used)
+{
+    if(node == NULL) return LV_RESULT_OK;
+
+    if(index_write_node(file, node->left, pending_only, used) != LV_RESULT_OK) return LV_RESULT_INVALID;
+
+    index_entry_t * entry = node->data;
+    if(!pending_only || entry->pending) {
+        if(record_write(file, entry, false, used) != LV_RESULT_OK) return LV_RESULT_INVALID;
+    }
+
+    return index_write_node(file, node->right, pending_only, used);
+}
+
+static void index_clear_pending(lv_rb_node_t * node)
+{
+    if(node == NULL) return;
+
+    ((index_entry_t *)node->data)->pending = false;
+    index_clear_pending(node->left);
+    index_clear_pending(node->right);
+}
+
+static lv_result_t record_write(lv_fs_file_t * file, const index_entry_t * entry, bool drop, uint32_t * used)
+{
+    index_record_t record;
+    lv_memzero(&record, sizeof(record));
+    record.path_len = (uint16_t)lv_strlen(entry->src);
+    record.decoder_name_len = drop ? 0 : (uint8_t)lv_strlen(entry->decoder_name);
+    record.size = entry->size;
+    record.mtime = entry->mtime;
+    record.header = entry->header;
+
+    uint32_t bw;
+    lv_fs_res_t res = lv_fs_write(file, &record, sizeof(record), &bw);
+    if(res != LV_FS_RES_OK || bw != sizeof(record)) return LV_RESULT_INVALID;
+
+    res = lv_fs_write(file, entry->src, record.path_len, &bw);
+    if(res != LV_FS_RES_OK || bw != record.path_len) return LV_RESULT_INVALID;
+
+    if(record.decoder_name_len) {
+        res = lv_fs_write(file, entry->decoder_name, record.decoder_name_len, &bw);
+        if(res != LV_FS_RES_OK || bw != record.decoder_name_len) return LV_RESULT_INVALID;
+    }
+
+    *used += sizeof(record) + record.path_len + record.decoder_name_len;
+    return LV_RESULT_OK;
+}
+
+static void index_timer_cb(lv_timer_t * t)
+{
+    lv_image_header_index_t * index = lv_timer_get_user_data(t);
+
+    index_lock(index);
+    if(index->pending_cnt) index_append(index, NULL);
+    index_unlock(index);
+}
+
+static void index_clear(lv_image_header_index_t * index)
+{
+    index_free_node(index->rb.root);
+    lv_rb_destroy(&index->rb);
+    lv_rb_init(&index->rb, (lv_rb_compare_t)index_compare_cb, sizeof(index_entry_t));
+    index->entry_cnt = 0;
+    index->pending_cnt = 0;
+}
+
+static void index_free_node(lv_rb_node_t * node)
+{
+    if(node == NULL) return;
+
+    index_free_node(node->left);
+    index_free_node(node->right);
+    lv_free(((index_entry_t *)node->data)->src);
+}
+
+static inline void index_lock(lv_image_header_index_t * index)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&index->lock);
+#else
+    LV_UNUSED(index);
+#endif
+}
+
+static inline void index_unlock(lv_image_header_index_t * index)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&index->lock);
+#else
+    LV_UNUSED(index);
+#endif
+}
+
+#endif /*LV_USE_IMAGE_HEADER_INDEX*/
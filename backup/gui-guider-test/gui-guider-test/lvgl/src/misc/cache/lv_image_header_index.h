@@ -0,0 +1,64 @@
+/**
+* @file lv_image_header_index.h
+*
+ */
+
+#ifndef LV_IMAGE_HEADER_INDEX_H
+#define LV_IMAGE_HEADER_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+#include "../lv_types.h"
+
+#if LV_USE_IMAGE_HEADER_INDEX
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Remove an image from the persistent header index, e.g. if it was replaced
+ * by a file with the same size on a file system without modification time.
+ * Use NULL to clear the index.
+ * @param src   path of an image file or NULL
+ */
+void lv_image_header_index_drop(const void * src);
+
+/**
+ * Rewrite the index file without the outdated and dropped entries.
+ * New entries are appended to the file when the image is opened the first time,
+ * so it's not required to call this function to keep the index.
+ * @return LV_RESULT_OK: the index was written; LV_RESULT_INVALID: failed to write the file
+ */
+lv_result_t lv_image_header_index_save(void);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_IMAGE_HEADER_INDEX*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMAGE_HEADER_INDEX_H*/
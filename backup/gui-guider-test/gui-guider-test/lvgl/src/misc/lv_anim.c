@@ -44,10 +44,27 @@ static uint32_t convert_speed_to_time(uint32_t speed, int32_t start, int32_t end
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(lv_anim_t * a_current);
 static void remove_anim(void * a);
+static void anim_step(lv_anim_t * a, uint32_t elaps);
+static void anim_unlink(lv_anim_t * a);
+static int32_t anim_path_ease(const lv_anim_t * a, lv_anim_ease_t ease);
+static int32_t anim_ease_step(lv_anim_ease_t ease, int32_t t);
+#if LV_USE_ANIM_BATCH
+    static bool anim_active_add(lv_anim_t * a);
+    static void anim_active_compact(void);
+    static uint32_t anim_var_hash(const void * var);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*x1, y1, x2, y2 of the built-in eases*/
+static const int16_t ease_params[LV_ANIM_EASE_LAST][4] = {
+    {LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(1), LV_BEZIER_VAL_FLOAT(1)},     /*Ease in*/
+    {LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1)},     /*Ease out*/
+    {LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1)},  /*Ease in out*/
+    {341, 0, 683, 1300},                                                                                    /*Overshoot*/
+    {341, 500, 683, 800},                                                                                   /*Bounce*/
+};
 
 /**********************
  *      MACROS
@@ -74,6 +91,18 @@ void lv_anim_core_init(void)
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+#if LV_USE_ANIM_BATCH
+    uint32_t i;
+    for(i = 0; i < LV_ANIM_EASE_LAST; i++) {
+        lv_free(state.ease_lut[i]);
+        state.ease_lut[i] = NULL;
+    }
+    lv_free(state.active);
+    state.active = NULL;
+    state.active_cnt = 0;
+    state.active_size = 0;
+#endif
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -103,6 +132,14 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
 
+#if LV_USE_ANIM_BATCH
+    if(!anim_active_add(new_anim)) {
+        lv_ll_remove(anim_ll_p, new_anim);
+        lv_free(new_anim);
+        return NULL;
+    }
+#endif
+
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->get_value_cb) {
@@ -135,6 +172,10 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
 
 bool lv_anim_pause(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+#if LV_USE_ANIM_BATCH
+    if(var && state.var_cnt[anim_var_hash(var)] == 0) return false;
+#endif
+
     lv_anim_t * a;
     lv_anim_t * a_next;
     bool pause = false;
@@ -155,6 +196,10 @@ bool lv_anim_pause(void * var, lv_anim_exec_xcb_t exec_cb)
 
 bool lv_anim_resume(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+#if LV_USE_ANIM_BATCH
+    if(var && state.var_cnt[anim_var_hash(var)] == 0) return false;
+#endif
+
     lv_anim_t * a;
     lv_anim_t * a_next;
     bool resume = false;
@@ -188,6 +233,11 @@ uint32_t lv_anim_get_playtime(const lv_anim_t * a)
 
 bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+#if LV_USE_ANIM_BATCH
+    /*Called for each deleted widget, so it's important to return quickly if there are no animations*/
+    if(var && state.var_cnt[anim_var_hash(var)] == 0) return false;
+#endif
+
     lv_anim_t * a;
     bool del_any = false;
     a        = lv_ll_get_head(anim_ll_p);
@@ -217,6 +267,10 @@ void lv_anim_delete_all(void)
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+#if LV_USE_ANIM_BATCH
+    if(state.var_cnt[anim_var_hash(var)] == 0) return NULL;
+#endif
+
     lv_anim_t * a;
     LV_LL_READ(anim_ll_p, a) {
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
@@ -303,25 +357,22 @@ int32_t lv_anim_path_linear(const lv_anim_t * a)
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(1), LV_BEZIER_VAL_FLOAT(1));
+    return anim_path_ease(a, LV_ANIM_EASE_IN);
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
+    return anim_path_ease(a, LV_ANIM_EASE_OUT);
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
+    return anim_path_ease(a, LV_ANIM_EASE_IN_OUT);
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, 341, 0, 683, 1300);
+    return anim_path_ease(a, LV_ANIM_EASE_OVERSHOOT);
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -366,7 +417,7 @@ int32_t lv_anim_path_bounce(const lv_anim_t * a)
 
     if(t > LV_BEZIER_VAL_MAX) t = LV_BEZIER_VAL_MAX;
     if(t < 0) t = 0;
-    int32_t step = lv_bezier3(t, 0, 500, 800, LV_BEZIER_VAL_MAX);
+    int32_t step = anim_ease_step(LV_ANIM_EASE_BOUNCE, t);
 
     int32_t new_value;
     new_value = step * diff;
@@ -538,6 +589,28 @@ static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
+#if LV_USE_ANIM_BATCH
+    /*The animations deleted meanwhile are NULL, the ones started meanwhile are added after the visited ones.
+     *Go backward to keep the order of the linked list (newest first).*/
+    uint32_t tick = lv_tick_get();
+    uint32_t i = state.active_cnt;
+    bool in_timer_prev = state.in_timer;  /*`lv_anim_refr_now()` might be called from an animation*/
+    state.in_timer = true;
+    while(i > 0) {
+        i--;
+        lv_anim_t * a = state.active[i];
+        if(a == NULL) continue;
+
+        uint32_t elaps = tick - a->last_timer_run;
+        a->last_timer_run = tick;
+
+        state.anim_list_changed = false;
+        if(!a->anim_pause) anim_step(a, elaps);
+    }
+    state.in_timer = in_timer_prev;
+
+    if(!state.in_timer && state.active_has_hole) anim_active_compact();
+#else
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
@@ -556,42 +629,7 @@ static void anim_timer(lv_timer_t * param)
         if(a->run_round != state.anim_run_round && !a->anim_pause) {
             a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
 
-            /*The animation will run now for the first time. Call `start_cb`*/
-            if(!a->start_cb_called && a->act_time >= 0) {
-
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
-
-                resolve_time(a);
-
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
-
-                /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
-                remove_concurrent_anims(a);
-            }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->duration) a->act_time = a->duration;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
-
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                    if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(!state.anim_list_changed && a->act_time >= a->duration) {
-                    anim_completed_handler(a);
-                }
-            }
+            anim_step(a, elaps);
         }
 
         /*If the linked list changed due to anim. delete then it's not safe to continue
@@ -601,7 +639,56 @@ static void anim_timer(lv_timer_t * param)
         else
             a = lv_ll_get_next(anim_ll_p, a);
     }
+#endif
+}
 
+/**
+ * Advance an animation and apply its new value
+ * @param a         pointer to an animation descriptor
+ * @param elaps     time elapsed since the last run of the animation
+ */
+static void anim_step(lv_anim_t * a, uint32_t elaps)
+{
+    /*The animation will run now for the first time. Call `start_cb`*/
+    if(!a->start_cb_called && a->act_time >= 0) {
+
+        if(a->early_apply == 0 && a->get_value_cb) {
+            int32_t v_ofs = a->get_value_cb(a);
+            a->start_value += v_ofs;
+            a->end_value += v_ofs;
+        }
+
+        resolve_time(a);
+
+        if(a->start_cb) a->start_cb(a);
+        a->start_cb_called = 1;
+
+        /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
+        remove_concurrent_anims(a);
+    }
+    a->act_time += elaps;
+    if(a->act_time >= 0) {
+        if(a->act_time > a->duration) a->act_time = a->duration;
+
+        /*The built-in eases only look up their step in a table with LV_USE_ANIM_BATCH (see `anim_ease_step()`)*/
+        int32_t new_value;
+        new_value = a->path_cb(a);
+
+        /*The exec calls are not merged per `var`. `remove_concurrent_anims()` leaves only one animation
+         *for a `var` and `exec_cb` pair, and the other animations of the same `var` set other properties
+         *through other callbacks, so there is nothing left to merge. Unchanged values are skipped.*/
+        if(new_value != a->current_value) {
+            a->current_value = new_value;
+            /*Apply the calculated value*/
+            if(a->exec_cb) a->exec_cb(a->var, new_value);
+            if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
+        }
+
+        /*If the time is elapsed the animation is ready*/
+        if(!state.anim_list_changed && a->act_time >= a->duration) {
+            anim_completed_handler(a);
+        }
+    }
 }
 
 /**
@@ -623,7 +710,7 @@ static void anim_completed_handler(lv_anim_t * a)
 
         /*Delete the animation from the list.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        lv_ll_remove(anim_ll_p, a);
+        anim_unlink(a);
         /*Flag that the list has changed*/
         anim_mark_list_change();
 
@@ -709,6 +796,11 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 {
     if(a_current->exec_cb == NULL && a_current->custom_exec_cb == NULL) return false;
 
+#if LV_USE_ANIM_BATCH
+    /*Only `a_current` animates this `var`*/
+    if(state.var_cnt[anim_var_hash(a_current->var)] <= 1) return false;
+#endif
+
     lv_anim_t * a;
     bool del_any = false;
     a = lv_ll_get_head(anim_ll_p);
@@ -722,7 +814,7 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            lv_ll_remove(anim_ll_p, a);
+            anim_unlink(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
             lv_free(a);
             /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
@@ -743,7 +835,124 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 static void remove_anim(void * a)
 {
     lv_anim_t * anim = a;
-    lv_ll_remove(anim_ll_p, a);
+    anim_unlink(anim);
     if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
     lv_free(a);
 }
+
+/**
+ * Remove an animation from the list of the running animations without freeing it
+ * @param a     pointer to an animation descriptor
+ */
+static void anim_unlink(lv_anim_t * a)
+{
+    lv_ll_remove(anim_ll_p, a);
+
+#if LV_USE_ANIM_BATCH
+    state.var_cnt[anim_var_hash(a->var)]--;
+    state.active[a->active_idx] = NULL;
+    state.active_has_hole = true;
+#endif
+}
+
+static int32_t anim_path_ease(const lv_anim_t * a, lv_anim_ease_t ease)
+{
+    /*Calculate the current step*/
+    int32_t t = lv_map(a->act_time, 0, a->duration, 0, LV_BEZIER_VAL_MAX);
+    int32_t step = anim_ease_step(ease, t);
+
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
+
+/**
+ * Get the step of a built-in ease
+ * @param ease      the ease to use
+ * @param t         time in [0..LV_BEZIER_VAL_MAX] range
+ * @return          the step in [0..LV_BEZIER_VAL_MAX] range (can be larger on overshoot)
+ */
+static int32_t anim_ease_step(lv_anim_ease_t ease, int32_t t)
+{
+    const int16_t * p = ease_params[ease];
+
+#if LV_USE_ANIM_BATCH
+    t = LV_CLAMP(0, t, LV_BEZIER_VAL_MAX);
+
+    /*Sample the whole curve once on first use (LV_BEZIER_VAL_MAX + 1 steps). The animations still
+     *call their `path_cb` one by one, only the Bezier evaluation is replaced by a lookup.*/
+    int16_t * lut = state.ease_lut[ease];
+    if(lut == NULL) {
+        lut = lv_malloc((LV_BEZIER_VAL_MAX + 1) * sizeof(int16_t));
+        LV_ASSERT_MALLOC(lut);
+        if(lut == NULL) return lv_cubic_bezier(t, p[0], p[1], p[2], p[3]);
+
+        int32_t i;
+        for(i = 0; i <= LV_BEZIER_VAL_MAX; i++) {
+            lut[i] = (int16_t)lv_cubic_bezier(i, p[0], p[1], p[2], p[3]);
+        }
+        state.ease_lut[ease] = lut;
+    }
+
+    return lut[t];
+#else
+    return lv_cubic_bezier(t, p[0], p[1], p[2], p[3]);
+#endif
+}
+
+#if LV_USE_ANIM_BATCH
+
+static bool anim_active_add(lv_anim_t * a)
+{
+    /*Don't move the animations while `anim_timer` iterates over them*/
+    if(state.active_cnt == state.active_size && state.active_has_hole && !state.in_timer) {
+        anim_active_compact();
+    }
+
+    if(state.active_cnt == state.active_size) {
+        uint32_t new_size = state.active_size ? state.active_size * 2 : 16;
+        lv_anim_t ** new_active = lv_realloc(state.active, new_size * sizeof(lv_anim_t *));
+        LV_ASSERT_MALLOC(new_active);
+        if(new_active == NULL) return false;
+        state.active = new_active;
+        state.active_size = new_size;
+    }
+
+    a->active_idx = state.active_cnt;
+    state.active[state.active_cnt] = a;
+    state.active_cnt++;
+    state.var_cnt[anim_var_hash(a->var)]++;
+
+    return true;
+}
+
+/**
+ * Remove the deleted animations from the array keeping the order of the others
+ */
+static void anim_active_compact(void)
+{
+    uint32_t i;
+    uint32_t cnt = 0;
+    for(i = 0; i < state.active_cnt; i++) {
+        lv_anim_t * a = state.active[i];
+        if(a == NULL) continue;
+
+        a->active_idx = cnt;
+        state.active[cnt] = a;
+        cnt++;
+    }
+
+    state.active_cnt = cnt;
+    state.active_has_hole = false;
+}
+
+static uint32_t anim_var_hash(const void * var)
+{
+    uintptr_t v = (uintptr_t)var;
+    return (uint32_t)((v >> 3) ^ (v >> 13)) & (LV_ANIM_VAR_FILTER_SIZE - 1);
+}
+
+#endif /*LV_USE_ANIM_BATCH*/
@@ -156,6 +156,9 @@ struct lv_anim_t {
     uint8_t start_cb_called : 1;  /**< Indicates that the `start_cb` was already called*/
     uint8_t early_apply  : 1;     /**< 1: Apply start value immediately even is there is `delay`*/
     bool anim_pause;
+#if LV_USE_ANIM_BATCH
+    uint32_t active_idx;          /**< Index in the array of the running animations*/
+#endif
 };
 
 /**********************
@@ -20,15 +20,41 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_USE_ANIM_BATCH
+/*Number of counters to filter the targets without animation. Must be a power of 2.*/
+#define LV_ANIM_VAR_FILTER_SIZE 1024
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * The built-in eases with fixed Bezier parameters
+ */
+typedef enum {
+    LV_ANIM_EASE_IN,
+    LV_ANIM_EASE_OUT,
+    LV_ANIM_EASE_IN_OUT,
+    LV_ANIM_EASE_OVERSHOOT,
+    LV_ANIM_EASE_BOUNCE,
+    LV_ANIM_EASE_LAST,
+} lv_anim_ease_t;
+
 typedef struct {
     bool anim_list_changed;
     bool anim_run_round;
     lv_timer_t * timer;
     lv_ll_t anim_ll;
+#if LV_USE_ANIM_BATCH
+    lv_anim_t ** active;            /**< The running animations, the newest is the last. NULL: deleted*/
+    uint32_t active_cnt;
+    uint32_t active_size;
+    bool active_has_hole;           /**< Compact `active` when the timer is not running*/
+    bool in_timer;
+    int16_t * ease_lut[LV_ANIM_EASE_LAST];                  /**< Steps of the eases for each `t`*/
+    uint16_t var_cnt[LV_ANIM_VAR_FILTER_SIZE];              /**< Number of animations per hash of `var`*/
+#endif
 } lv_anim_state_t;
 
 /**********************
@@ -388,6 +388,41 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p)
     return res;
 }
 
+lv_fs_res_t lv_fs_stat(const char * path, uint32_t * size, uint32_t * mtime)
+{
+    if(path == NULL) return LV_FS_RES_INV_PARAM;
+
+    resolved_path_t resolved_path = lv_fs_resolve_path(path);
+
+    lv_fs_drv_t * drv = lv_fs_get_drv(resolved_path.drive_letter);
+
+    if(drv == NULL) {
+        return LV_FS_RES_NOT_EX;
+    }
+
+    if(drv->ready_cb) {
+        if(drv->ready_cb(drv) == false) {
+            return LV_FS_RES_HW_ERR;
+        }
+    }
+
+    if(drv->stat_cb == NULL || drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    LV_PROFILER_BEGIN;
+
+    uint32_t size_tmp = 0;
+    uint32_t mtime_tmp = 0;
+    lv_fs_res_t res = drv->stat_cb(drv, resolved_path.real_path, &size_tmp, &mtime_tmp);
+    if(size) *size = size_tmp;
+    if(mtime) *mtime = mtime_tmp;
+
+    LV_PROFILER_END;
+
+    return res;
+}
+
 void lv_fs_drv_init(lv_fs_drv_t * drv)
 {
     lv_memzero(drv, sizeof(lv_fs_drv_t));
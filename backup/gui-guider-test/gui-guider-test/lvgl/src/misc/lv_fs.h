@@ -82,6 +82,8 @@ struct lv_fs_drv_t {
     lv_fs_res_t (*dir_read_cb)(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
     lv_fs_res_t (*dir_close_cb)(lv_fs_drv_t * drv, void * rddir_p);
 
+    lv_fs_res_t (*stat_cb)(lv_fs_drv_t * drv, const char * path, uint32_t * size, uint32_t * mtime);
+
     void * user_data; /**< Custom file user data*/
 };
 
@@ -219,6 +221,16 @@ lv_fs_res_t lv_fs_dir_read(lv_fs_dir_t * rddir_p, char * fn, uint32_t fn_len);
  */
 lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p);
 
+/**
+ * Get the size and the modification time of a file without opening it
+ * @param path      path to a file
+ * @param size      store the size of the file in bytes here
+ * @param mtime     store the modification time here. Its unit depends on the driver,
+ *                  it's only useful to check if the file has changed.
+ * @return          LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver has no `stat_cb`, or any other error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_stat(const char * path, uint32_t * size, uint32_t * mtime);
+
 /**
  * Fill a buffer with the letters of existing drivers
  * @param buf       buffer to store the letters ('\0' added after the last letter)
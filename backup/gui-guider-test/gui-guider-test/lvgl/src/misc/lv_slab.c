@@ -0,0 +1,211 @@
+/**
+ * @file lv_slab.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_slab_private.h"
+#if LV_USE_OBJ_SLAB
+
+#include "../core/lv_global.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define slab LV_GLOBAL_DEFAULT()->slab_state
+
+/*Aim for chunks of this size*/
+#define CHUNK_SIZE          2048
+#define CHUNK_MIN_BLOCKS    4
+
+#define HEADER_SIZE         sizeof(lv_slab_chunk_t *)
+#define CHUNK_HEADER_SIZE   LV_ALIGN_UP(sizeof(lv_slab_chunk_t), HEADER_SIZE)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_slab_chunk_t * chunk_create(uint32_t class_id);
+static void list_remove(lv_slab_chunk_t ** head, lv_slab_chunk_t * chunk);
+static void list_add(lv_slab_chunk_t ** head, lv_slab_chunk_t * chunk);
+static uint32_t get_block_size(uint32_t class_id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_slab_init(void)
+{
+    lv_memzero(&slab, sizeof(lv_slab_state_t));
+}
+
+void lv_slab_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_SLAB_CLASS_CNT; i++) {
+        while(slab.partial[i]) {
+            lv_slab_chunk_t * chunk = slab.partial[i];
+            list_remove(&slab.partial[i], chunk);
+            lv_free(chunk);
+        }
+        while(slab.full[i]) {
+            lv_slab_chunk_t * chunk = slab.full[i];
+            list_remove(&slab.full[i], chunk);
+            lv_free(chunk);
+        }
+    }
+    lv_memzero(&slab, sizeof(lv_slab_state_t));
+}
+
+void * lv_slab_alloc_zeroed(size_t size)
+{
+    uint8_t * block;
+    if(size == 0 || size > LV_OBJ_SLAB_MAX_SIZE) {
+        block = lv_malloc_zeroed_tagged(size + HEADER_SIZE, LV_MEM_TAG_OBJ);
+        if(block == NULL) return NULL;
+        *((lv_slab_chunk_t **)block) = NULL;
+        return block + HEADER_SIZE;
+    }
+
+    uint32_t class_id = (size - 1) / LV_SLAB_CLASS_STEP;
+    lv_slab_chunk_t * chunk = slab.partial[class_id];
+    if(chunk == NULL) {
+        chunk = chunk_create(class_id);
+        if(chunk == NULL) return NULL;
+        list_add(&slab.partial[class_id], chunk);
+    }
+
+    block = chunk->free_list;
+    chunk->free_list = *((void **)(block + HEADER_SIZE));
+    chunk->used_cnt++;
+    slab.used_cnt[class_id]++;
+
+    if(chunk->free_list == NULL) {
+        list_remove(&slab.partial[class_id], chunk);
+        list_add(&slab.full[class_id], chunk);
+    }
+
+    lv_memzero(block + HEADER_SIZE, get_block_size(class_id) - HEADER_SIZE);
+    return block + HEADER_SIZE;
+}
+
+void lv_slab_free(void * data)
+{
+    if(data == NULL) return;
+
+    uint8_t * block = (uint8_t *)data - HEADER_SIZE;
+    lv_slab_chunk_t * chunk = *((lv_slab_chunk_t **)block);
+    if(chunk == NULL) {
+        lv_free(block);
+        return;
+    }
+
+    uint32_t class_id = chunk->class_id;
+    if(chunk->free_list == NULL) {
+        list_remove(&slab.full[class_id], chunk);
+        list_add(&slab.partial[class_id], chunk);
+    }
+
+    *((void **)data) = chunk->free_list;
+    chunk->free_list = block;
+    chunk->used_cnt--;
+    slab.used_cnt[class_id]--;
+
+    /*Keep only one empty chunk per class to avoid allocating a new one on the next block*/
+    if(chunk->used_cnt == 0 && (chunk->prev || chunk->next)) {
+        list_remove(&slab.partial[class_id], chunk);
+        slab.chunk_cnt[class_id]--;
+        lv_free(chunk);
+    }
+}
+
+void lv_slab_monitor(lv_slab_monitor_t * mon_p)
+{
+    lv_memzero(mon_p, sizeof(lv_slab_monitor_t));
+
+    uint32_t i;
+    for(i = 0; i < LV_SLAB_CLASS_CNT; i++) {
+        if(slab.chunk_cnt[i] == 0) continue;
+
+        uint32_t block_size = get_block_size(i);
+        uint32_t block_cnt = LV_MAX(CHUNK_MIN_BLOCKS, (CHUNK_SIZE - CHUNK_HEADER_SIZE) / block_size);
+        mon_p->chunk_cnt += slab.chunk_cnt[i];
+        mon_p->total_size += slab.chunk_cnt[i] * (CHUNK_HEADER_SIZE + block_cnt * block_size);
+        mon_p->used_cnt += slab.used_cnt[i];
+        mon_p->free_cnt += slab.chunk_cnt[i] * block_cnt - slab.used_cnt[i];
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_slab_chunk_t * chunk_create(uint32_t class_id)
+{
+    uint32_t block_size = get_block_size(class_id);
+    uint32_t block_cnt = LV_MAX(CHUNK_MIN_BLOCKS, (CHUNK_SIZE - CHUNK_HEADER_SIZE) / block_size);
+
+    lv_slab_chunk_t * chunk = lv_malloc_tagged(CHUNK_HEADER_SIZE + block_cnt * block_size, LV_MEM_TAG_OBJ);
+    LV_ASSERT_MALLOC(chunk);
+    if(chunk == NULL) return NULL;
+
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->used_cnt = 0;
+    chunk->block_cnt = block_cnt;
+    chunk->class_id = class_id;
+
+    /*Link all the blocks into the free list. Each block knows its chunk*/
+    uint8_t * block = (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+    chunk->free_list = block;
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        *((lv_slab_chunk_t **)block) = chunk;
+        *((void **)(block + HEADER_SIZE)) = i < block_cnt - 1 ? block + block_size : NULL;
+        block += block_size;
+    }
+
+    slab.chunk_cnt[class_id]++;
+    return chunk;
+}
+
+static void list_remove(lv_slab_chunk_t ** head, lv_slab_chunk_t * chunk)
+{
+    if(chunk->prev) chunk->prev->next = chunk->next;
+    else *head = chunk->next;
+    if(chunk->next) chunk->next->prev = chunk->prev;
+
+    chunk->prev = NULL;
+    chunk->next = NULL;
+}
+
+static void list_add(lv_slab_chunk_t ** head, lv_slab_chunk_t * chunk)
+{
+    chunk->prev = NULL;
+    chunk->next = *head;
+    if(*head) (*head)->prev = chunk;
+    *head = chunk;
+}
+
+static uint32_t get_block_size(uint32_t class_id)
+{
+    return HEADER_SIZE + (class_id + 1) * LV_SLAB_CLASS_STEP;
+}
+
+#endif /*LV_USE_OBJ_SLAB*/
@@ -0,0 +1,81 @@
+/**
+ * @file lv_slab.h
+ *
+ */
+
+#ifndef LV_SLAB_H
+#define LV_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_types.h"
+
+#if LV_USE_OBJ_SLAB
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t total_size;    /**< Size of all the chunks allocated from the heap*/
+    uint32_t chunk_cnt;     /**< Number of the chunks*/
+    uint32_t used_cnt;      /**< Number of the blocks in use*/
+    uint32_t free_cnt;      /**< Number of the free blocks in the chunks*/
+} lv_slab_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the slab allocator. Called by LVGL in `lv_init()`
+ */
+void lv_slab_init(void);
+
+/**
+ * Free all the chunks of the slab allocator. Called by LVGL in `lv_deinit()`
+ */
+void lv_slab_deinit(void);
+
+/**
+ * Allocate a zeroed memory block from the chunk of its size class.
+ * Sizes larger than `LV_OBJ_SLAB_MAX_SIZE` are allocated by `lv_malloc_zeroed`.
+ * @param size      size of the memory block in bytes
+ * @return          pointer to the memory block or NULL on error
+ */
+void * lv_slab_alloc_zeroed(size_t size);
+
+/**
+ * Free a memory block allocated by `lv_slab_alloc_zeroed`.
+ * Chunks which become empty are freed, except one per size class.
+ * @param data      pointer to the memory block. Can be NULL.
+ */
+void lv_slab_free(void * data);
+
+/**
+ * Get the statistics of the slab allocator
+ * @param mon_p     pointer to a `lv_slab_monitor_t` to fill
+ */
+void lv_slab_monitor(lv_slab_monitor_t * mon_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_SLAB*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_SLAB_H*/
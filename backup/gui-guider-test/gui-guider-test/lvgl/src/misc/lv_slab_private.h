@@ -0,0 +1,68 @@
+/**
+ * @file lv_slab_private.h
+ *
+ */
+
+#ifndef LV_SLAB_PRIVATE_H
+#define LV_SLAB_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_slab.h"
+
+#if LV_USE_OBJ_SLAB
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** The size classes are `LV_SLAB_CLASS_STEP` bytes apart*/
+#define LV_SLAB_CLASS_STEP      16
+#define LV_SLAB_CLASS_CNT       (LV_OBJ_SLAB_MAX_SIZE / LV_SLAB_CLASS_STEP)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct lv_slab_chunk_t lv_slab_chunk_t;
+
+/**
+ * A chunk is allocated with `lv_malloc` and holds `block_cnt` equal sized blocks.
+ * Each block starts with a pointer to its chunk.
+ */
+struct lv_slab_chunk_t {
+    lv_slab_chunk_t * prev;     /**< Neighbors in the list of chunks with free blocks*/
+    lv_slab_chunk_t * next;
+    void * free_list;           /**< Singly linked list of the free blocks*/
+    uint16_t used_cnt;
+    uint16_t block_cnt;
+    uint16_t class_id;
+};
+
+typedef struct {
+    lv_slab_chunk_t * partial[LV_SLAB_CLASS_CNT];   /**< Chunks with free blocks per size class*/
+    lv_slab_chunk_t * full[LV_SLAB_CLASS_CNT];      /**< Chunks without free blocks per size class*/
+    uint32_t chunk_cnt[LV_SLAB_CLASS_CNT];
+    uint32_t used_cnt[LV_SLAB_CLASS_CNT];
+} lv_slab_state_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_SLAB*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_SLAB_PRIVATE_H*/
@@ -277,6 +277,12 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_free(old_values);
+#if LV_STYLE_PROP_BITMAP
+            if(prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+                style->prop_bitmap[prop >> 5] &= ~((uint32_t)1 << (prop & 0x1F));
+                for(j = (prop >> 5) + 1; j < sizeof(style->prop_rank); j++) style->prop_rank[j]--;
+            }
+#endif
             return true;
         }
     }
@@ -298,6 +304,19 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     lv_style_prop_t * props;
     int32_t i;
 
+#if LV_STYLE_PROP_BITMAP
+    /*The built-in properties are kept sorted so their position is known from the bitmap*/
+    int32_t pos = style->prop_cnt;
+    if(prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+        pos = lv_style_prop_bitmap_rank(style, prop);
+        if(style->prop_bitmap[prop >> 5] & ((uint32_t)1 << (prop & 0x1F))) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            values[pos] = value;
+            return;
+        }
+    }
+#endif
+
     if(style->values_and_props) {
         props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         for(i = style->prop_cnt - 1; i >= 0; i--) {
@@ -315,6 +334,30 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     style->values_and_props = values_and_props;
 
     props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+#if LV_STYLE_PROP_BITMAP
+    /*Shift all props to make place for the value before them and for the new prop at `pos`*/
+    for(i = style->prop_cnt - 1; i >= pos; i--) {
+        props[i + 1 + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
+    }
+    for(i = pos - 1; i >= 0; i--) {
+        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
+    }
+    /*Shift the values after `pos` too*/
+    for(i = style->prop_cnt - 1; i >= pos; i--) {
+        values[i + 1] = values[i];
+    }
+    style->prop_cnt++;
+
+    /*Set the new property and value*/
+    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    props[pos] = prop;
+    values[pos] = value;
+    if(prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+        style->prop_bitmap[prop >> 5] |= (uint32_t)1 << (prop & 0x1F);
+        for(i = (prop >> 5) + 1; i < (int32_t)sizeof(style->prop_rank); i++) style->prop_rank[i]++;
+    }
+#else
     /*Shift all props to make place for the value before them*/
     for(i = style->prop_cnt - 1; i >= 0; i--) {
         props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
@@ -323,11 +366,11 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     /*Go to the new position with the props*/
     props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
 
     /*Set the new property and value*/
     props[style->prop_cnt - 1] = prop;
     values[style->prop_cnt - 1] = value;
+#endif
 
     uint32_t group = lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
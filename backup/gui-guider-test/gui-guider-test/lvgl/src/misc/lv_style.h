@@ -374,6 +374,13 @@ typedef struct {
 
     uint32_t has_group;
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
+
+#if LV_STYLE_PROP_BITMAP
+    /**Bit `n` is set if the built-in property `n` is in the style. Not used for constant styles.
+     *The built-in properties are stored sorted by their ID, followed by the custom properties*/
+    uint32_t prop_bitmap[(LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32];
+    uint8_t prop_rank[(LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32];    /**< Number of set bits in the previous words*/
+#endif
 } lv_style_t;
 
 /**********************
@@ -484,6 +491,24 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+#if LV_STYLE_PROP_BITMAP
+/**
+ * Get the number of the set built-in properties with smaller ID than `prop`.
+ * As the built-in properties are stored sorted, it's also the index of `prop` in the style.
+ * @param style pointer to a non constant style
+ * @param prop  the ID of a built-in property
+ * @return      number of the set built-in properties before `prop`
+ */
+static inline uint32_t lv_style_prop_bitmap_rank(const lv_style_t * style, lv_style_prop_t prop)
+{
+    uint32_t bits = style->prop_bitmap[prop >> 5] & (((uint32_t)1 << (prop & 0x1F)) - 1);
+    /*Count the set bits. (`__builtin_popcount` would be a library call on many targets)*/
+    bits = bits - ((bits >> 1) & 0x55555555);
+    bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+    return style->prop_rank[prop >> 5] + ((((bits + (bits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+}
+#endif
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -497,6 +522,17 @@ lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style, lv_style_prop_t prop,
                                                        lv_style_value_t * value)
 {
+#if LV_STYLE_PROP_BITMAP
+    if(prop < LV_STYLE_NUM_BUILT_IN_PROPS && !lv_style_is_const(style)) {
+        uint32_t bit = (uint32_t)1 << (prop & 0x1F);
+        if((style->prop_bitmap[prop >> 5] & bit) == 0) return LV_STYLE_RES_NOT_FOUND;
+
+        lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+        *value = values[lv_style_prop_bitmap_rank(style, prop)];
+        return LV_STYLE_RES_FOUND;
+    }
+#endif
+
     if(lv_style_is_const(style)) {
         lv_style_const_prop_t * props = (lv_style_const_prop_t *)style->values_and_props;
         uint32_t i;
@@ -13,6 +13,7 @@
 #include "lv_assert.h"
 #include "lv_ll.h"
 #include "lv_profiler.h"
+#include "lv_math.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +25,12 @@
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
 
+#if LV_USE_TIMER_HEAP
+    #define HEAP_IDX_NONE   UINT32_MAX
+    #define HEAP_IDX_RAN    (UINT32_MAX - 1)
+    #define HEAP_MIN_SIZE   8
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,6 +41,14 @@
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+#if LV_USE_TIMER_HEAP
+    static lv_result_t heap_reserve(uint32_t cnt);
+    static void heap_schedule(lv_timer_t * timer);
+    static void heap_remove(lv_timer_t * timer);
+    static void heap_sift_up(uint32_t idx);
+    static void heap_sift_down(uint32_t idx);
+    static bool heap_is_earlier(const lv_timer_t * a, const lv_timer_t * b);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -90,6 +105,34 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
+#if LV_USE_TIMER_HEAP
+    /*Run the ready timers in the order of their next run time. The timers created or made ready
+     *meanwhile are in the heap too so they run in this call as well.
+     *The timers which ran are kept out of the heap to run them only once per call.*/
+    while(state_p->heap_cnt) {
+        lv_timer_t * timer_first = state_p->heap[0];
+        if(lv_timer_time_remaining(timer_first) > 0) break;
+
+        heap_remove(timer_first);
+        timer_first->heap_idx = HEAP_IDX_RAN;
+        timer_first->ran_next = state_p->ran_head;
+        state_p->ran_head = timer_first;
+
+        state_p->timer_deleted = false;
+        state_p->timer_created = false;
+        lv_timer_exec(timer_first);
+    }
+
+    while(state_p->ran_head) {
+        lv_timer_t * timer = state_p->ran_head;
+        state_p->ran_head = timer->ran_next;
+        timer->heap_idx = HEAP_IDX_NONE;
+        if(!timer->paused) heap_schedule(timer);
+    }
+
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->heap_cnt) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
+#else
     /*Run all timer from the list*/
     lv_timer_t * next;
     lv_timer_t * timer_active;
@@ -127,6 +170,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
 
         next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
     }
+#endif
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -167,6 +211,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+#if LV_USE_TIMER_HEAP
+    /*Make room in the heap in advance so that the timer can be always scheduled*/
+    if(heap_reserve(state.timer_cnt + 1) != LV_RESULT_OK) return NULL;
+#endif
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -179,6 +228,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
 
+#if LV_USE_TIMER_HEAP
+    new_timer->heap_idx = HEAP_IDX_NONE;
+    state.timer_cnt++;
+    heap_schedule(new_timer);
+#endif
+
     state.timer_created = true;
 
     lv_timer_handler_resume();
@@ -194,6 +249,10 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+#if LV_USE_TIMER_HEAP
+    heap_remove(timer);
+    state.timer_cnt--;
+#endif
     lv_ll_remove(timer_ll_p, timer);
     state.timer_deleted = true;
 
@@ -204,12 +263,18 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+#if LV_USE_TIMER_HEAP
+    heap_remove(timer);
+#endif
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+#if LV_USE_TIMER_HEAP
+    heap_schedule(timer);
+#endif
     lv_timer_handler_resume();
 }
 
@@ -217,12 +282,18 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+#if LV_USE_TIMER_HEAP
+    if(!timer->paused) heap_schedule(timer);
+#endif
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+#if LV_USE_TIMER_HEAP
+    if(!timer->paused) heap_schedule(timer);
+#endif
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
@@ -247,6 +318,9 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+#if LV_USE_TIMER_HEAP
+    if(!timer->paused) heap_schedule(timer);
+#endif
     lv_timer_handler_resume();
 }
 
@@ -261,6 +335,15 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+#if LV_USE_TIMER_HEAP
+    lv_free(state.heap);
+    state.heap = NULL;
+    state.heap_cnt = 0;
+    state.heap_size = 0;
+    state.timer_cnt = 0;
+    state.ran_head = NULL;
+#endif
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -321,6 +404,9 @@ static bool lv_timer_exec(lv_timer_t * timer)
         int32_t original_repeat_count = timer->repeat_count;
         if(timer->repeat_count > 0) timer->repeat_count--;
         timer->last_run = lv_tick_get();
+#if LV_USE_TIMER_HEAP
+        heap_schedule(timer);
+#endif
         LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
         if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
@@ -383,3 +469,138 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+#if LV_USE_TIMER_HEAP
+
+/**
+ * Be sure the heap can store a given number of timers
+ * @param cnt       number of timers
+ * @return          LV_RESULT_OK: there is enough room; LV_RESULT_INVALID: out of memory
+ */
+static lv_result_t heap_reserve(uint32_t cnt)
+{
+    if(cnt <= state.heap_size) return LV_RESULT_OK;
+
+    uint32_t new_size = state.heap_size ? state.heap_size * 2 : HEAP_MIN_SIZE;
+    if(new_size < cnt) new_size = cnt;
+    lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return LV_RESULT_INVALID;
+
+    state.heap = new_heap;
+    state.heap_size = new_size;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Add a timer to the heap or move it to its new place if its next run time has changed
+ * @param timer     pointer to a not paused timer
+ */
+static void heap_schedule(lv_timer_t * timer)
+{
+    timer->seq = state.seq++;
+
+    /*It will be added to the heap at the end of `lv_timer_handler` with its new run time*/
+    if(timer->heap_idx == HEAP_IDX_RAN) return;
+
+    if(timer->heap_idx != HEAP_IDX_NONE) {
+        heap_sift_up(timer->heap_idx);
+        heap_sift_down(timer->heap_idx);
+        return;
+    }
+
+    /*`lv_timer_create` made room for all timers*/
+    LV_ASSERT(state.heap_cnt < state.heap_size);
+
+    timer->heap_idx = state.heap_cnt;
+    state.heap[state.heap_cnt] = timer;
+    state.heap_cnt++;
+    heap_sift_up(timer->heap_idx);
+}
+
+/**
+ * Remove a timer from the heap if it's there
+ * @param timer     pointer to a timer
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx == HEAP_IDX_NONE) return;
+
+    if(idx == HEAP_IDX_RAN) {
+        lv_timer_t ** prev_next = &state.ran_head;
+        while(*prev_next != timer) prev_next = &(*prev_next)->ran_next;
+        *prev_next = timer->ran_next;
+        timer->heap_idx = HEAP_IDX_NONE;
+        return;
+    }
+
+    timer->heap_idx = HEAP_IDX_NONE;
+    state.heap_cnt--;
+    if(idx == state.heap_cnt) return;
+
+    /*Fill the gap with the last timer*/
+    lv_timer_t * last = state.heap[state.heap_cnt];
+    last->heap_idx = idx;
+    state.heap[idx] = last;
+    heap_sift_up(idx);
+    heap_sift_down(last->heap_idx);
+}
+
+static void heap_sift_up(uint32_t idx)
+{
+    lv_timer_t * timer = state.heap[idx];
+    while(idx > 0) {
+        uint32_t parent_idx = (idx - 1) / 2;
+        lv_timer_t * parent = state.heap[parent_idx];
+        if(!heap_is_earlier(timer, parent)) break;
+
+        parent->heap_idx = idx;
+        state.heap[idx] = parent;
+        idx = parent_idx;
+    }
+
+    timer->heap_idx = idx;
+    state.heap[idx] = timer;
+}
+
+static void heap_sift_down(uint32_t idx)
+{
+    lv_timer_t * timer = state.heap[idx];
+    while(1) {
+        uint32_t child_idx = idx * 2 + 1;
+        if(child_idx >= state.heap_cnt) break;
+        if(child_idx + 1 < state.heap_cnt && heap_is_earlier(state.heap[child_idx + 1], state.heap[child_idx])) child_idx++;
+
+        lv_timer_t * child = state.heap[child_idx];
+        if(!heap_is_earlier(child, timer)) break;
+
+        child->heap_idx = idx;
+        state.heap[idx] = child;
+        idx = child_idx;
+    }
+
+    timer->heap_idx = idx;
+    state.heap[idx] = timer;
+}
+
+/**
+ * Tell if a timer needs to run before an other one
+ * @param a     pointer to a timer
+ * @param b     pointer to an other timer
+ * @return      true: `a` runs first
+ */
+static bool heap_is_earlier(const lv_timer_t * a, const lv_timer_t * b)
+{
+    /*Compare the differences to handle the overflow of the tick.
+     *Limit the periods so that the very long ones can't overflow the difference.*/
+    uint32_t a_next = a->last_run + LV_MIN(a->period, INT32_MAX / 2);
+    uint32_t b_next = b->last_run + LV_MIN(b->period, INT32_MAX / 2);
+    int32_t diff = (int32_t)(a_next - b_next);
+    if(diff != 0) return diff < 0;
+
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+#endif /*LV_USE_TIMER_HEAP*/
+
@@ -35,6 +35,12 @@ struct lv_timer_t {
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+#if LV_USE_TIMER_HEAP
+    uint32_t heap_idx;         /**< Index in the timer heap, `UINT32_MAX` if paused, `UINT32_MAX - 1` if it
+                                *   already ran in the current `lv_timer_handler` call */
+    uint32_t seq;              /**< Orders the timers with the same next run time */
+    lv_timer_t * ran_next;     /**< The next timer which already ran in the current `lv_timer_handler` call */
+#endif
 };
 
 typedef struct {
@@ -54,6 +60,15 @@ typedef struct {
 
     lv_timer_handler_resume_cb_t resume_cb;
     void * resume_data;
+
+#if LV_USE_TIMER_HEAP
+    lv_timer_t ** heap;        /**< The not paused timers, the one to run next is the first */
+    uint32_t heap_cnt;
+    uint32_t heap_size;        /**< Always enough for all timers so scheduling them can't fail */
+    uint32_t timer_cnt;
+    uint32_t seq;              /**< Incremented each time a timer is scheduled */
+    lv_timer_t * ran_head;     /**< The timers which ran in the current call. Scheduled again at the end of the call. */
+#endif
 } lv_timer_state_t;
 
 /**********************
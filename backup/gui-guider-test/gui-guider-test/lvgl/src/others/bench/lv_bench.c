@@ -0,0 +1,253 @@
+/**
+ * @file lv_bench.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_bench.h"
+
+#if LV_USE_BENCH != 0
+
+#include "../../core/lv_global.h"
+#include "../../core/lv_obj.h"
+#include "../../display/lv_display.h"
+#include "../../misc/lv_anim.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_log.h"
+#include "../../osal/lv_os.h"
+#include "../../stdlib/lv_mem.h"
+#include "../../tick/lv_tick_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_ANIM_PERIOD   16
+#define BENCH_MEM_SLOT_CNT  64
+#define BENCH_MEM_STACK_SIZE (8 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    int32_t value;
+    uint32_t sum;       /**< Checksum of the values applied by the animation*/
+} bench_anim_item_t;
+
+#if LV_USE_OS
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;      /**< Signaled when the thread is ready*/
+    uint32_t seed;
+    uint32_t op_cnt;
+    void * slots[BENCH_MEM_SLOT_CNT];
+} bench_mem_worker_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void anim_exec_cb(void * var, int32_t v);
+static void anim_completed_cb(lv_anim_t * a);
+#if LV_USE_OS
+    static void mem_worker_cb(void * user_data);
+    static uint32_t mem_rand(uint32_t * seed);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_bench_anim(uint32_t anim_cnt, uint32_t round_cnt, lv_bench_time_cb_t time_cb,
+                          lv_bench_anim_result_t * res)
+{
+    LV_ASSERT_NULL(time_cb);
+    LV_ASSERT_NULL(res);
+
+    static const lv_anim_path_cb_t paths[] = {
+        lv_anim_path_linear, lv_anim_path_ease_in_out, lv_anim_path_overshoot,
+        lv_anim_path_bounce, lv_anim_path_ease_out, lv_anim_path_ease_in
+    };
+
+    lv_memzero(res, sizeof(lv_bench_anim_result_t));
+
+    bench_anim_item_t * items = lv_malloc_zeroed(anim_cnt * sizeof(bench_anim_item_t));
+    LV_ASSERT_MALLOC(items);
+    if(items == NULL) return LV_RESULT_INVALID;
+
+    /*Use a simulated tick to apply the same values in each run*/
+    lv_tick_state_t * tick_state = &LV_GLOBAL_DEFAULT()->tick_state;
+    lv_tick_get_cb_t tick_cb = tick_state->tick_get_cb;
+    uint32_t sys_time = tick_state->sys_time;
+    lv_tick_set_cb(NULL);
+
+    uint32_t t = time_cb();
+    uint32_t i;
+    for(i = 0; i < anim_cnt; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &items[i]);
+        lv_anim_set_exec_cb(&a, anim_exec_cb);
+        lv_anim_set_values(&a, 0, 100 + (int32_t)i);
+        lv_anim_set_duration(&a, 300 + (i % 7) * 100);
+        lv_anim_set_path_cb(&a, paths[i % (sizeof(paths) / sizeof(paths[0]))]);
+        lv_anim_set_delay(&a, i % 50);
+        if(i % 10) {
+            lv_anim_set_playback_duration(&a, 200);
+            lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        }
+        else {
+            lv_anim_set_completed_cb(&a, anim_completed_cb);
+        }
+        lv_anim_start(&a);
+    }
+    res->start_time = time_cb() - t;
+
+    t = time_cb();
+    for(i = 0; i < round_cnt; i++) {
+        lv_tick_inc(BENCH_ANIM_PERIOD);
+        lv_anim_refr_now();
+    }
+    res->run_time = time_cb() - t;
+
+    /*Each deleted widget looks for its animations*/
+    if(lv_display_get_default()) {
+        lv_obj_t * scr = lv_obj_create(NULL);
+        for(i = 0; i < anim_cnt * 2; i++) {
+            lv_obj_create(scr);
+        }
+
+        t = time_cb();
+        lv_obj_delete(scr);
+        res->delete_time = time_cb() - t;
+    }
+
+    for(i = 0; i < anim_cnt; i++) {
+        lv_anim_delete(&items[i], anim_exec_cb);
+        res->checksum = res->checksum * 31 + items[i].sum;
+    }
+
+    lv_free(items);
+
+    tick_state->sys_time = sys_time;
+    lv_tick_set_cb(tick_cb);
+
+    LV_LOG_USER("%" LV_PRIu32 " animations: start %" LV_PRIu32 " us, %" LV_PRIu32 " rounds %" LV_PRIu32
+                " us, delete %" LV_PRIu32 " widgets %" LV_PRIu32 " us, checksum %08" LV_PRIx32,
+                anim_cnt, res->start_time, round_cnt, res->run_time, anim_cnt * 2, res->delete_time,
+                res->checksum);
+
+    return LV_RESULT_OK;
+}
+
+#if LV_USE_OS
+lv_result_t lv_bench_mem(uint32_t thread_cnt, uint32_t op_cnt, lv_bench_time_cb_t time_cb,
+                         lv_bench_mem_result_t * res)
+{
+    LV_ASSERT_NULL(time_cb);
+    LV_ASSERT_NULL(res);
+
+    lv_memzero(res, sizeof(lv_bench_mem_result_t));
+
+    bench_mem_worker_t * workers = lv_malloc_zeroed(thread_cnt * sizeof(bench_mem_worker_t));
+    LV_ASSERT_MALLOC(workers);
+    if(workers == NULL) return LV_RESULT_INVALID;
+
+    uint32_t t = time_cb();
+    uint32_t i;
+    for(i = 0; i < thread_cnt; i++) {
+        workers[i].seed = i + 1;
+        workers[i].op_cnt = op_cnt;
+        lv_thread_sync_init(&workers[i].sync);
+        lv_thread_init(&workers[i].thread, LV_THREAD_PRIO_MID, mem_worker_cb, BENCH_MEM_STACK_SIZE, &workers[i]);
+    }
+
+    for(i = 0; i < thread_cnt; i++) {
+        lv_thread_sync_wait(&workers[i].sync);
+        lv_thread_delete(&workers[i].thread);
+        lv_thread_sync_delete(&workers[i].sync);
+    }
+    res->time = time_cb() - t;
+    res->op_cnt = thread_cnt * op_cnt;
+
+    lv_free(workers);
+
+    LV_LOG_USER("%" LV_PRIu32 " threads: %" LV_PRIu32 " allocations and frees in %" LV_PRIu32 " us",
+                thread_cnt, res->op_cnt, res->time);
+
+    return LV_RESULT_OK;
+}
+#endif /*LV_USE_OS*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void anim_exec_cb(void * var, int32_t v)
+{
+    bench_anim_item_t * item = var;
+    item->value = v;
+    item->sum = item->sum * 31 + (uint32_t)v;
+}
+
+static void anim_completed_cb(lv_anim_t * a)
+{
+    bench_anim_item_t * item = a->var;
+    item->sum += 1000003;
+}
+
+#if LV_USE_OS
+static void mem_worker_cb(void * user_data)
+{
+    bench_mem_worker_t * worker = user_data;
+
+    uint32_t i;
+    for(i = 0; i < worker->op_cnt; i++) {
+        uint32_t k = mem_rand(&worker->seed) % BENCH_MEM_SLOT_CNT;
+        if(worker->slots[k]) {
+            lv_free(worker->slots[k]);
+            worker->slots[k] = NULL;
+        }
+        else {
+            uint8_t * p = lv_malloc(8 + mem_rand(&worker->seed) % 200);
+            if(p) p[0] = 1;     /*Touch the block as a real user would*/
+            worker->slots[k] = p;
+        }
+    }
+
+    for(i = 0; i < BENCH_MEM_SLOT_CNT; i++) {
+        lv_free(worker->slots[i]);
+        worker->slots[i] = NULL;
+    }
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_THREAD_CACHE
+    lv_mem_thread_cache_flush();
+#endif
+
+    lv_thread_sync_signal(&worker->sync);
+}
+
+/**
+ * Thread safe pseudo random numbers (xorshift32). `lv_rand()` has a shared state.
+ */
+static uint32_t mem_rand(uint32_t * seed)
+{
+    uint32_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *seed = x;
+    return x;
+}
+#endif /*LV_USE_OS*/
+
+#endif /*LV_USE_BENCH*/
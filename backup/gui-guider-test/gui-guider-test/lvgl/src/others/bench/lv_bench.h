@@ -0,0 +1,88 @@
+/**
+ * @file lv_bench.h
+ *
+ */
+#ifndef LV_BENCH_H
+#define LV_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_types.h"
+
+#if LV_USE_BENCH != 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Get a timestamp in microseconds. Used to measure the benchmarks.
+ */
+typedef uint32_t (*lv_bench_time_cb_t)(void);
+
+typedef struct {
+    uint32_t start_time;        /**< Starting all animations [us]*/
+    uint32_t run_time;          /**< Running all rounds of the animations [us]*/
+    uint32_t delete_time;       /**< Deleting `2 * anim_cnt` widgets while the animations run [us]*/
+    uint32_t checksum;          /**< Of the applied values. The same with and without `LV_USE_ANIM_BATCH`*/
+} lv_bench_anim_result_t;
+
+typedef struct {
+    uint32_t time;              /**< Running all threads [us]*/
+    uint32_t op_cnt;            /**< Number of `lv_malloc()` and `lv_free()` calls in all threads*/
+} lv_bench_mem_result_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Measure the animation core with many animations of mixed paths, delays, playback and repeat.
+ * The animations are driven by a simulated tick which is restored at the end.
+ * Should be called when no other animations run and `lv_tick_inc()` is not called.
+ * The widget deletion is measured only if there is a default display.
+ * @param anim_cnt      number of animations, e.g. 1000
+ * @param round_cnt     number of rounds to run the animations, 16 ms each
+ * @param time_cb       function to get a timestamp in microseconds
+ * @param res           store the results here
+ * @return              LV_RESULT_OK: finished; LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_bench_anim(uint32_t anim_cnt, uint32_t round_cnt, lv_bench_time_cb_t time_cb,
+                          lv_bench_anim_result_t * res);
+
+#if LV_USE_OS
+/**
+ * Measure `lv_malloc()` and `lv_free()` called from several threads at the same time.
+ * Each thread randomly allocates 8..207 bytes or frees one of its 64 blocks.
+ * Useful to compare the heap lock with the thread caches of `LV_MEM_THREAD_CACHE`.
+ * @param thread_cnt    number of threads to start
+ * @param op_cnt        number of operations in each thread
+ * @param time_cb       function to get a timestamp in microseconds
+ * @param res           store the results here
+ * @return              LV_RESULT_OK: finished; LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_bench_mem(uint32_t thread_cnt, uint32_t op_cnt, lv_bench_time_cb_t time_cb,
+                         lv_bench_mem_result_t * res);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_BENCH*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BENCH_H*/
@@ -17,6 +17,7 @@
 #include "../../stdlib/lv_string.h"
 #include "../../widgets/label/lv_label.h"
 #include "../../display/lv_display_private.h"
+#include "../../draw/lv_draw_buf.h"
 
 /*********************
  *      DEFINES
@@ -258,6 +259,11 @@ static void perf_update_timer_cb(lv_timer_t * t)
                                                                      info->measured.flush_in_render_elaps_sum) /
                                                                     info->measured.render_cnt) : 0;
 
+    uint32_t render_stall_time = lv_display_get_render_stall_time(disp);
+    info->calculated.render_stall_avg_time = info->measured.render_cnt ?
+                                             ((render_stall_time - info->measured.render_stall_time_at_report) /
+                                              info->measured.render_cnt) : 0;
+
     info->calculated.cpu_avg_total = ((info->calculated.cpu_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.cpu) / info->calculated.run_cnt;
     info->calculated.fps_avg_total = ((info->calculated.fps_avg_total * (info->calculated.run_cnt - 1)) +
@@ -273,6 +279,7 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.run_cnt = prev_info.calculated.run_cnt;
 
     info->measured.last_report_timestamp = lv_tick_get();
+    info->measured.render_stall_time_at_report = render_stall_time;
 }
 
 static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
@@ -283,11 +290,11 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_UNUSED(observer);
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
-           "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
+           "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms | stall %" LV_PRIu32 "ms), "
            "CPU %" LV_PRIu32 "%%\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
-           perf->calculated.cpu);
+           perf->calculated.render_stall_avg_time, perf->calculated.cpu);
 #else
     lv_obj_t * label = lv_observer_get_target(observer);
     lv_label_set_text_fmt(
@@ -322,12 +329,25 @@ static void mem_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     size_t used_kb_tenth = (used_size - (used_kb * 1024)) / 102;
     size_t max_used_kb = mon->max_used / 1024;
     size_t max_used_kb_tenth = (mon->max_used - (max_used_kb * 1024)) / 102;
+#if LV_USE_DRAW_BUF_POOL
+    lv_draw_buf_pool_monitor_t pool_mon;
+    lv_draw_buf_pool_monitor(&pool_mon);
+    lv_label_set_text_fmt(label,
+                          "%zu.%zu kB (%d%%)\n"
+                          "%zu.%zu kB max, %d%% frag.\n"
+                          "%" LV_PRIu32 " kB pool, %" LV_PRIu32 " kB max",
+                          used_kb, used_kb_tenth, mon->used_pct,
+                          max_used_kb, max_used_kb_tenth,
+                          mon->frag_pct,
+                          pool_mon.idle_size / 1024, pool_mon.max_size / 1024);
+#else
     lv_label_set_text_fmt(label,
                           "%zu.%zu kB (%d%%)\n"
                           "%zu.%zu kB max, %d%% frag.",
                           used_kb, used_kb_tenth, mon->used_pct,
                           max_used_kb, max_used_kb_tenth,
                           mon->frag_pct);
+#endif
 }
 
 #endif
@@ -38,18 +38,54 @@
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
 
+#define USE_THREAD_CACHE    (LV_MEM_THREAD_CACHE && LV_USE_OS)
+
+#if USE_THREAD_CACHE
+    #define THREAD_CACHE_STEP       16      /*Size classes are 16 bytes apart*/
+    #define THREAD_CACHE_CLASS_CNT  16      /*Cache blocks up to 256 bytes*/
+    #define THREAD_CACHE_BATCH      8       /*Number of blocks moved between the heap and a cache at once*/
+    #define THREAD_CACHE_LIMIT      32      /*Max number of blocks per class in a cache*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if USE_THREAD_CACHE
+typedef struct {
+    void * head[THREAD_CACHE_CLASS_CNT];    /**< Free blocks linked through their first word*/
+    uint8_t cnt[THREAD_CACHE_CLASS_CNT];
+    uint32_t heap_id;                       /**< The blocks are from this heap instance*/
+    lv_mem_thread_cache_monitor_t mon;      /**< Counters not published yet*/
+} thread_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+#if USE_THREAD_CACHE
+    static thread_cache_t * thread_cache_get(void);
+    static void * thread_cache_alloc(size_t size);
+    static bool thread_cache_free(void * p);
+    static void thread_cache_flush_class(thread_cache_t * tc, uint32_t class_id, uint32_t keep_cnt);
+    static void thread_cache_publish(thread_cache_t * tc);
+#endif
+#if LV_MEM_REGION_CNT
+    static lv_mem_region_t * region_find(const void * p);
+    static void region_free(lv_mem_region_t * region, void * p);
+    static void * region_realloc(lv_mem_region_t * region, void * p, size_t new_size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if USE_THREAD_CACHE
+    static LV_MEM_THREAD_CACHE_TLS thread_cache_t thread_cache;
+
+    /*Incremented on init and deinit to drop the caches holding blocks of an old heap*/
+    static uint32_t heap_id;
+#endif
 
 /**********************
  *      MACROS
@@ -74,6 +110,10 @@ void lv_mem_init(void)
     lv_mutex_init(&state.mutex);
 #endif
 
+#if USE_THREAD_CACHE
+    heap_id++;
+#endif
+
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
     state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
@@ -100,6 +140,19 @@ void lv_mem_init(void)
 
 void lv_mem_deinit(void)
 {
+#if USE_THREAD_CACHE
+    heap_id++;
+#endif
+#if LV_MEM_REGION_CNT
+    /*The memory of the regions is owned by the user*/
+    lv_memzero(state.regions, sizeof(state.regions));
+    state.region_cnt = 0;
+    lv_memzero(&state.default_mon, sizeof(state.default_mon));
+    lv_memzero(state.fallback, sizeof(state.fallback));
+#if LV_MEM_REGION_SIM
+    state.default_sim_latency = 0;
+#endif
+#endif
     lv_ll_clear(&state.pool_ll);
     lv_tlsf_destroy(state.tlsf);
 #if LV_USE_OS
@@ -138,11 +191,31 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 void * lv_malloc_core(size_t size)
 {
+#if USE_THREAD_CACHE
+    if(size <= THREAD_CACHE_CLASS_CNT * THREAD_CACHE_STEP) {
+        void * p = thread_cache_alloc(size);
+        if(p) return p;
+    }
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
+#endif
+#if USE_THREAD_CACHE
+    state.thread_cache_mon.lock_cnt++;
 #endif
     void * p = lv_tlsf_malloc(state.tlsf, size);
 
+#if USE_THREAD_CACHE
+    if(p == NULL) {
+        /*Give back the blocks cached by this thread and try again*/
+        thread_cache_t * tc = thread_cache_get();
+        uint32_t i;
+        for(i = 0; i < THREAD_CACHE_CLASS_CNT; i++) thread_cache_flush_class(tc, i, 0);
+        p = lv_tlsf_malloc(state.tlsf, size);
+    }
+#endif
+
     if(p) {
         state.cur_used += lv_tlsf_block_size(p);
         state.max_used = LV_MAX(state.cur_used, state.max_used);
@@ -154,11 +227,220 @@ void * lv_malloc_core(size_t size)
     return p;
 }
 
+#if LV_MEM_REGION_CNT
+int32_t lv_mem_add_region(void * mem, size_t bytes, lv_mem_tag_t tag)
+{
+    LV_ASSERT_NULL(mem);
+    if(tag == LV_MEM_TAG_DEFAULT || tag >= LV_MEM_TAG_LAST) {
+        LV_LOG_WARN("invalid tag: %d", (int)tag);
+        return -1;
+    }
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    int32_t id = -1;
+    if(state.region_cnt >= LV_MEM_REGION_CNT) {
+        LV_LOG_WARN("no space for a new region, increase LV_MEM_REGION_CNT");
+    }
+    else {
+        lv_tlsf_t tlsf = lv_tlsf_create_with_pool(mem, bytes);
+        if(tlsf == NULL) {
+            LV_LOG_WARN("failed to add memory region, address: %p, size: %zu", mem, bytes);
+        }
+        else {
+            lv_mem_region_t * region = &state.regions[state.region_cnt];
+            lv_memzero(region, sizeof(lv_mem_region_t));
+            region->tlsf = tlsf;
+            region->start = mem;
+            region->end = (uint8_t *)mem + bytes;
+            region->mon.tag = tag;
+            region->mon.total_size = bytes;
+            state.region_cnt++;
+            id = (int32_t)state.region_cnt;
+        }
+    }
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    return id;
+}
+
+void lv_mem_set_fallback(lv_mem_tag_t tag, lv_mem_tag_t fallback)
+{
+    if(tag >= LV_MEM_TAG_LAST || fallback >= LV_MEM_TAG_LAST) {
+        LV_LOG_WARN("invalid tag");
+        return;
+    }
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    state.fallback[tag] = fallback;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+uint32_t lv_mem_get_region_count(void)
+{
+    return state.region_cnt + 1;
+}
+
+void lv_mem_region_monitor(uint32_t id, lv_mem_region_monitor_t * mon_p)
+{
+    LV_ASSERT_NULL(mon_p);
+    lv_memzero(mon_p, sizeof(lv_mem_region_monitor_t));
+
+    if(id == 0) {
+        lv_mem_monitor_t heap_mon;
+        lv_mem_monitor_core(&heap_mon);
+        mon_p->total_size = heap_mon.total_size;
+    }
+    else if(id > state.region_cnt) {
+        LV_LOG_WARN("invalid region: %" LV_PRIu32, id);
+        return;
+    }
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    if(id == 0) {
+        size_t total_size = mon_p->total_size;
+        *mon_p = state.default_mon;
+        mon_p->tag = LV_MEM_TAG_DEFAULT;
+        mon_p->total_size = total_size;
+        mon_p->cur_used = state.cur_used;
+        mon_p->max_used = state.max_used;
+    }
+    else {
+        *mon_p = state.regions[id - 1].mon;
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    /*The cost is accumulated per byte to not lose the small accesses*/
+    mon_p->sim_cost /= 1024;
+}
+
+void * lv_malloc_core_tagged(size_t size, lv_mem_tag_t tag)
+{
+    if(state.region_cnt == 0) return lv_malloc_core(size);
+    if(tag >= LV_MEM_TAG_LAST) tag = LV_MEM_TAG_DEFAULT;
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    /*Try the regions of the tag, then the regions of its fallbacks. Limit the steps in case of a loop.*/
+    lv_mem_tag_t cur_tag = tag;
+    uint32_t step;
+    for(step = 0; step < LV_MEM_TAG_LAST && cur_tag != LV_MEM_TAG_DEFAULT; step++) {
+        uint32_t i;
+        for(i = 0; i < state.region_cnt; i++) {
+            lv_mem_region_t * region = &state.regions[i];
+            if(region->mon.tag != cur_tag) continue;
+
+            void * p = lv_tlsf_malloc(region->tlsf, size);
+            if(p == NULL) {
+                if(cur_tag == tag) region->mon.fail_cnt++;
+                continue;
+            }
+
+            size_t block_size = lv_tlsf_block_size(p);
+            region->mon.cur_used += block_size;
+            region->mon.max_used = LV_MAX(region->mon.cur_used, region->mon.max_used);
+            if(cur_tag == tag) region->mon.alloc_cnt++;
+            else region->mon.fallback_cnt++;
+#if LV_MEM_REGION_SIM
+            region->mon.sim_cost += (uint64_t)region->sim_latency * block_size;
+#endif
+
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return p;
+        }
+
+        cur_tag = state.fallback[cur_tag];
+    }
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    /*The default heap is the last resort of every tag*/
+    void * p = lv_malloc_core(size);
+    if(p == NULL) return NULL;
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    if(tag == LV_MEM_TAG_DEFAULT) state.default_mon.alloc_cnt++;
+    else state.default_mon.fallback_cnt++;
+#if LV_MEM_REGION_SIM
+    state.default_mon.sim_cost += (uint64_t)state.default_sim_latency * lv_tlsf_block_size(p);
+#endif
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    return p;
+}
+
+#if LV_MEM_REGION_SIM
+void lv_mem_region_set_sim_latency(uint32_t id, uint32_t latency)
+{
+    if(id > state.region_cnt) {
+        LV_LOG_WARN("invalid region: %" LV_PRIu32, id);
+        return;
+    }
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    if(id == 0) state.default_sim_latency = latency;
+    else state.regions[id - 1].sim_latency = latency;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_region_sim_access(const void * p, size_t bytes)
+{
+    /*Memory outside of the regions is accounted to the default heap*/
+    lv_mem_region_t * region = region_find(p);
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    if(region) region->mon.sim_cost += (uint64_t)region->sim_latency * bytes;
+    else state.default_mon.sim_cost += (uint64_t)state.default_sim_latency * bytes;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+#endif /*LV_MEM_REGION_SIM*/
+
+#endif /*LV_MEM_REGION_CNT*/
+
 void * lv_realloc_core(void * p, size_t new_size)
 {
+#if LV_MEM_REGION_CNT
+    lv_mem_region_t * region = region_find(p);
+    if(region) return region_realloc(region, p, new_size);
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
+#if USE_THREAD_CACHE
+    state.thread_cache_mon.lock_cnt++;
+#endif
 
     size_t old_size = lv_tlsf_block_size(p);
     void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
@@ -177,9 +459,24 @@ void * lv_realloc_core(void * p, size_t new_size)
 
 void lv_free_core(void * p)
 {
+#if LV_MEM_REGION_CNT
+    lv_mem_region_t * region = region_find(p);
+    if(region) {
+        region_free(region, p);
+        return;
+    }
+#endif
+
+#if USE_THREAD_CACHE
+    if(thread_cache_free(p)) return;
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
+#if USE_THREAD_CACHE
+    state.thread_cache_mon.lock_cnt++;
+#endif
 
 #if LV_MEM_ADD_JUNK
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
@@ -219,6 +516,41 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
     LV_TRACE_MEM("finished");
 }
 
+size_t lv_mem_get_free_biggest(lv_mem_tag_t tag)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    /*The default heap is the last resort of every tag*/
+    size_t biggest = lv_tlsf_free_biggest(state.tlsf);
+
+#if LV_MEM_REGION_CNT
+    if(tag >= LV_MEM_TAG_LAST) tag = LV_MEM_TAG_DEFAULT;
+
+    /*Follow the same chain as `lv_malloc_core_tagged()`*/
+    lv_mem_tag_t cur_tag = tag;
+    uint32_t step;
+    for(step = 0; step < LV_MEM_TAG_LAST && cur_tag != LV_MEM_TAG_DEFAULT; step++) {
+        uint32_t i;
+        for(i = 0; i < state.region_cnt; i++) {
+            if(state.regions[i].mon.tag != cur_tag) continue;
+            biggest = LV_MAX(biggest, lv_tlsf_free_biggest(state.regions[i].tlsf));
+        }
+
+        cur_tag = state.fallback[cur_tag];
+    }
+#else
+    LV_UNUSED(tag);
+#endif
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    return biggest;
+}
+
 lv_result_t lv_mem_test_core(void)
 {
 #if LV_USE_OS
@@ -243,6 +575,19 @@ lv_result_t lv_mem_test_core(void)
         }
     }
 
+#if LV_MEM_REGION_CNT
+    uint32_t i;
+    for(i = 0; i < state.region_cnt; i++) {
+        if(lv_tlsf_check(state.regions[i].tlsf) || lv_tlsf_check_pool(lv_tlsf_get_pool(state.regions[i].tlsf))) {
+            LV_LOG_WARN("region %" LV_PRIu32 " failed", i + 1);
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return LV_RESULT_INVALID;
+        }
+    }
+#endif
+
     LV_TRACE_MEM("passed");
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -250,6 +595,30 @@ lv_result_t lv_mem_test_core(void)
     return LV_RESULT_OK;
 }
 
+#if USE_THREAD_CACHE
+void lv_mem_thread_cache_flush(void)
+{
+    thread_cache_t * tc = thread_cache_get();
+
+    lv_mutex_lock(&state.mutex);
+    state.thread_cache_mon.lock_cnt++;
+    uint32_t i;
+    for(i = 0; i < THREAD_CACHE_CLASS_CNT; i++) thread_cache_flush_class(tc, i, 0);
+    thread_cache_publish(tc);
+    lv_mutex_unlock(&state.mutex);
+}
+
+void lv_mem_thread_cache_monitor(lv_mem_thread_cache_monitor_t * mon_p)
+{
+    thread_cache_t * tc = thread_cache_get();
+
+    lv_mutex_lock(&state.mutex);
+    thread_cache_publish(tc);
+    *mon_p = state.thread_cache_mon;
+    lv_mutex_unlock(&state.mutex);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -270,4 +639,203 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+#if USE_THREAD_CACHE
+/**
+ * Get the cache of the calling thread. Drop its content if it belongs to an old heap.
+ * @return      the cache of the calling thread
+ */
+static thread_cache_t * thread_cache_get(void)
+{
+    thread_cache_t * tc = &thread_cache;
+    if(tc->heap_id != heap_id) {
+        lv_memzero(tc, sizeof(thread_cache_t));
+        tc->heap_id = heap_id;
+    }
+    return tc;
+}
+
+/**
+ * Take a block from the cache of the calling thread. Refill the cache from the heap if it's empty.
+ * @param size      requested size, at most `THREAD_CACHE_CLASS_CNT * THREAD_CACHE_STEP`
+ * @return          pointer to a block or NULL if the heap has no memory for a new batch
+ */
+static void * thread_cache_alloc(size_t size)
+{
+    thread_cache_t * tc = thread_cache_get();
+    uint32_t class_id = (size - 1) / THREAD_CACHE_STEP;
+    tc->mon.alloc_cnt++;
+
+    void * p = tc->head[class_id];
+    if(p) {
+        tc->head[class_id] = *((void **)p);
+        tc->cnt[class_id]--;
+        tc->mon.hit_cnt++;
+        return p;
+    }
+
+    /*Allocate a whole batch with one lock*/
+    lv_mutex_lock(&state.mutex);
+    state.thread_cache_mon.lock_cnt++;
+    tc->mon.refill_cnt++;
+    thread_cache_publish(tc);
+
+    size_t block_size = (class_id + 1) * THREAD_CACHE_STEP;
+    uint32_t i;
+    for(i = 0; i < THREAD_CACHE_BATCH; i++) {
+        void * new_p = lv_tlsf_malloc(state.tlsf, block_size);
+        if(new_p == NULL) break;
+        state.cur_used += lv_tlsf_block_size(new_p);
+
+        if(p == NULL) {
+            p = new_p;
+        }
+        else {
+            *((void **)new_p) = tc->head[class_id];
+            tc->head[class_id] = new_p;
+            tc->cnt[class_id]++;
+        }
+    }
+    state.max_used = LV_MAX(state.cur_used, state.max_used);
+    lv_mutex_unlock(&state.mutex);
+
+    return p;
+}
+
+/**
+ * Put a freed block to the cache of the calling thread. Flush half of the class if it's full.
+ * @param p     pointer to the freed block
+ * @return      true: the block was cached; false: it should be freed by TLSF
+ */
+static bool thread_cache_free(void * p)
+{
+    /*The size of a block in use is not modified by the other threads*/
+    size_t block_size = lv_tlsf_block_size(p);
+    if(block_size < THREAD_CACHE_STEP || block_size > THREAD_CACHE_CLASS_CNT * THREAD_CACHE_STEP) return false;
+
+    thread_cache_t * tc = thread_cache_get();
+
+    /*Round down so that every block in a class is large enough for the class*/
+    uint32_t class_id = block_size / THREAD_CACHE_STEP - 1;
+    if(tc->cnt[class_id] >= THREAD_CACHE_LIMIT) {
+        lv_mutex_lock(&state.mutex);
+        state.thread_cache_mon.lock_cnt++;
+        tc->mon.flush_cnt++;
+        thread_cache_flush_class(tc, class_id, THREAD_CACHE_LIMIT - THREAD_CACHE_BATCH);
+        thread_cache_publish(tc);
+        lv_mutex_unlock(&state.mutex);
+    }
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(p, 0xbb, block_size);
+#endif
+
+    *((void **)p) = tc->head[class_id];
+    tc->head[class_id] = p;
+    tc->cnt[class_id]++;
+    tc->mon.free_cnt++;
+    return true;
+}
+
+/**
+ * Free the cached blocks of a class to TLSF. The heap lock needs to be taken.
+ * @param tc            pointer to a thread cache
+ * @param class_id      the size class to flush
+ * @param keep_cnt      number of blocks to keep in the cache
+ */
+static void thread_cache_flush_class(thread_cache_t * tc, uint32_t class_id, uint32_t keep_cnt)
+{
+    while(tc->cnt[class_id] > keep_cnt) {
+        void * p = tc->head[class_id];
+        tc->head[class_id] = *((void **)p);
+        tc->cnt[class_id]--;
+
+        size_t size = lv_tlsf_block_size(p);
+        lv_tlsf_free(state.tlsf, p);
+        if(state.cur_used > size) state.cur_used -= size;
+        else state.cur_used = 0;
+    }
+}
+
+/**
+ * Add the local counters of a thread cache to the global ones. The heap lock needs to be taken.
+ * @param tc    pointer to a thread cache
+ */
+static void thread_cache_publish(thread_cache_t * tc)
+{
+    state.thread_cache_mon.alloc_cnt += tc->mon.alloc_cnt;
+    state.thread_cache_mon.hit_cnt += tc->mon.hit_cnt;
+    state.thread_cache_mon.free_cnt += tc->mon.free_cnt;
+    state.thread_cache_mon.refill_cnt += tc->mon.refill_cnt;
+    state.thread_cache_mon.flush_cnt += tc->mon.flush_cnt;
+    lv_memzero(&tc->mon, sizeof(lv_mem_thread_cache_monitor_t));
+}
+#endif
+
+#if LV_MEM_REGION_CNT
+/**
+ * Find the region of a memory block
+ * @param p     pointer to a memory block
+ * @return      the region or NULL if the block is in the default heap
+ */
+static lv_mem_region_t * region_find(const void * p)
+{
+    /*Regions are never removed while LVGL is running so no lock is needed*/
+    uint32_t i;
+    for(i = 0; i < state.region_cnt; i++) {
+        lv_mem_region_t * region = &state.regions[i];
+        if((const uint8_t *)p >= region->start && (const uint8_t *)p < region->end) return region;
+    }
+
+    return NULL;
+}
+
+static void region_free(lv_mem_region_t * region, void * p)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    size_t size = lv_tlsf_block_size(p);
+#if LV_MEM_ADD_JUNK
+    lv_memset(p, 0xbb, size);
+#endif
+    lv_tlsf_free(region->tlsf, p);
+    if(region->mon.cur_used > size) region->mon.cur_used -= size;
+    else region->mon.cur_used = 0;
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+static void * region_realloc(lv_mem_region_t * region, void * p, size_t new_size)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    size_t old_size = lv_tlsf_block_size(p);
+    void * p_new = lv_tlsf_realloc(region->tlsf, p, new_size);
+    if(p_new) {
+        region->mon.cur_used -= old_size;
+        region->mon.cur_used += lv_tlsf_block_size(p_new);
+        region->mon.max_used = LV_MAX(region->mon.cur_used, region->mon.max_used);
+    }
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    if(p_new || new_size == 0) return p_new;
+
+    /*Doesn't fit into the region anymore, move it to the next place allowed for its tag*/
+    p_new = lv_malloc_core_tagged(new_size, region->mon.tag);
+    if(p_new == NULL) return NULL;
+
+    lv_memcpy(p_new, p, LV_MIN(old_size, new_size));
+    region_free(region, p);
+    return p_new;
+}
+#endif /*LV_MEM_REGION_CNT*/
+
 #endif /*LV_STDLIB_BUILTIN*/
@@ -916,6 +916,23 @@ size_t lv_tlsf_block_size(void * ptr)
     return size;
 }
 
+size_t lv_tlsf_free_biggest(lv_tlsf_t tlsf)
+{
+    control_t * control = tlsf_cast(control_t *, tlsf);
+    size_t biggest = 0;
+    if(control->fl_bitmap) {
+        /* Only the highest non-empty list can hold the largest block. */
+        const int fl = tlsf_fls(control->fl_bitmap);
+        const int sl = tlsf_fls(control->sl_bitmap[fl]);
+        const block_header_t * block = control->blocks[fl][sl];
+        while(block != &control->block_null) {
+            biggest = tlsf_max(biggest, block_size(block));
+            block = block->next_free;
+        }
+    }
+    return biggest;
+}
+
 int lv_tlsf_check_pool(lv_pool_t pool)
 {
     /* Check that the blocks are physically correct. */
@@ -73,6 +73,9 @@ size_t lv_tlsf_free(lv_tlsf_t tlsf, const void * ptr);
 /* Returns internal block size, not original request size */
 size_t lv_tlsf_block_size(void * ptr);
 
+/* Returns the size of the largest free block without walking the pools */
+size_t lv_tlsf_free_biggest(lv_tlsf_t tlsf);
+
 /* Overheads/limits of internal structures. */
 size_t lv_tlsf_size(void);
 size_t lv_tlsf_align_size(void);
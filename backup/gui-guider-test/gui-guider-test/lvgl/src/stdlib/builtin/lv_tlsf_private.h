@@ -17,6 +17,7 @@ extern "C" {
  *********************/
 
 #include "lv_tlsf.h"
+#include "../lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -26,6 +27,18 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_MEM_REGION_CNT
+typedef struct {
+    lv_tlsf_t tlsf;
+    uint8_t * start;
+    uint8_t * end;
+    lv_mem_region_monitor_t mon;
+#if LV_MEM_REGION_SIM
+    uint32_t sim_latency;
+#endif
+} lv_mem_region_t;
+#endif
+
 typedef struct {
 #if LV_USE_OS
     lv_mutex_t mutex;
@@ -34,6 +47,18 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_MEM_THREAD_CACHE && LV_USE_OS
+    lv_mem_thread_cache_monitor_t thread_cache_mon;
+#endif
+#if LV_MEM_REGION_CNT
+    lv_mem_region_t regions[LV_MEM_REGION_CNT];
+    uint32_t region_cnt;
+    lv_mem_region_monitor_t default_mon;    /**< Tagged allocations placed in the default heap*/
+#if LV_MEM_REGION_SIM
+    uint32_t default_sim_latency;
+#endif
+    lv_mem_tag_t fallback[LV_MEM_TAG_LAST];
+#endif
 } lv_tlsf_state_t;
 
 /**********************
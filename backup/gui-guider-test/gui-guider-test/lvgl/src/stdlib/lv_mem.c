@@ -25,6 +25,8 @@
 
 #define zero_mem LV_GLOBAL_DEFAULT()->memory_zero
 
+#define USE_REGIONS (LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_REGION_CNT)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -61,13 +63,23 @@ lv_result_t lv_mem_test_core(void);
 
 void * lv_malloc(size_t size)
 {
-    LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
+    return lv_malloc_tagged(size, LV_MEM_TAG_DEFAULT);
+}
+
+void * lv_malloc_tagged(size_t size, lv_mem_tag_t tag)
+{
+    LV_TRACE_MEM("allocating %lu bytes with tag %d", (unsigned long)size, (int)tag);
     if(size == 0) {
         LV_TRACE_MEM("using zero_mem");
         return &zero_mem;
     }
 
+#if USE_REGIONS
+    void * alloc = lv_malloc_core_tagged(size, tag);
+#else
+    LV_UNUSED(tag);
     void * alloc = lv_malloc_core(size);
+#endif
 
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
@@ -91,28 +103,15 @@ void * lv_malloc(size_t size)
 
 void * lv_malloc_zeroed(size_t size)
 {
-    LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
-    if(size == 0) {
-        LV_TRACE_MEM("using zero_mem");
-        return &zero_mem;
-    }
+    return lv_malloc_zeroed_tagged(size, LV_MEM_TAG_DEFAULT);
+}
 
-    void * alloc = lv_malloc_core(size);
-    if(alloc == NULL) {
-        LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
-#if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
-        lv_mem_monitor_t mon;
-        lv_mem_monitor(&mon);
-        LV_LOG_INFO("used: %zu (%3d %%), frag: %3d %%, biggest free: %zu",
-                    mon.total_size - mon.free_size, mon.used_pct, mon.frag_pct,
-                    mon.free_biggest_size);
-#endif
-        return NULL;
-    }
+void * lv_malloc_zeroed_tagged(size_t size, lv_mem_tag_t tag)
+{
+    void * alloc = lv_malloc_tagged(size, tag);
+    if(alloc == NULL || alloc == &zero_mem) return alloc;
 
     lv_memzero(alloc, size);
-
-    LV_TRACE_MEM("allocated at %p", alloc);
     return alloc;
 }
 
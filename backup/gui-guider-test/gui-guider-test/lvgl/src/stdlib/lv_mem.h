@@ -43,6 +43,44 @@ typedef struct {
     uint8_t frag_pct;   /**< Amount of fragmentation */
 } lv_mem_monitor_t;
 
+/**
+ * Describe how the data is used to place it in a suitable memory region
+ */
+typedef enum {
+    LV_MEM_TAG_DEFAULT,     /**< No special requirement, use the LV_MEM_SIZE heap*/
+    LV_MEM_TAG_RENDER,      /**< Hot render data touched in every frame, e.g. layers and draw buffers*/
+    LV_MEM_TAG_CACHE,       /**< Bulk cached data, e.g. decoded images and glyphs*/
+    LV_MEM_TAG_OBJ,         /**< Widgets and their attributes*/
+    LV_MEM_TAG_LAST,
+} lv_mem_tag_t;
+
+/**
+ * Statistics of a tagged memory region
+ */
+typedef struct {
+    lv_mem_tag_t tag;
+    size_t total_size;
+    size_t cur_used;
+    size_t max_used;
+    uint32_t alloc_cnt;     /**< Tagged allocations placed in the region*/
+    uint32_t fallback_cnt;  /**< Allocations of other tags placed here because their regions were full*/
+    uint32_t fail_cnt;      /**< Allocations of the region's tag which didn't fit here*/
+    uint64_t sim_cost;      /**< Accessed KiB multiplied by the simulated latency, see `LV_MEM_REGION_SIM`*/
+} lv_mem_region_monitor_t;
+
+/**
+ * Statistics of the per thread caches in front of the builtin heap.
+ * The counters of a thread are published when it takes the heap lock.
+ */
+typedef struct {
+    uint32_t alloc_cnt;     /**< Allocations small enough for the thread caches*/
+    uint32_t hit_cnt;       /**< Allocations served from a thread cache without locking*/
+    uint32_t free_cnt;      /**< Frees kept in a thread cache without locking*/
+    uint32_t lock_cnt;      /**< Number of times the heap lock was taken*/
+    uint32_t refill_cnt;    /**< Batches of blocks moved from the heap to a thread cache*/
+    uint32_t flush_cnt;     /**< Batches of blocks moved from a thread cache to the heap*/
+} lv_mem_thread_cache_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -61,6 +99,81 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_THREAD_CACHE && LV_USE_OS
+/**
+ * Give the blocks cached by the calling thread back to the heap.
+ * Should be called before a thread using `lv_malloc` exits.
+ */
+void lv_mem_thread_cache_flush(void);
+
+/**
+ * Get the statistics of the thread caches
+ * @param mon_p     pointer to a `lv_mem_thread_cache_monitor_t` to fill
+ */
+void lv_mem_thread_cache_monitor(lv_mem_thread_cache_monitor_t * mon_p);
+#endif
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_REGION_CNT
+/**
+ * Add a memory area as a separate heap for the data of a given tag.
+ * Use `lv_mem_add_pool()` to extend the default heap instead.
+ * @param mem       start address of the memory
+ * @param bytes     size of the memory
+ * @param tag       the data with this tag will be allocated here first
+ * @return          ID of the region (the default heap is 0) or -1 on failure
+ */
+int32_t lv_mem_add_region(void * mem, size_t bytes, lv_mem_tag_t tag);
+
+/**
+ * Set where to allocate the data of a tag if its regions are full.
+ * By default every tag falls back to `LV_MEM_TAG_DEFAULT`, i.e. to the LV_MEM_SIZE heap.
+ * @param tag       the tag whose placement should be changed
+ * @param fallback  try the regions of this tag next. The default heap is always tried last.
+ */
+void lv_mem_set_fallback(lv_mem_tag_t tag, lv_mem_tag_t fallback);
+
+/**
+ * Get the number of regions including the default heap
+ * @return          number of regions
+ */
+uint32_t lv_mem_get_region_count(void);
+
+/**
+ * Get the statistics of a region. The counters of the default heap cover only the tagged allocations.
+ * @param id        ID of the region. 0: the default heap
+ * @param mon_p     pointer to a `lv_mem_region_monitor_t` to fill
+ */
+void lv_mem_region_monitor(uint32_t id, lv_mem_region_monitor_t * mon_p);
+
+#if LV_MEM_REGION_SIM
+/**
+ * Set the simulated latency of a region
+ * @param id        ID of the region. 0: the default heap
+ * @param latency   cost of accessing 1 KiB, in any unit (e.g. ns)
+ */
+void lv_mem_region_set_sim_latency(uint32_t id, uint32_t latency);
+
+/**
+ * Account an access to the memory in the simulated cost of its region.
+ * Allocations are accounted automatically as one write of the whole block.
+ * @param p         pointer to the accessed memory
+ * @param bytes     number of accessed bytes
+ */
+void lv_mem_region_sim_access(const void * p, size_t bytes);
+#endif
+#endif
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+/**
+ * Get the largest free block where the data of a tag can be placed,
+ * i.e. in the regions of the tag, of its fallbacks and in the default heap.
+ * Unlike `lv_mem_monitor()` it doesn't walk the heap.
+ * @param tag       describes how the data is used
+ * @return          size of the largest free block in bytes
+ */
+size_t lv_mem_get_free_biggest(lv_mem_tag_t tag);
+#endif
+
 /**
  * Allocate memory dynamically
  * @param size requested size in bytes
@@ -68,6 +181,24 @@ void lv_mem_remove_pool(lv_mem_pool_t pool);
  */
 void * lv_malloc(size_t size);
 
+/**
+ * Allocate memory in the region selected for a tag.
+ * Same as `lv_malloc()` if `LV_MEM_REGION_CNT` is 0.
+ * @param size      requested size in bytes
+ * @param tag       describes how the data is used
+ * @return          pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_tagged(size_t size, lv_mem_tag_t tag);
+
+/**
+ * Allocate zeroed memory in the region selected for a tag.
+ * Same as `lv_malloc_zeroed()` if `LV_MEM_REGION_CNT` is 0.
+ * @param size      requested size in bytes
+ * @param tag       describes how the data is used
+ * @return          pointer to allocated zeroed memory, or NULL on failure
+ */
+void * lv_malloc_zeroed_tagged(size_t size, lv_mem_tag_t tag);
+
 /**
  * Allocate zeroed memory dynamically
  * @param size requested size in bytes
@@ -96,6 +227,15 @@ void * lv_realloc(void * data_p, size_t new_size);
  */
 void * lv_malloc_core(size_t size);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_REGION_CNT
+/**
+ * Used internally to allocate from the regions by the placement of a tag
+ * @param size      size in bytes to allocate
+ * @param tag       tag of the data
+ */
+void * lv_malloc_core_tagged(size_t size, lv_mem_tag_t tag);
+#endif
+
 /**
  * Used internally to execute a plain `free` operation
  * @param p      memory address to free
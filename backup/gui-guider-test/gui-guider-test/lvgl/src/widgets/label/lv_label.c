@@ -48,6 +48,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
+static void refr_text_keep_layout(lv_obj_t * obj);
 static void lv_label_revert_dots(lv_obj_t * label);
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
@@ -58,6 +59,14 @@ static void set_ofs_y_anim(void * obj, int32_t v);
 static size_t get_text_length(const char * text);
 static void copy_text_to_label(lv_label_t * label, const char * text);
 static lv_text_flag_t get_label_flags(lv_label_t * label);
+static void get_text_size(lv_label_t * label, lv_point_t * size_res, const lv_font_t * font, int32_t letter_space,
+                          int32_t line_space, int32_t max_w, lv_text_flag_t flag, bool update_layout);
+#if LV_LABEL_LAYOUT_CACHE
+static const lv_draw_label_layout_t * get_layout(lv_label_t * label, const lv_font_t * font, int32_t letter_space,
+                                                 int32_t max_w, lv_text_flag_t flag);
+static uint32_t get_layout_line_on_y(const lv_draw_label_layout_t * layout, int32_t y, int32_t letter_height,
+                                     int32_t line_space);
+#endif
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt,
                                    uint32_t length, const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords);
 
@@ -149,6 +158,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->text = lv_realloc(label->text, text_len);
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
+#if LV_LABEL_LAYOUT_CACHE
+        label->text_size = text_len;
+#endif
 
 #if LV_USE_ARABIC_PERSIAN_CHARS
         lv_text_ap_proc(label->text, label->text);
@@ -165,6 +177,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->text = lv_malloc(text_len);
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
+#if LV_LABEL_LAYOUT_CACHE
+        label->text_size = text_len;
+#endif
 
         copy_text_to_label(label, text);
 
@@ -199,6 +214,9 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     label->text = lv_text_set_text_vfmt(fmt, args);
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
+#if LV_LABEL_LAYOUT_CACHE
+    label->text_size = label->text ? lv_strlen(label->text) + 1 : 0;
+#endif
 
     lv_label_refr_text(obj);
 }
@@ -211,11 +229,17 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
     if(label->static_txt == 0 && label->text != NULL) {
         lv_free(label->text);
         label->text = NULL;
+#if LV_LABEL_LAYOUT_CACHE
+        label->text_size = 0;
+#endif
     }
 
     if(text != NULL) {
         label->static_txt = 1;
         label->text       = (char *)text;
+#if LV_LABEL_LAYOUT_CACHE
+        label->text_size  = 0;
+#endif
     }
 
     lv_label_refr_text(obj);
@@ -243,7 +267,7 @@ void lv_label_set_long_mode(lv_obj_t * obj, lv_label_long_mode_t long_mode)
     }
 
     label->long_mode = long_mode;
-    lv_label_refr_text(obj);
+    refr_text_keep_layout(obj);     /*The lines are recalculated if the flags changed*/
 }
 
 void lv_label_set_text_selection_start(lv_obj_t * obj, uint32_t index)
@@ -337,16 +361,29 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
     int32_t y = 0;
     uint32_t line_start = 0;
     uint32_t new_line_start = 0;
-    while(txt[new_line_start] != '\0') {
-        bool last_line = y + letter_height + line_space + letter_height > max_h;
-        if(last_line && label->long_mode == LV_LABEL_LONG_DOT) flag |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+#if LV_LABEL_LAYOUT_CACHE
+    const lv_draw_label_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    if(layout) {
+        uint32_t line_idx = lv_draw_label_layout_get_line_index(layout, byte_id);
+        line_start = layout->lines[line_idx].start;
+        new_line_start = layout->lines[line_idx + 1].start;
+        y = (int32_t)line_idx * (letter_height + line_space);
+    }
+    else
+#endif
+    {
+        while(txt[new_line_start] != '\0') {
+            bool last_line = y + letter_height + line_space + letter_height > max_h;
+            if(last_line && label->long_mode == LV_LABEL_LONG_DOT) flag |= LV_TEXT_FLAG_BREAK_ALL;
+
+            new_line_start += lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -426,26 +463,43 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in, bool
     lv_text_flag_t flag = get_label_flags(label);
 
     /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        /*If dots will be shown, break the last visible line anywhere,
-         *not only at word boundaries.*/
-        bool last_line = y + letter_height + line_space + letter_height > max_h;
-        if(last_line && label->long_mode == LV_LABEL_LONG_DOT) flag |= LV_TEXT_FLAG_BREAK_ALL;
-
-        new_line_start += lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
-
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
+#if LV_LABEL_LAYOUT_CACHE
+    const lv_draw_label_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    if(layout) {
+        uint32_t line_idx = get_layout_line_on_y(layout, pos.y, letter_height, line_space);
+        line_start = layout->lines[line_idx].start;
+        new_line_start = line_idx < layout->line_cnt ? layout->lines[line_idx + 1].start : line_start;
+        if(line_idx < layout->line_cnt) {
             /*Include the NULL terminator in the last line*/
             uint32_t tmp = new_line_start;
-            uint32_t letter;
-            letter = lv_text_encoded_prev(txt, &tmp);
+            uint32_t letter = lv_text_encoded_prev(txt, &tmp);
             if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
         }
-        y += letter_height + line_space;
+    }
+    else
+#endif
+    {
+        while(txt[line_start] != '\0') {
+            /*If dots will be shown, break the last visible line anywhere,
+             *not only at word boundaries.*/
+            bool last_line = y + letter_height + line_space + letter_height > max_h;
+            if(last_line && label->long_mode == LV_LABEL_LONG_DOT) flag |= LV_TEXT_FLAG_BREAK_ALL;
+
+            new_line_start += lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /*Include the NULL terminator in the last line*/
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = lv_text_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+                break;
+            }
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     char * bidi_txt;
@@ -541,16 +595,27 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
 
     /*Search the line of the index letter*/
     int32_t y = 0;
-    while(txt[line_start] != '\0') {
-        bool last_line = y + letter_height + line_space + letter_height > max_h;
-        if(last_line && label->long_mode == LV_LABEL_LONG_DOT) flag |= LV_TEXT_FLAG_BREAK_ALL;
+#if LV_LABEL_LAYOUT_CACHE
+    const lv_draw_label_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    if(layout) {
+        uint32_t line_idx = get_layout_line_on_y(layout, pos->y, letter_height, line_space);
+        line_start = layout->lines[line_idx].start;
+        new_line_start = line_idx < layout->line_cnt ? layout->lines[line_idx + 1].start : line_start;
+    }
+    else
+#endif
+    {
+        while(txt[line_start] != '\0') {
+            bool last_line = y + letter_height + line_space + letter_height > max_h;
+            if(last_line && label->long_mode == LV_LABEL_LONG_DOT) flag |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+            new_line_start += lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -639,16 +704,36 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     size_t old_len = lv_strlen(label->text);
     size_t ins_len = lv_strlen(txt);
     size_t new_len = ins_len + old_len;
+#if LV_LABEL_LAYOUT_CACHE
+    if(new_len + 1 > label->text_size) {
+        /*Reserve some extra space to not reallocate the whole text on every insertion*/
+        size_t new_size = LV_MAX(new_len + 1, label->text_size + label->text_size / 2);
+        label->text = lv_realloc(label->text, new_size);
+        LV_ASSERT_MALLOC(label->text);
+        if(label->text == NULL) return;
+        label->text_size = new_size;
+    }
+#else
     label->text        = lv_realloc(label->text, new_len + 1);
     LV_ASSERT_MALLOC(label->text);
     if(label->text == NULL) return;
+#endif
 
     if(pos == LV_LABEL_POS_LAST) {
         pos = lv_text_get_encoded_length(label->text);
     }
 
+#if LV_LABEL_LAYOUT_CACHE && !LV_USE_ARABIC_PERSIAN_CHARS
+    uint32_t byte_pos = lv_text_encoded_get_byte_id(label->text, pos);
+    lv_text_ins(label->text, pos, txt);
+
+    /*Recalculate only the lines around the new text*/
+    lv_draw_label_layout_update_range(&label->layout, label->text, byte_pos, 0, ins_len);
+    refr_text_keep_layout(obj);
+#else
     lv_text_ins(label->text, pos, txt);
     lv_label_set_text(obj, NULL);
+#endif
 }
 
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
@@ -662,11 +747,23 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     lv_obj_invalidate(obj);
 
     char * label_txt = lv_label_get_text(obj);
+#if LV_LABEL_LAYOUT_CACHE && !LV_USE_ARABIC_PERSIAN_CHARS
+    uint32_t byte_pos = lv_text_encoded_get_byte_id(label_txt, pos);
+    uint32_t del_len = lv_text_encoded_get_byte_id(&label_txt[byte_pos], cnt);
+
+    /*Delete the characters*/
+    lv_text_cut(label_txt, pos, cnt);
+
+    /*Recalculate only the lines around the removed characters*/
+    lv_draw_label_layout_update_range(&label->layout, label_txt, byte_pos, del_len, 0);
+    refr_text_keep_layout(obj);
+#else
     /*Delete the characters*/
     lv_text_cut(label_txt, pos, cnt);
 
     /*Refresh the label*/
     lv_label_refr_text(obj);
+#endif
 }
 
 /**********************
@@ -681,6 +778,9 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     label->text       = NULL;
+#if LV_LABEL_LAYOUT_CACHE
+    label->text_size  = 0;
+#endif
     label->static_txt = 0;
     label->dot_end    = LV_LABEL_DOT_END_INV;
     label->long_mode  = LV_LABEL_LONG_WRAP;
@@ -692,6 +792,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_memzero(&label->layout, sizeof(label->layout));
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -714,6 +818,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_free(&label->layout);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -730,7 +838,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
     if((code == LV_EVENT_STYLE_CHANGED) || (code == LV_EVENT_SIZE_CHANGED)) {
         /*Revert dots for proper refresh*/
         lv_label_revert_dots(obj);
-        lv_label_refr_text(obj);
+        refr_text_keep_layout(obj);     /*The lines are recalculated if the font or the width changed*/
     }
     else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
         /* Italic or other non-typical letters can be drawn of out of the object.
@@ -756,7 +864,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
 
             w = LV_MIN(w, lv_obj_get_style_max_width(obj, 0));
 
-            lv_text_get_size(&label->size_cache, label->text, font, letter_space, line_space, w, flag);
+            get_text_size(label, &label->size_cache, font, letter_space, line_space, w, flag, false);
             label->invalid_size_cache = false;
         }
 
@@ -790,6 +898,9 @@ static void draw_main(lv_event_t * e)
         label_draw_dsc.hint = &label->hint;
     }
 #endif
+#if LV_LABEL_LAYOUT_CACHE
+    label_draw_dsc.layout = &label->layout;
+#endif
 
     label_draw_dsc.flag = flag;
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
@@ -807,8 +918,8 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_text_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                         LV_COORD_MAX, flag);
+        get_text_size(label, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                      LV_COORD_MAX, flag, false);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -840,8 +951,8 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_text_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                         LV_COORD_MAX, flag);
+        get_text_size(label, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                      LV_COORD_MAX, flag, false);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -894,6 +1005,20 @@ static void overwrite_anim_property(lv_anim_t * dest, const lv_anim_t * src, lv_
  * @param label pointer to a label object
  */
 static void lv_label_refr_text(lv_obj_t * obj)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    label->layout.valid = 0; /*The characters might have been changed in place*/
+#endif
+    refr_text_keep_layout(obj);
+}
+
+/**
+ * Refresh the label without invalidating the stored lines.
+ * Used when the characters didn't change or the lines were updated with the modified text already.
+ * @param label pointer to a label object
+ */
+static void refr_text_keep_layout(lv_obj_t * obj)
 {
     lv_label_t * label = (lv_label_t *)obj;
     if(label->text == NULL) return;
@@ -913,7 +1038,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_point_t size;
     lv_text_flag_t flag = get_label_flags(label);
 
-    lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    get_text_size(label, &size, font, letter_space, line_space, max_w, flag, true);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1164,6 +1289,11 @@ static void lv_label_refr_text(lv_obj_t * obj)
                     label->text[byte_id_ori + i] = '.';
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
+#if LV_LABEL_LAYOUT_CACHE
+                /*Store the lines of the text with the dots as that's what will be drawn*/
+                label->layout.valid = 0;
+                lv_draw_label_layout_update(&label->layout, label->text, font, letter_space, max_w, flag);
+#endif
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
             }
         }
@@ -1195,6 +1325,9 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     label->text[byte_i + i] = dot_tmp[i];
 
     lv_label_dot_tmp_free(obj);
+#if LV_LABEL_LAYOUT_CACHE
+    label->layout.valid = 0;
+#endif
 
     label->dot_end = LV_LABEL_DOT_END_INV;
 }
@@ -1314,6 +1447,68 @@ static lv_text_flag_t get_label_flags(lv_label_t * label)
 }
 
 /* Function created because of this pattern be used in multiple functions */
+/**
+ * Get the size of the label's text. Use the stored layout if it's still valid.
+ * @param update_layout     true: recalculate the layout if it's invalid for these parameters
+ */
+static void get_text_size(lv_label_t * label, lv_point_t * size_res, const lv_font_t * font, int32_t letter_space,
+                          int32_t line_space, int32_t max_w, lv_text_flag_t flag, bool update_layout)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    bool valid;
+    if(update_layout) {
+        /*Static texts can be modified in place, so compare their characters too*/
+        if(label->layout.check_text != label->static_txt) {
+            label->layout.check_text = label->static_txt;
+            label->layout.valid = 0;
+        }
+        valid = lv_draw_label_layout_update(&label->layout, label->text, font, letter_space, max_w, flag);
+    }
+    else valid = lv_draw_label_layout_is_valid(&label->layout, label->text, font, letter_space, max_w, flag);
+
+    if(valid) {
+        lv_draw_label_layout_get_size(&label->layout, line_space, size_res);
+        return;
+    }
+#else
+    LV_UNUSED(update_layout);
+#endif
+
+    lv_text_get_size(size_res, label->text, font, letter_space, line_space, max_w, flag);
+}
+
+#if LV_LABEL_LAYOUT_CACHE
+/**
+ * Get the stored layout if it can be used to find the lines of the label
+ * @return      pointer to the layout or NULL if the lines need to be calculated
+ */
+static const lv_draw_label_layout_t * get_layout(lv_label_t * label, const lv_font_t * font, int32_t letter_space,
+                                                 int32_t max_w, lv_text_flag_t flag)
+{
+    /*The last visible line is broken differently in dot mode*/
+    if(label->long_mode == LV_LABEL_LONG_DOT) return NULL;
+    if(!lv_draw_label_layout_is_valid(&label->layout, label->text, font, letter_space, max_w, flag)) return NULL;
+    if(label->layout.line_cnt == 0) return NULL;
+
+    return &label->layout;
+}
+
+/**
+ * Get the first line whose bottom is at or below `y`
+ * @return      index of the line or `line_cnt` if `y` is below the last line
+ */
+static uint32_t get_layout_line_on_y(const lv_draw_label_layout_t * layout, int32_t y, int32_t letter_height,
+                                     int32_t line_space)
+{
+    int32_t line_h = letter_height + line_space;
+    if(y <= letter_height) return 0;
+    if(line_h <= 0) return layout->line_cnt;
+
+    uint32_t line_idx = (y - letter_height + line_h - 1) / line_h;
+    return LV_MIN(line_idx, layout->line_cnt);
+}
+#endif
+
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt, uint32_t length,
                                    const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords)
 {
@@ -41,6 +41,11 @@ struct lv_label_t {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_t layout;
+    uint32_t text_size; /**< Size of the buffer allocated for the text. 0 for static texts. */
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
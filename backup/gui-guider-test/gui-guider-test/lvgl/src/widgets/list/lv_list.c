@@ -35,6 +35,9 @@ const lv_obj_class_t lv_list_class = {
     .width_def = (LV_DPI_DEF * 3) / 2,
     .height_def = LV_DPI_DEF * 2,
     .name = "list",
+#if LV_USE_SCROLL_BLIT
+    .scroll_blit = 1,
+#endif
 };
 
 const lv_obj_class_t lv_list_button_class = {
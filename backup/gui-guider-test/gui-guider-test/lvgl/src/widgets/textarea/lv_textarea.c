@@ -330,6 +330,10 @@ void lv_textarea_delete_char(lv_obj_t * obj)
     lv_result_t res = insert_handler(obj, del_buf);
     if(res != LV_RESULT_OK) return;
 
+#if LV_LABEL_LAYOUT_CACHE && !LV_USE_ARABIC_PERSIAN_CHARS
+    /*Delete a character and update only the lines around it*/
+    lv_label_cut_text(ta->label, ta->cursor.pos - 1, 1);
+#else
     char * label_txt = lv_label_get_text(ta->label);
 
     /*Delete a character*/
@@ -337,6 +341,7 @@ void lv_textarea_delete_char(lv_obj_t * obj)
 
     /*Refresh the label*/
     lv_label_set_text(ta->label, label_txt);
+#endif
     lv_textarea_clear_selection(obj);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
@@ -1036,7 +1041,10 @@ static void label_event_cb(lv_event_t * e)
     lv_obj_t * ta = lv_obj_get_parent(label);
 
     if(code == LV_EVENT_STYLE_CHANGED || code == LV_EVENT_SIZE_CHANGED) {
+        /*With the layout cache the label refreshes itself without recalculating the lines of the whole text again*/
+#if !LV_LABEL_LAYOUT_CACHE
         lv_label_set_text(label, NULL);
+#endif
         refr_cursor_area(ta);
         start_cursor_blink(ta);
     }